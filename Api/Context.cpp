@@ -0,0 +1,214 @@
+
+/*
+ * File Context.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file Context.cpp
+ * Implements class Context.
+ */
+
+#include <mutex>
+
+#include "Context.hpp"
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Environment.hpp"
+
+#include "Indexing/TermSharing.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+
+namespace Api
+{
+
+using namespace Lib;
+
+/**
+ * Return the lock that makes the scopes mutually exclusive
+ *
+ * It is recursive, so that scopes can be nested on one thread.
+ */
+static std::recursive_mutex& scopeLock()
+{
+  static std::recursive_mutex lock;
+  return lock;
+}
+
+/** The context of the innermost scope, protected by scopeLock() */
+static Context* currentContext = 0;
+
+/**
+ * The part of the global environment that belongs to a context
+ */
+struct Context::State
+{
+  CLASS_NAME(Context::State);
+  USE_ALLOCATOR(Context::State);
+
+  /** Store the current content of the global environment */
+  void load()
+  {
+    options = env.options;
+    sorts = env.sorts;
+    signature = env.signature;
+    sharing = env.sharing;
+    statistics = env.statistics;
+    property = env.property;
+    clausePriorities = env.clausePriorities;
+    maxClausePriority = env.maxClausePriority;
+    colorUsed = env.colorUsed;
+    interpretedOperationsUsed = env.interpretedOperationsUsed;
+  }
+
+  /** Make the stored content the content of the global environment */
+  void install() const
+  {
+    env.options = options;
+    env.sorts = sorts;
+    env.signature = signature;
+    env.sharing = sharing;
+    env.statistics = statistics;
+    env.property = property;
+    env.clausePriorities = clausePriorities;
+    env.maxClausePriority = maxClausePriority;
+    env.colorUsed = colorUsed;
+    env.interpretedOperationsUsed = interpretedOperationsUsed;
+  }
+
+  Shell::Options* options;
+  Kernel::Sorts* sorts;
+  Kernel::Signature* signature;
+  Indexing::TermSharing* sharing;
+  Shell::Statistics* statistics;
+  Shell::Property* property;
+  DHMap<const Kernel::Unit*,unsigned>* clausePriorities;
+  unsigned maxClausePriority;
+  bool colorUsed;
+  bool interpretedOperationsUsed;
+};
+
+/**
+ * Create a context with a fresh signature and term sharing. The time
+ * and memory limits and the output of axiom names are taken over from
+ * the current options.
+ */
+Context::Context()
+{
+  CALL("Context::Context");
+
+  std::lock_guard<std::recursive_mutex> guard(scopeLock());
+
+  Shell::Options* current = env.options;
+  State saved;
+  saved.load();
+
+  _state = new State();
+  _state->options = new Shell::Options;
+  _state->options->setTimeLimitInDeciseconds(current->timeLimitInDeciseconds());
+  _state->options->setMemoryLimit(current->memoryLimit());
+  _state->options->setOutputAxiomNames(current->outputAxiomNames());
+  _state->statistics = new Shell::Statistics;
+  _state->sorts = new Kernel::Sorts;
+  _state->property = 0;
+  _state->clausePriorities = 0;
+  _state->maxClausePriority = 1;
+  _state->colorUsed = false;
+  _state->interpretedOperationsUsed = false;
+
+  // the signature and term sharing are created with the sorts and
+  // options of the context in place
+  env.options = _state->options;
+  env.sorts = _state->sorts;
+  _state->signature = new Kernel::Signature;
+  _state->sharing = new Indexing::TermSharing;
+
+  saved.install();
+}
+
+Context::~Context()
+{
+  CALL("Context::~Context");
+
+  std::lock_guard<std::recursive_mutex> guard(scopeLock());
+
+  ASS_NEQ(currentContext, this); //the context is not in use
+
+  State saved;
+  saved.load();
+  _state->install();
+
+  delete env.sharing;
+  delete env.signature;
+  delete env.sorts;
+  delete env.statistics;
+  if(env.clausePriorities) delete env.clausePriorities;
+  {
+    BYPASSING_ALLOCATOR; // use of std::function in options
+    delete env.options;
+  }
+  delete _state;
+
+  saved.install();
+}
+
+Context::Scope::Scope(Context& ctx)
+: _ctx(ctx)
+{
+  CALL("Context::Scope::Scope");
+
+  scopeLock().lock();
+
+  _previous = currentContext;
+  if(_previous) {
+    // the enclosing scope may have changed the environment
+    _previous->_state->load();
+  }
+  _saved = new State();
+  _saved->load();
+  _ctx._state->install();
+  currentContext = &_ctx;
+}
+
+Context::Scope::~Scope()
+{
+  CALL("Context::Scope::~Scope");
+
+  ASS_EQ(currentContext, &_ctx);
+
+  // the prover may have replaced some of the objects, e.g. the property
+  _ctx._state->load();
+  if(_previous) {
+    // when nested in a scope of the same context, _saved is out of date
+    _previous->_state->install();
+  }
+  else {
+    _saved->install();
+  }
+  delete _saved;
+  currentContext = _previous;
+
+  scopeLock().unlock();
+}
+
+}
@@ -0,0 +1,83 @@
+
+/*
+ * File Context.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file Context.hpp
+ * Defines class Context.
+ */
+
+#ifndef __API_Context__
+#define __API_Context__
+
+namespace Api {
+
+/**
+ * An independent instance of the state the prover keeps in the global
+ * environment
+ *
+ * Each context has its own options, sorts, signature, term sharing
+ * and statistics, so problems built in different contexts do not share
+ * any symbols or terms. A context is made current by a Context::Scope
+ * object, and the terms, formulas and problems created in a scope may
+ * only be used in scopes of the same context.
+ *
+ * Scopes are mutually exclusive across threads, so a thread that makes
+ * all its Api calls inside a scope of its own context does not need any
+ * further synchronisation. Scopes of different threads do not run in
+ * parallel, as the memory allocator and several caches of the prover
+ * are process-wide. To clausify problems in parallel, use one process
+ * per worker.
+ */
+class Context
+{
+  struct State;
+public:
+  Context();
+  ~Context();
+
+  /**
+   * Makes a context current for the lifetime of the object
+   *
+   * Scopes may be nested on the same thread, also for different contexts.
+   */
+  class Scope
+  {
+  public:
+    explicit Scope(Context& ctx);
+    ~Scope();
+  private:
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+
+    Context& _ctx;
+    /** the context of the enclosing scope, or zero if there is none */
+    Context* _previous;
+    /** the environment before the scope was entered */
+    State* _saved;
+  };
+
+private:
+  Context(const Context&);
+  Context& operator=(const Context&);
+
+  State* _state;
+};
+
+}
+
+#endif // __API_Context__
@@ -283,6 +283,11 @@ void CLTBMode::loadIncludes()
   //ensure we scan the theory axioms for property here, so we don't need to
   //do it afterward in each problem
   _baseProblem->getProperty();
+
+  //the generality of symbols and the D-relation of the theory axioms
+  //are computed here, each slice then only computes the closure
+  _theorySelector = new Shell::SineTheorySelector(*env.options);
+  _theorySelector->initSelectionStructure(theoryAxioms);
   env.statistics->phase=Statistics::UNKNOWN_PHASE;
 } // CLTBMode::loadIncludes
 
@@ -583,7 +588,7 @@ vstring CLTBProblem::problemFinishedString = "##Problem finished##vn;3-d-ca-12=1
 
 CLTBProblem::CLTBProblem(CLTBMode* parent, vstring problemFile, vstring outFile)
   : parent(parent), problemFile(problemFile), outFile(outFile),
-    prb(*parent->_baseProblem), _syncSemaphore(1)
+    prb(*parent->_baseProblem), _problemUnits(0), _syncSemaphore(1)
 {
   //add the privileges into the semaphore
   _syncSemaphore.set(0,1);
@@ -719,6 +724,7 @@ void CLTBProblem::searchForProof(int terminationTime,int timeLimit,const Categor
     parser.parse();
     UnitList* probUnits = parser.units();
     UIHelper::setConjecturePresence(parser.containsConjecture());
+    _problemUnits = UnitList::copy(probUnits);
     prb.addUnits(probUnits);
 
     // Now we iterate over all units in the problem and populate
@@ -1001,22 +1007,24 @@ void CLTBProblem::runSlice(Options& strategyOpt)
   opt.setProblemName(problemFile);
   *env.options = opt; //just temporarily until we get rid of dependencies on env.options in solving
 
-//  if (env.options->sineSelection()!=Options::SS_OFF) {
-//    //add selected axioms from the theory
-//    parent->theorySelector.perform(probUnits);
-//
-//    env.options->setSineSelection(Options::SS_OFF);
-//    env.options->forceIncompleteness();
-//  }
-//  else {
-//    //if there wasn't any sine selection, just put in all theory axioms
-//    probUnits=UnitList::concat(probUnits, parent->theoryAxioms);
-//  }
-
   env.beginOutput();
   CLTBMode::lineOutput() << opt.testId() << " on " << opt.problemName() << endl;
   env.endOutput();
 
+  if (parent->_theorySelector->canPerform(opt)) {
+    //add selected axioms from the theory
+    UnitList* units = UnitList::copy(_problemUnits);
+    parent->_theorySelector->perform(units);
+    UnitList::destroy(prb.units());
+    prb.units() = units;
+    prb.reportIncompleteTransformation();
+    prb.invalidateByRemoval();
+
+    opt.setSineSelection(Options::SineSelection::OFF);
+    env.options->setSineSelection(Options::SineSelection::OFF);
+  }
+  //otherwise the selection (if any) is done on all the units in preprocessing
+
   ProvingHelper::runVampire(prb, opt);
 
   //set return value to zero if we were successful
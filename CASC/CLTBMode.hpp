@@ -110,6 +110,11 @@ private:
   StringPairStack _problemFiles;
 
   ScopedPtr<Problem> _baseProblem;
+  /**
+   * SInE selection structure over the theory axioms, built once for
+   * the batch and used read-only by the slices of all its problems
+   */
+  ScopedPtr<Shell::SineTheorySelector> _theorySelector;
 
   // This contains formulas 'learned' in the sense that they were input
   // formulas used in proofs of previous problems
@@ -164,6 +169,8 @@ private:
    * will be using the problem object.
    */
   Problem& prb;
+  /** units of the problem file, i.e. without the theory axioms */
+  UnitList* _problemUnits;
 
   Semaphore _syncSemaphore; // semaphore for synchronizing writing if the solution
 
@@ -35,6 +35,7 @@
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 #include "Shell/Normalisation.hpp"
+#include "Shell/Preprocess.hpp"
 #include "Shell/TheoryFinder.hpp"
 
 #include <unistd.h>
@@ -50,7 +51,7 @@
 using namespace Lib;
 using namespace CASC;
 
-PortfolioMode::PortfolioMode() : _slowness(1.0), _syncSemaphore(2) {
+PortfolioMode::PortfolioMode() : _slowness(1.0), _preprocessed(false), _preprocessingTime(0), _syncSemaphore(2) {
   // We need the following two values because the way the semaphore class is currently implemented:
   // 1) dec is the only operation which is blocking
   // 2) dec is done in the mode SEM_UNDO, so is undone when a process terminates
@@ -397,6 +398,22 @@ void PortfolioSliceExecutor::runSlice
   }
 }
 
+vstring PortfolioSliceExecutor::getPreprocessingKey(vstring sliceCode)
+{
+  return _mode->getPreprocessingKey(sliceCode);
+}
+
+void PortfolioSliceExecutor::preprocess(vstring sliceCode)
+{
+  _mode->preprocess(sliceCode);
+}
+
+int PortfolioSliceExecutor::getSliceTime(vstring sliceCode)
+{
+  vstring chopped;
+  return _mode->getSliceTime(sliceCode, chopped);
+}
+
 /**
  * Run a schedule.
  * Return true if a proof was found, otherwise return false.
@@ -478,6 +495,15 @@ void PortfolioMode::runSlice(vstring sliceCode, unsigned timeLimitInDeciseconds)
 {
   CALL("PortfolioMode::runSlice");
 
+  if (_preprocessed) {
+    // the slice would have spent this time on its own preprocessing
+    int preprocessingTime = milliToDeci(_preprocessingTime);
+    if ((int)timeLimitInDeciseconds <= preprocessingTime) {
+      System::terminateImmediately(1); // didn't find proof
+    }
+    timeLimitInDeciseconds -= preprocessingTime;
+  }
+
   Options opt = *env.options;
   opt.readFromEncodedOptions(sliceCode);
   opt.setTimeLimitInDeciseconds(timeLimitInDeciseconds);
@@ -488,6 +514,75 @@ void PortfolioMode::runSlice(vstring sliceCode, unsigned timeLimitInDeciseconds)
   runSlice(opt);
 } // runSlice
 
+/**
+ * Assign to @b opt the options with which the slice @b sliceCode
+ * would be run, disregarding its time limit.
+ */
+void PortfolioMode::getSliceOptions(vstring sliceCode, Options& opt)
+{
+  CALL("PortfolioMode::getSliceOptions");
+
+  opt = *env.options;
+  // unknown options are reported by the slice itself
+  opt.setIgnoreMissing(Options::IgnoreMissing::ON);
+  opt.readFromEncodedOptions(sliceCode);
+  //we have already performed the normalization
+  opt.setNormalize(false);
+  opt.setForcedOptionValues();
+}
+
+/**
+ * Return the key under which the slice @b sliceCode can share
+ * the preprocessed problem with other slices. Return the empty
+ * string if the slice should preprocess on its own.
+ */
+vstring PortfolioMode::getPreprocessingKey(vstring sliceCode)
+{
+  CALL("PortfolioMode::getPreprocessingKey");
+
+  try {
+    getSliceOptions(sliceCode, _keyOpt);
+    return _keyOpt.generatePreprocessingKey();
+  }
+  catch(Exception&) {
+    // the slice itself will report the problem
+    return "";
+  }
+}
+
+/**
+ * Preprocess the problem for the slice @b sliceCode.
+ * Called in a process from which all slices with the same
+ * preprocessing key as @b sliceCode are then forked.
+ */
+void PortfolioMode::preprocess(vstring sliceCode)
+{
+  CALL("PortfolioMode::preprocess");
+  ASS(!_preprocessed);
+
+  Options opt;
+  getSliceOptions(sliceCode, opt);
+  opt.checkGlobalOptionConstraints();
+
+  Timer::syncClock();
+  int start = env.timer->elapsedMilliseconds();
+
+  // the slices read their options from env.options, so we restore them afterwards
+  Options baseOpt = *env.options;
+  *env.options = opt;
+  {
+    TimeCounter tc(TC_PREPROCESSING);
+
+    Preprocess prepro(opt);
+    prepro.preprocess(*_prb);
+  }
+  *env.options = baseOpt;
+  _preprocessed = true;
+
+  Timer::syncClock();
+  _preprocessingTime = env.timer->elapsedMilliseconds() - start;
+}
+
 /**
  * Run a slice given by its options
  */
@@ -517,7 +612,12 @@ void PortfolioMode::runSlice(Options& strategyOpt)
     env.endOutput();
   }
 
-  Saturation::ProvingHelper::runVampire(*_prb, opt);
+  if (_preprocessed) {
+    Saturation::ProvingHelper::runVampireSaturation(*_prb, opt);
+  }
+  else {
+    Saturation::ProvingHelper::runVampire(*_prb, opt);
+  }
 
   //set return value to zero if we were successful
   if (env.statistics->terminationReason == Statistics::REFUTATION ||
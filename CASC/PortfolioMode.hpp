@@ -34,6 +34,7 @@
 #include "Lib/VString.hpp"
 #include "Lib/Sys/Semaphore.hpp"
 
+#include "Shell/Options.hpp"
 #include "Shell/Property.hpp"
 #include "Schedules.hpp"
 #include "ScheduleExecutor.hpp"
@@ -60,6 +61,9 @@ class PortfolioSliceExecutor : public SliceExecutor
 public:
   PortfolioSliceExecutor(PortfolioMode *mode);
   void runSlice(vstring sliceCode, int terminationTime) override;
+  vstring getPreprocessingKey(vstring sliceCode) override;
+  void preprocess(vstring sliceCode) override;
+  int getSliceTime(vstring sliceCode) override;
 
 private:
   PortfolioMode *_mode;
@@ -72,8 +76,7 @@ class PortfolioMode {
   };
 
   PortfolioMode();
-  friend void PortfolioSliceExecutor::runSlice
-    (vstring sliceCode, int terminationTime);
+  friend class PortfolioSliceExecutor;
 public:
   static bool perform(float slowness);
   unsigned getSliceTime(vstring sliceCode,vstring& chopped);
@@ -90,6 +93,9 @@ private:
   bool waitForChildAndCheckIfProofFound();
   void runSlice(vstring slice, unsigned timeLimitInDeciseconds) NO_RETURN;
   void runSlice(Options& strategyOpt) NO_RETURN;
+  void getSliceOptions(vstring sliceCode, Options& opt);
+  vstring getPreprocessingKey(vstring sliceCode);
+  void preprocess(vstring sliceCode);
 
 #if VDEBUG
   DHSet<pid_t> childIds;
@@ -104,6 +110,12 @@ private:
    * will be using the problem object.
    */
   ScopedPtr<Problem> _prb;
+  /** true if @b _prb has already been preprocessed for the slices run by this process */
+  bool _preprocessed;
+  /** time (in milliseconds) spent on preprocessing @b _prb, charged to the slices run from it */
+  int _preprocessingTime;
+  /** options reused for computing the preprocessing keys, as creating Options is expensive */
+  Options _keyOpt;
 
   Semaphore _syncSemaphore; // semaphore for synchronizing proof printing
 };
@@ -1,6 +1,11 @@
 #include "ScheduleExecutor.hpp"
 
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+
 #include "Lib/Array.hpp"
+#include "Lib/DArray.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/List.hpp"
 #include "Lib/PriorityQueue.hpp"
@@ -15,21 +20,29 @@ using namespace Lib::Sys;
 
 #define DECI(milli) (milli/100)
 
+/** how long (in milliseconds) to wait for the responses of preprocessing servers at once */
+#define SERVER_POLL_TIME 10
+
 ScheduleExecutor::ScheduleExecutor(ProcessPriorityPolicy *policy, SliceExecutor *executor)
   : _policy(policy), _executor(executor)
 {
   CALL("ScheduleExecutor::ScheduleExecutor");
   _numWorkers = getNumWorkers();
+  _pending = 0;
+  // slices forked by a preprocessing server must become our children
+  // once their intermediate parent dies, so that we can wait for them
+  _sharePreprocessing = env.options->portfolioPreprocessingSharing() &&
+    System::registerAsChildSubreaper();
 }
 
 class Item
 {
 public:
-  Item() : _started(true), _process(-1), _code("") {}
-  Item(vstring code)
-    : _started(false), _process(-1), _code(code) {}
+  Item() : _started(true), _process(-1), _code(""), _key("") {}
+  Item(vstring code, vstring key)
+    : _started(false), _process(-1), _code(code), _key(key) {}
   Item(pid_t process)
-    : _started(true), _process(process), _code("") {}
+    : _started(true), _process(process), _code(""), _key("") {}
 
   bool started() const {return _started;}
   vstring code() const
@@ -37,6 +50,11 @@ public:
     ASS(!started());
     return _code;
   }
+  vstring key() const
+  {
+    ASS(!started());
+    return _key;
+  }
   pid_t process() const
   {
     ASS(started());
@@ -47,6 +65,8 @@ private:
   bool _started;
   pid_t _process;
   vstring _code;
+  /** preprocessing key of the slice, empty if it is not shared */
+  vstring _key;
 };
 
 bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
@@ -60,17 +80,26 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
   while(it.hasNext())
   {
     vstring code = it.next();
+    vstring key = _sharePreprocessing ? _executor->getPreprocessingKey(code) : "";
+    if(!key.empty())
+    {
+      unsigned *unstarted;
+      _unstarted.getValuePtr(key, unstarted, 0);
+      (*unstarted)++;
+    }
     float priority = _policy->staticPriority(code);
-    queue.insert(priority, code);
+    queue.insert(priority, Item(code, key));
   }
 
   typedef List<pid_t> Pool;
   Pool *pool = Pool::empty();
+  Stack<pid_t> started;
 
   bool success = false;
   while(Timer::syncClock(), DECI(env.timer->elapsedMilliseconds()) < terminationTime)
   {
-    unsigned poolSize = pool ? Pool::length(pool) : 0;
+    // slices waiting for their preprocessing server occupy a worker as well
+    unsigned poolSize = (pool ? Pool::length(pool) : 0) + _pending;
 
     // running under capacity, wake up more tasks
     while(poolSize < _numWorkers && !queue.isEmpty())
@@ -79,6 +108,11 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
       pid_t process;
       if(!item.started())
       {
+        if(request(item.code(), item.key(), terminationTime))
+        {
+          poolSize++;
+          continue;
+        }
         process = spawn(item.code(), terminationTime);
       }
       else
@@ -92,12 +126,49 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
 
     bool stopped, exited;
     int code;
-    // sleep until process changes state
-    pid_t process = Multiprocessing::instance()
-      ->poll_children(stopped, exited, code);
+    pid_t process;
+    if(_pending)
+    {
+      // check the preprocessing servers regularly while slices wait for them
+      process = Multiprocessing::instance()
+        ->poll_children(stopped, exited, code, false);
+      if(!process)
+      {
+        checkServers(SERVER_POLL_TIME, started, terminationTime);
+      }
+    }
+    else
+    {
+      // sleep until process changes state
+      process = Multiprocessing::instance()
+        ->poll_children(stopped, exited, code);
+    }
+    for(;;)
+    {
+      while(started.isNonEmpty())
+      {
+        Pool::push(started.pop(), pool);
+      }
+      if(!process || _serverPids.contains(process) || Pool::member(process, pool))
+      {
+        break;
+      }
+      // a slice started by a server changed its state before we read its pid
+      checkServers(0, started, terminationTime);
+      if(started.isEmpty())
+      {
+        break;
+      }
+    }
 
+    // no process changed state, or a preprocessing server did,
+    // which is not in the pool as we stop the servers ourselves
+    if(!process || _serverPids.contains(process))
+    {
+      // nothing to do
+    }
     // child died, remove it from the pool and check if succeeded
-    if(exited)
+    else if(exited)
     {
       pool = Pool::remove(process, pool);
       if(!code)
@@ -115,7 +186,7 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
     }
 
     // pool empty and queue exhausted - we failed
-    if(!pool && queue.isEmpty())
+    if(!pool && !_pending && queue.isEmpty())
     {
       goto exit;
     }
@@ -129,6 +200,13 @@ exit:
     pid_t process = killIt.next();
     Multiprocessing::instance()->killNoCheck(process, SIGKILL);
   }
+  Stack<vstring> unstartedCodes;
+  while(_servers.size())
+  {
+    DHMap<vstring,PreprocessingServer*>::Iterator sit(_servers);
+    ALWAYS(sit.hasNext());
+    stopServer(sit.nextKey(), unstartedCodes);
+  }
   return success;
 }
 
@@ -146,6 +224,354 @@ unsigned ScheduleExecutor::getNumWorkers()
   return workers;
 }
 
+static bool readAll(int fd, void* buf, size_t size)
+{
+  char* ptr = static_cast<char*>(buf);
+  while(size)
+  {
+    ssize_t res = read(fd, ptr, size);
+    if(res == -1 && errno == EINTR)
+    {
+      continue;
+    }
+    if(res <= 0)
+    {
+      return false;
+    }
+    ptr += res;
+    size -= res;
+  }
+  return true;
+}
+
+/**
+ * Write @b size bytes from @b buf to the socket @b fd. Return false
+ * (rather than getting SIGPIPE) if the other side has been closed.
+ */
+static bool writeAll(int fd, const void* buf, size_t size)
+{
+  const char* ptr = static_cast<const char*>(buf);
+  while(size)
+  {
+    ssize_t res = send(fd, ptr, size, MSG_NOSIGNAL);
+    if(res == -1 && errno == EINTR)
+    {
+      continue;
+    }
+    if(res <= 0)
+    {
+      return false;
+    }
+    ptr += res;
+    size -= res;
+  }
+  return true;
+}
+
+/**
+ * If the slice @b code shares its preprocessing key @b key with other
+ * slices of the schedule, ask the preprocessing server of the key to start
+ * it (starting the server first if needed) and return true. The slice is
+ * then pending until the server sends us its pid (see checkServers).
+ *
+ * Return false if the slice has to be forked directly.
+ */
+bool ScheduleExecutor::request(vstring code, vstring key, int terminationTime)
+{
+  CALL("ScheduleExecutor::request");
+
+  if(key.empty() || _failedKeys.contains(key))
+  {
+    return false;
+  }
+
+  unsigned& unstarted = _unstarted.get(key);
+  ASS_G(unstarted, 0);
+  unstarted--;
+
+  PreprocessingServer* srv;
+  if(!_servers.find(key, srv))
+  {
+    if(!unstarted)
+    {
+      // nothing to share with
+      return false;
+    }
+    if(!startServer(code, key))
+    {
+      _failedKeys.insert(key);
+      return false;
+    }
+    srv = _servers.get(key);
+  }
+
+  unsigned index = srv->requests.size();
+  unsigned length = code.size();
+  if(!writeAll(srv->fd, &terminationTime, sizeof(terminationTime)) ||
+     !writeAll(srv->fd, &index, sizeof(index)) ||
+     !writeAll(srv->fd, &length, sizeof(length)) ||
+     !writeAll(srv->fd, code.c_str(), length))
+  {
+    // the server died, the slices will do their own preprocessing
+    // (the requests sent earlier are taken care of by checkServers)
+    _failedKeys.insert(key);
+    if(!srv->pending)
+    {
+      Stack<vstring> unstartedCodes;
+      stopServer(key, unstartedCodes);
+    }
+    return false;
+  }
+  srv->requests.push(code);
+  srv->pending++;
+  _pending++;
+
+  if(!srv->ready)
+  {
+    Timer::syncClock();
+    int deadline = DECI(env.timer->elapsedMilliseconds()) + _executor->getSliceTime(code);
+    srv->deadline = max(srv->deadline, min(deadline, terminationTime));
+  }
+  return true;
+}
+
+/**
+ * Fork a preprocessing server for the key @b key that preprocesses
+ * the problem for the slice @b code. Return false if the socket
+ * could not be created.
+ */
+bool ScheduleExecutor::startServer(vstring code, vstring key)
+{
+  CALL("ScheduleExecutor::startServer");
+
+  int fds[2];
+  if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds))
+  {
+    return false;
+  }
+
+  pid_t pid = Multiprocessing::instance()->fork();
+  ASS_NEQ(pid, -1);
+  if(!pid)
+  {
+    close(fds[0]);
+    runServer(code, fds[1]);
+  }
+
+  // the server end must not be kept open by us,
+  // so that we notice when the server dies
+  close(fds[1]);
+  PreprocessingServer* srv = new PreprocessingServer();
+  srv->pid = pid;
+  srv->fd = fds[0];
+  srv->ready = false;
+  srv->deadline = 0;
+  srv->pending = 0;
+  _servers.insert(key, srv);
+  _serverPids.insert(pid);
+  return true;
+}
+
+/**
+ * The main function of a preprocessing server.
+ *
+ * Each slice is forked through an intermediate process that terminates
+ * right away, so that the slice gets reparented to the schedule executor
+ * (which is a child subreaper) and can be controlled by it like a slice
+ * forked directly.
+ */
+void ScheduleExecutor::runServer(vstring code, int fd)
+{
+  CALL("ScheduleExecutor::runServer");
+
+  System::registerForSIGHUPOnParentDeath();
+
+  try
+  {
+    _executor->preprocess(code);
+  }
+  catch(Exception&)
+  {
+    // the slices will report the problem when preprocessing on their own
+    System::terminateImmediately(1);
+  }
+
+  for(;;)
+  {
+    int terminationTime;
+    unsigned index;
+    unsigned length;
+    if(!readAll(fd, &terminationTime, sizeof(terminationTime)) ||
+       !readAll(fd, &index, sizeof(index)) ||
+       !readAll(fd, &length, sizeof(length)))
+    {
+      break;
+    }
+    DArray<char> buf(length);
+    if(!readAll(fd, buf.array(), length))
+    {
+      break;
+    }
+    vstring sliceCode(buf.array(), length);
+
+    pid_t intermediate = Multiprocessing::instance()->fork();
+    ASS_NEQ(intermediate, -1);
+    if(!intermediate)
+    {
+      pid_t self = getpid();
+      pid_t slice = Multiprocessing::instance()->fork();
+      ASS_NEQ(slice, -1);
+      if(slice)
+      {
+        System::terminateImmediately(0);
+      }
+      // wait until we get reparented, otherwise we would be killed
+      // when registering for the death of the intermediate parent
+      while(getppid() == self)
+      {
+        Multiprocessing::instance()->sleep(1);
+      }
+      pid_t pid = getpid();
+      bool written = writeAll(fd, &index, sizeof(index)) &&
+        writeAll(fd, &pid, sizeof(pid));
+      close(fd);
+      if(!written)
+      {
+        System::terminateImmediately(1);
+      }
+      _executor->runSlice(sliceCode, terminationTime);
+      ASSERTION_VIOLATION; // should not return
+    }
+    int resValue;
+    Multiprocessing::instance()->waitForParticularChildTermination(intermediate, resValue);
+  }
+  System::terminateImmediately(1);
+}
+
+/**
+ * Wait at most @b timeout milliseconds for the preprocessing servers
+ * to start the requested slices, and push the pids of the started
+ * slices to @b started.
+ *
+ * If a server dies, the slices it did not start are forked directly.
+ * If a server is still preprocessing when all the slices waiting for it
+ * have run out of their time limits, it is stopped and the slices fail.
+ * The later slices of a failed server's key do their own preprocessing.
+ */
+void ScheduleExecutor::checkServers(int timeout, Stack<pid_t>& started, int terminationTime)
+{
+  CALL("ScheduleExecutor::checkServers");
+
+  Stack<vstring> keys;
+  Stack<pollfd> fds;
+  DHMap<vstring,PreprocessingServer*>::Iterator sit(_servers);
+  while(sit.hasNext())
+  {
+    vstring key;
+    PreprocessingServer* srv;
+    sit.next(key, srv);
+    if(!srv->pending)
+    {
+      continue;
+    }
+    pollfd pfd;
+    pfd.fd = srv->fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    keys.push(key);
+    fds.push(pfd);
+  }
+  if(fds.isEmpty())
+  {
+    return;
+  }
+  if(poll(fds.begin(), fds.size(), timeout) == -1)
+  {
+    if(errno != EINTR)
+    {
+      return;
+    }
+    // interrupted by the timer signal, only the deadlines get checked
+    for(unsigned i = 0; i < fds.size(); i++)
+    {
+      fds[i].revents = 0;
+    }
+  }
+
+  Timer::syncClock();
+  int now = DECI(env.timer->elapsedMilliseconds());
+  Stack<vstring> unstartedCodes;
+  for(unsigned i = 0; i < keys.size(); i++)
+  {
+    vstring key = keys[i];
+    PreprocessingServer* srv = _servers.get(key);
+    if(fds[i].revents)
+    {
+      unsigned index;
+      pid_t process;
+      if(!readAll(srv->fd, &index, sizeof(index)) ||
+         !readAll(srv->fd, &process, sizeof(process)))
+      {
+        // the server died, the slices will do their own preprocessing
+        _failedKeys.insert(key);
+        stopServer(key, unstartedCodes);
+        continue;
+      }
+      ASS(!srv->requests[index].empty());
+      srv->requests[index] = "";
+      srv->pending--;
+      _pending--;
+      srv->ready = true;
+      started.push(process);
+      if(!srv->pending && !_unstarted.get(key))
+      {
+        // all slices of the key were started
+        stopServer(key, unstartedCodes);
+      }
+    }
+    else if(!srv->ready && now >= srv->deadline)
+    {
+      // the slices would have run out of time in their own preprocessing as well
+      _failedKeys.insert(key);
+      Stack<vstring> timedOut;
+      stopServer(key, timedOut);
+    }
+  }
+
+  while(unstartedCodes.isNonEmpty())
+  {
+    started.push(spawn(unstartedCodes.pop(), terminationTime));
+  }
+}
+
+/**
+ * Kill the preprocessing server of @b key and push the codes of the
+ * slices it did not start to @b unstartedCodes. The slices it started
+ * keep running.
+ */
+void ScheduleExecutor::stopServer(vstring key, Stack<vstring>& unstartedCodes)
+{
+  CALL("ScheduleExecutor::stopServer");
+
+  PreprocessingServer* srv;
+  ALWAYS(_servers.pop(key, srv));
+  close(srv->fd);
+  Multiprocessing::instance()->killNoCheck(srv->pid, SIGKILL);
+
+  Stack<vstring>::Iterator rit(srv->requests);
+  while(rit.hasNext())
+  {
+    vstring code = rit.next();
+    if(!code.empty())
+    {
+      unstartedCodes.push(code);
+    }
+  }
+  ASS_GE(_pending, srv->pending);
+  _pending -= srv->pending;
+  delete srv;
+}
+
 pid_t ScheduleExecutor::spawn(vstring code, int terminationTime)
 {
   CALL("ScheduleExecutor::spawn");
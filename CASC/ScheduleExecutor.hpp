@@ -2,6 +2,9 @@
 #define __ScheduleExecutor__
 
 #include <unistd.h>
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
+#include "Lib/Stack.hpp"
 #include "Schedules.hpp"
 
 namespace CASC
@@ -18,6 +21,20 @@ class SliceExecutor
 {
 public:
   virtual void runSlice(Lib::vstring sliceCode, int terminationTime) NO_RETURN = 0;
+
+  /**
+   * Return a key such that all slices with the same non-empty key
+   * can be started from the problem preprocessed for any of them.
+   * Slices with an empty key always do their own preprocessing.
+   */
+  virtual Lib::vstring getPreprocessingKey(Lib::vstring sliceCode) { return ""; }
+  /**
+   * Preprocess the problem for the slice @b sliceCode. The slices
+   * later run by this process then start from the preprocessed problem.
+   */
+  virtual void preprocess(Lib::vstring sliceCode) { ASSERTION_VIOLATION; }
+  /** Return the time limit of the slice @b sliceCode in deciseconds */
+  virtual int getSliceTime(Lib::vstring sliceCode) { ASSERTION_VIOLATION; return 0; }
 };
 
 class ScheduleExecutor
@@ -27,12 +44,55 @@ public:
   bool run(const Schedule &schedule, int terminationTime);
 
 private:
+  /**
+   * A child process holding the problem preprocessed for a group
+   * of slices with the same preprocessing key. On request, it forks
+   * a slice of the group, which gets reparented to this process.
+   */
+  struct PreprocessingServer
+  {
+    CLASS_NAME(ScheduleExecutor::PreprocessingServer);
+    USE_ALLOCATOR(PreprocessingServer);
+
+    pid_t pid;
+    /** socket for sending slice requests and receiving the pids of the started slices */
+    int fd;
+    /** true once the server has started a slice, i.e. finished the preprocessing */
+    bool ready;
+    /**
+     * time (in deciseconds) when all slices requested so far run out
+     * of their time limits, the server is stopped if it is not ready by then
+     */
+    int deadline;
+    /** codes of the requested slices, the started ones are replaced by empty strings */
+    Lib::Stack<Lib::vstring> requests;
+    /** number of requested slices not started yet */
+    unsigned pending;
+  };
+
   pid_t spawn(Lib::vstring code, int terminationTime);
+  bool request(Lib::vstring code, Lib::vstring key, int terminationTime);
+  bool startServer(Lib::vstring code, Lib::vstring key);
+  void runServer(Lib::vstring code, int fd) NO_RETURN;
+  void checkServers(int timeout, Lib::Stack<pid_t>& started, int terminationTime);
+  void stopServer(Lib::vstring key, Lib::Stack<Lib::vstring>& unstartedCodes);
   unsigned getNumWorkers();
 
   ProcessPriorityPolicy *_policy;
   SliceExecutor *_executor;
   unsigned _numWorkers;
+
+  /** true if slices can be forked from preprocessing servers */
+  bool _sharePreprocessing;
+  /** number of slices of each preprocessing key still waiting in the queue */
+  Lib::DHMap<Lib::vstring,unsigned> _unstarted;
+  Lib::DHMap<Lib::vstring,PreprocessingServer*> _servers;
+  /** number of requested slices not started yet by their servers */
+  unsigned _pending;
+  /** pids of all preprocessing servers ever started */
+  Lib::DHSet<pid_t> _serverPids;
+  /** keys whose server failed, their slices preprocess on their own */
+  Lib::DHSet<Lib::vstring> _failedKeys;
 };
 }
 
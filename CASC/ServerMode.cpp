@@ -0,0 +1,336 @@
+
+/*
+ * File ServerMode.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ServerMode.cpp
+ * Implements class ServerMode.
+ */
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/StringUtils.hpp"
+#include "Lib/System.hpp"
+#include "Lib/TimeCounter.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Lib/Sys/Multiprocessing.hpp"
+
+#include "Kernel/Problem.hpp"
+
+#include "Saturation/ProvingHelper.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+#include "Shell/UIHelper.hpp"
+
+#include "ServerMode.hpp"
+
+using namespace CASC;
+using namespace std;
+using namespace Lib;
+using namespace Lib::Sys;
+using namespace Kernel;
+using namespace Saturation;
+using namespace Shell;
+
+/**
+ * Serve the requests from the standard input, or from the connections
+ * to the socket given by the server_socket option, until a "quit"
+ * request or the end of the input.
+ */
+void ServerMode::perform()
+{
+  CALL("ServerMode::perform");
+
+  // the time limit applies to each problem, not to the server
+  Timer::setTimeLimitEnforcement(false);
+
+  vstring path = env.options->serverSocket();
+  if (path == "") {
+    ServerMode server(0, 1);
+    server.serve();
+    return;
+  }
+
+  sockaddr_un addr;
+  if (path.size() >= sizeof(addr.sun_path)) {
+    USER_ERROR("Socket path too long: " + path);
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path.c_str());
+
+  int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (sock == -1) {
+    SYSTEM_FAIL("Call to socket() failed.", errno);
+  }
+  unlink(path.c_str());
+  if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1) {
+    SYSTEM_FAIL("Cannot bind socket " + path + ".", errno);
+  }
+  if (listen(sock, 16) == -1) {
+    SYSTEM_FAIL("Call to listen() failed.", errno);
+  }
+
+  // a client closing its connection early must not stop the server
+  signal(SIGPIPE, SIG_IGN);
+
+  for (;;) {
+    int conn = accept(sock, 0, 0);
+    if (conn == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      SYSTEM_FAIL("Call to accept() failed.", errno);
+    }
+    ServerMode server(conn, conn);
+    bool quit = !server.serve();
+    close(conn);
+    if (quit) {
+      break;
+    }
+  }
+  close(sock);
+  unlink(path.c_str());
+} // ServerMode::perform
+
+ServerMode::ServerMode(int in, int out)
+: _in(in), _out(out), _eof(false)
+{
+}
+
+/**
+ * Solve the problems sent through @b _in. Return false if the server
+ * should stop, true if the end of the input was reached.
+ */
+bool ServerMode::serve()
+{
+  CALL("ServerMode::serve");
+
+  vstring line;
+  while (readLine(line)) {
+    if (line == "quit") {
+      return false;
+    }
+    if (line == "" || line[0] == '%') {
+      continue;
+    }
+
+    Stack<vstring> parts;
+    StringUtils::splitStr(line.c_str(), ' ', parts);
+    Stack<vstring> words;
+    Stack<vstring>::BottomFirstIterator pit(parts);
+    while (pit.hasNext()) {
+      vstring word = pit.next();
+      if (word != "") {
+        words.push(word);
+      }
+    }
+    if (words.size() < 2 || words[0] != "problem") {
+      reply("% Unknown request: " + line + "\n");
+      continue;
+    }
+    vstring name = words[1];
+    Stack<vstring> options;
+    for (unsigned i = 2; i < words.size(); i++) {
+      options.push(words[i]);
+    }
+
+    vostringstream problem;
+    bool complete = false;
+    while (readLine(line)) {
+      if (line == "end_problem") {
+        complete = true;
+        break;
+      }
+      problem << line << '\n';
+    }
+    if (!complete) {
+      reply("% SZS status InputError for " + name + "\n% Unterminated problem\n");
+      break;
+    }
+    solve(name, options, problem.str());
+  }
+  return true;
+} // ServerMode::serve
+
+/**
+ * Read the next line from @b _in into @b line, without the end of line.
+ * Return false if there is no more input.
+ */
+bool ServerMode::readLine(vstring& line)
+{
+  CALL("ServerMode::readLine");
+
+  for (;;) {
+    size_t eol = _buffer.find('\n');
+    if (eol != vstring::npos) {
+      line = _buffer.substr(0, eol);
+      _buffer = _buffer.substr(eol + 1);
+      if (line.size() && line[line.size() - 1] == '\r') {
+        line = line.substr(0, line.size() - 1);
+      }
+      return true;
+    }
+    if (_eof) {
+      if (_buffer == "") {
+        return false;
+      }
+      line = _buffer;
+      _buffer = "";
+      return true;
+    }
+
+    char buf[4096];
+    ssize_t cnt = read(_in, buf, sizeof(buf));
+    if (cnt == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      SYSTEM_FAIL("Call to read() failed.", errno);
+    }
+    if (cnt == 0) {
+      _eof = true;
+    }
+    else {
+      _buffer.append(buf, cnt);
+    }
+  }
+} // ServerMode::readLine
+
+/**
+ * Write @b str to @b _out
+ */
+void ServerMode::reply(const vstring& str)
+{
+  CALL("ServerMode::reply");
+
+  const char* data = str.c_str();
+  size_t remaining = str.size();
+  while (remaining) {
+    ssize_t cnt = write(_out, data, remaining);
+    if (cnt == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // the client has gone, the next read will tell us
+      return;
+    }
+    data += cnt;
+    remaining -= cnt;
+  }
+} // ServerMode::reply
+
+/**
+ * Solve problem @b problem in a child process and report its result
+ */
+void ServerMode::solve(const vstring& name, const Stack<vstring>& options, const vstring& problem)
+{
+  CALL("ServerMode::solve");
+
+  cout.flush();
+  pid_t child = Multiprocessing::instance()->fork();
+  if (!child) {
+    solveInChild(name, options, problem);
+  }
+
+  int resValue;
+  try {
+    pid_t finishedChild = Multiprocessing::instance()->waitForChildTermination(resValue);
+    ASS_EQ(finishedChild, child);
+  }
+  catch (SystemFailException& ex) {
+    cerr << "% SystemFailException at server level" << endl;
+    ex.cry(cerr);
+    resValue = VAMP_RESULT_STATUS_UNHANDLED_EXCEPTION;
+  }
+
+  // the child reports its result unless it was stopped by
+  // a resource limit (status 1) or it crashed
+  if (resValue == 1) {
+    reply("% SZS status ResourceOut for " + name + "\n");
+  }
+  else if (resValue) {
+    reply("% SZS status Error for " + name + "\n");
+  }
+  reply("% SZS status Ended for " + name + "\n");
+} // ServerMode::solve
+
+/**
+ * Solve problem @b problem with the server options modified by
+ * @b options and write the result to @b _out
+ */
+void ServerMode::solveInChild(const vstring& name, const Stack<vstring>& options, const vstring& problem)
+{
+  CALL("ServerMode::solveInChild");
+
+  System::registerForSIGHUPOnParentDeath();
+  if (_out != 1) {
+    dup2(_out, 1);
+  }
+
+  try {
+    for (unsigned i = 0; i < options.size(); i += 2) {
+      const vstring& opt = options[i];
+      if (opt.size() < 2 || opt[0] != '-' || i + 1 == options.size()) {
+        USER_ERROR("Malformed option " + opt + " in the request for " + name);
+      }
+      if (opt[1] == '-') {
+        env.options->set(opt.c_str() + 2, options[i + 1].c_str(), true);
+      }
+      else {
+        env.options->set(opt.c_str() + 1, options[i + 1].c_str(), false);
+      }
+    }
+    env.options->setProblemName(name);
+    env.options->setForcedOptionValues();
+    env.options->checkGlobalOptionConstraints();
+    Allocator::setMemoryLimit(env.options->memoryLimit() * 1048576ul);
+    Lib::Random::setSeed(env.options->randomSeed());
+
+    env.timer->reset();
+    env.timer->start();
+    TimeCounter::reinitialize();
+    Timer::setTimeLimitEnforcement(true);
+
+    vistringstream input(problem);
+    ScopedPtr<Problem> prb(UIHelper::getInputProblem(*env.options, input));
+    ProvingHelper::runVampire(*prb, *env.options);
+
+    env.beginOutput();
+    UIHelper::outputResult(env.out());
+    env.endOutput();
+  }
+  catch (Exception& exc) {
+    env.beginOutput();
+    env.out() << "% SZS status Error for " << name << endl;
+    exc.cry(env.out());
+    env.endOutput();
+  }
+
+  cout.flush();
+  exit(0);
+} // ServerMode::solveInChild
@@ -0,0 +1,85 @@
+
+/*
+ * File ServerMode.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ServerMode.hpp
+ * Defines class ServerMode.
+ */
+
+#ifndef __ServerMode__
+#define __ServerMode__
+
+#include "Forwards.hpp"
+
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+namespace CASC {
+
+using namespace Lib;
+
+/**
+ * The server mode (--mode server) solves a stream of problems read from
+ * the standard input, or from the connections accepted on a UNIX socket
+ * if the option server_socket is set.
+ *
+ * Each problem is sent as a line
+ *
+ *   problem <name> [<option> <value>]...
+ *
+ * followed by the text of the problem and a line "end_problem". The options
+ * are written as on the command line and apply to this problem only, on top
+ * of the options the server was started with. A line "quit" stops the server.
+ * Empty lines and comments between problems are ignored.
+ *
+ * The server parses its options and initialises the global state once.
+ * Every problem is then solved by a child process forked from this warm
+ * parent, so that nothing done for one problem is visible to the next. The
+ * output of the child, i.e. the SZS status and the proof, is streamed back,
+ * followed by the line
+ *
+ *   % SZS status Ended for <name>
+ *
+ * The problems are solved one at a time, in the order they arrive.
+ */
+class ServerMode
+{
+public:
+  static void perform();
+private:
+  ServerMode(int in, int out);
+
+  bool serve();
+  bool readLine(vstring& line);
+  void solve(const vstring& name, const Stack<vstring>& options, const vstring& problem);
+  void solveInChild(const vstring& name, const Stack<vstring>& options, const vstring& problem) __attribute__((noreturn));
+  void reply(const vstring& str);
+
+  /** the descriptor the requests are read from */
+  int _in;
+  /** the descriptor the results are written to */
+  int _out;
+
+  /** buffer of the data read from @b _in but not yet returned by readLine() */
+  vstring _buffer;
+  bool _eof;
+};
+
+}
+
+#endif // __ServerMode__
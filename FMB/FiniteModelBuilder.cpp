@@ -26,6 +26,7 @@
  */
 
 #include <math.h>
+#include <signal.h>
 
 #include "Kernel/Ordering.hpp"
 #include "Kernel/Inference.hpp"
@@ -42,8 +43,11 @@
 #include "SAT/Preprocess.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/CDCLSolver.hpp"
 #include "SAT/BufferedSolver.hpp"
 
+#include "Test/RecordingSatSolver.hpp"
+
 #include "Lib/Environment.hpp"
 #include "Lib/Timer.hpp"
 #include "Lib/List.hpp"
@@ -53,6 +57,8 @@
 #include "Lib/Random.hpp"
 #include "Lib/DHSet.hpp"
 #include "Lib/ArrayMap.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+#include "Lib/Sys/SyncPipe.hpp"
 
 #include "Shell/UIHelper.hpp"
 #include "Shell/TPTPPrinter.hpp"
@@ -80,6 +86,8 @@
 namespace FMB 
 {
 
+using namespace Lib::Sys;
+
 FiniteModelBuilder::FiniteModelBuilder(Problem& prb, const Options& opt)
 : MainLoop(prb, opt), _sortedSignature(0), _groundClauses(0), _clauses(0),
                       _isAppropriate(true)
@@ -115,6 +123,7 @@ FiniteModelBuilder::FiniteModelBuilder(Problem& prb, const Options& opt)
   // Record option values
   _startModelSize = opt.fmbStartSize();
   _symmetryRatio = opt.fmbSymmetryRatio();
+  _cubeProcesses = opt.fmbCubeProcesses();
 
   // Load any symbols removed during preprocessing (and their definitions)
   _deletedFunctions.loadFromMap(prb.getEliminatedFunctions());
@@ -262,10 +271,18 @@ bool FiniteModelBuilder::reset(){
   }
 
   // Create a new SAT solver
-  try{
-    _solver = new MinisatInterfacingNewSimp(_opt,true);
-  }catch(Minisat::OutOfMemoryException&){
-    MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
+  if(_opt.satSolver() == Options::SatSolver::CDCL){
+    _solver = new CDCLSolver(_opt,true);
+  }
+  else {
+    try{
+      _solver = new MinisatInterfacingNewSimp(_opt,true);
+    }catch(Minisat::OutOfMemoryException&){
+      MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
+    }
+  }
+  if(_opt.satTrace()!="off") {
+    _solver = new Test::RecordingSatSolver(_solver.release(), _opt, "fmb");
   }
 
   /*
@@ -295,7 +312,8 @@ bool FiniteModelBuilder::reset(){
 */
 
   // set the number of SAT variables, this could cause an exception
-  _solver->ensureVarCount(offsets-1);
+  _satVarCnt = offsets-1;
+  _solver->ensureVarCount(_satVarCnt);
 
   // needs to be redone for each size as we use this to pick the number of
   // things to order and the constants to ground with 
@@ -1652,7 +1670,11 @@ MainLoopResult FiniteModelBuilder::runImpl()
         }
       }
 
-      satResult = _solver->solveUnderAssumptions(assumptions);
+      if (_cubeProcesses > 1) {
+        satResult = solveByCubes(assumptions);
+      } else {
+        satResult = _solver->solveUnderAssumptions(assumptions);
+      }
       env.statistics->phase = Statistics::FMB_CONSTRAINT_GEN;
     }
 
@@ -1677,7 +1699,7 @@ MainLoopResult FiniteModelBuilder::runImpl()
 
     {
       // _solver->explicitlyMinimizedFailedAssumptions(false,true); // TODO: try adding this in
-      const SATLiteralStack& failed = _solver->failedAssumptions();
+      const SATLiteralStack& failed = _cubeProcesses > 1 ? _cubeFailedAssumptions : _solver->failedAssumptions();
 
       if (_xmass) {
         unsigned domToGrow = UINT_MAX;
@@ -1836,6 +1858,233 @@ MainLoopResult FiniteModelBuilder::runImpl()
   return MainLoopResult(Statistics::REFUTATION_NOT_FOUND);
 }
 
+/**
+ * Number of cubes per worker process in solveByCubes. Having more cubes
+ * than workers evens out the differences in hardness of the cubes.
+ */
+static const unsigned CUBES_PER_CUBE_PROCESS = 4;
+
+void FiniteModelBuilder::selectCubeVariables(unsigned cnt, Stack<unsigned>& acc)
+{
+  CALL("FiniteModelBuilder::selectCubeVariables");
+
+  // the markers follow the variables of the symbols
+  unsigned symbolVarLimit = _xmass ? marker_offsets[0] : totalityMarker_offset;
+
+  // a cheap lookahead: a variable occurring often with both polarities
+  // (and in particular in binary clauses) constrains the instance the most
+  static DArray<unsigned> posOcc;
+  static DArray<unsigned> negOcc;
+  posOcc.init(symbolVarLimit,0);
+  negOcc.init(symbolVarLimit,0);
+
+  SATClauseStack::ConstIterator cit(_clausesToBeAdded);
+  while (cit.hasNext()) {
+    SATClause* cl = cit.next();
+    unsigned weight = cl->length() == 2 ? 2 : 1;
+    for (unsigned i = 0; i < cl->length(); i++) {
+      SATLiteral lit = (*cl)[i];
+      if (lit.var() >= symbolVarLimit) {
+        continue;
+      }
+      (lit.polarity() ? posOcc : negOcc)[lit.var()] += weight;
+    }
+  }
+
+  // keep acc sorted by decreasing score
+  static Stack<unsigned long long> scores;
+  scores.reset();
+  acc.reset();
+  for (unsigned var = 1; var < symbolVarLimit; var++) {
+    if (!posOcc[var] || !negOcc[var]) {
+      continue;
+    }
+    unsigned long long score = (unsigned long long)posOcc[var]*negOcc[var];
+    if (acc.size() == cnt && score <= scores.top()) {
+      continue;
+    }
+    if (acc.size() == cnt) {
+      acc.pop();
+      scores.pop();
+    }
+    acc.push(var);
+    scores.push(score);
+    for (unsigned i = acc.size()-1; i > 0 && scores[i-1] < scores[i]; i--) {
+      std::swap(acc[i-1],acc[i]);
+      std::swap(scores[i-1],scores[i]);
+    }
+  }
+}
+
+/**
+ * Solve the cubes idx, idx+_cubeProcesses, idx+2*_cubeProcesses, ... under @b assumptions.
+ * The cube number c assigns the i-th variable of @b cubeVars the i-th bit of c.
+ *
+ * A single line is written into @b pipe: "s" followed by the true variables of
+ * a model, or "u" followed by the union of the failed assumptions of all the
+ * cubes (cube literals excluded), in both cases terminated by zero.
+ */
+void FiniteModelBuilder::runCubeWorker(unsigned idx, const SATLiteralStack& assumptions,
+                                       const Stack<unsigned>& cubeVars, SyncPipe& pipe)
+{
+  CALL("FiniteModelBuilder::runCubeWorker");
+
+  // the parent takes care of the time limit and kills us if it dies
+  Timer::deinitializeTimer();
+  System::registerForSIGHUPOnParentDeath();
+  signal(SIGHUP, SIG_DFL);
+
+  pipe.neverRead();
+
+  unsigned cubeCnt = 1u << cubeVars.size();
+  unsigned assumptionCnt = assumptions.size();
+
+  static SATLiteralStack cubeAssumptions;
+  cubeAssumptions.reset();
+  cubeAssumptions.loadFromIterator(SATLiteralStack::ConstIterator(assumptions));
+
+  DHSet<unsigned> failedVars;
+  SATLiteralStack failed;
+  vostringstream res;
+
+  for (unsigned cube = idx; cube < cubeCnt; cube += _cubeProcesses) {
+    cubeAssumptions.truncate(assumptionCnt);
+    for (unsigned i = 0; i < cubeVars.size(); i++) {
+      cubeAssumptions.push(SATLiteral(cubeVars[i],(cube >> i) & 1));
+    }
+
+    if (_solver->solveUnderAssumptions(cubeAssumptions) == SATSolver::SATISFIABLE) {
+      res << 's';
+      for (unsigned var = 1; var <= _satVarCnt; var++) {
+        if (_solver->trueInAssignment(SATLiteral(var,1))) {
+          res << ' ' << var;
+        }
+      }
+      goto report;
+    }
+
+    bool cubeUsed = false;
+    const SATLiteralStack& cubeFailed = _solver->failedAssumptions();
+    for (unsigned i = 0; i < cubeFailed.size(); i++) {
+      SATLiteral lit = cubeFailed[i];
+      if (cubeVars.find(lit.var())) {
+        cubeUsed = true;
+      } else if (failedVars.insert(lit.var())) {
+        failed.push(lit);
+      }
+    }
+    if (!cubeUsed) {
+      // the instance is unsatisfiable regardless of the cube
+      break;
+    }
+  }
+
+  res << 'u';
+  for (unsigned i = 0; i < failed.size(); i++) {
+    res << ' ' << (failed[i].polarity() ? (int)failed[i].var() : -(int)failed[i].var());
+  }
+
+report:
+  res << " 0" << endl;
+
+  pipe.acquireWrite();
+  pipe.out() << res.str();
+  pipe.releaseWrite();
+
+  System::terminateImmediately(0);
+}
+
+SATSolver::Status FiniteModelBuilder::solveByCubes(const SATLiteralStack& assumptions)
+{
+  CALL("FiniteModelBuilder::solveByCubes");
+
+  unsigned cubeVarCnt = 0;
+  while ((1u << cubeVarCnt) < CUBES_PER_CUBE_PROCESS*_cubeProcesses) {
+    cubeVarCnt++;
+  }
+  static Stack<unsigned> cubeVars;
+  selectCubeVariables(cubeVarCnt,cubeVars);
+
+  _cubeFailedAssumptions.reset();
+
+  if (cubeVars.size() > 0) {
+    unsigned workerCnt = min(_cubeProcesses, 1u << cubeVars.size());
+
+    SyncPipe pipe;
+    Stack<pid_t> workers;
+    for (unsigned idx = 0; idx < workerCnt; idx++) {
+      pid_t pid = Multiprocessing::instance()->fork();
+      ASS_NEQ(pid,-1);
+      if (!pid) {
+        runCubeWorker(idx, assumptions, cubeVars, pipe);
+      }
+      workers.push(pid);
+    }
+    pipe.neverWrite();
+
+    // if a worker dies without reporting, we eventually read the end of the pipe
+    pipe.acquireRead();
+    istream& in = pipe.in();
+    DHSet<unsigned> failedVars;
+    DArray<bool> model;
+    bool satisfiable = false;
+    unsigned reported = 0;
+    char tag;
+    while (!satisfiable && reported < workerCnt && (in >> tag)) {
+      reported++;
+      satisfiable = (tag == 's');
+      if (satisfiable) {
+        model.init(_satVarCnt+1,false);
+      }
+      int lit;
+      while ((in >> lit) && lit != 0) {
+        if (satisfiable) {
+          model[lit] = true;
+        } else {
+          unsigned var = lit > 0 ? lit : -lit;
+          if (failedVars.insert(var)) {
+            _cubeFailedAssumptions.push(SATLiteral(var,lit > 0));
+          }
+        }
+      }
+    }
+    pipe.releaseRead();
+
+    Stack<pid_t>::Iterator wit(workers);
+    while (wit.hasNext()) {
+      pid_t worker = wit.next();
+      int status;
+      Multiprocessing::instance()->killNoCheck(worker, SIGKILL);
+      Multiprocessing::instance()->waitForParticularChildTermination(worker, status);
+    }
+    Timer::syncClock();
+
+    if (satisfiable) {
+      // load the model into our solver, this only takes propagation
+      static SATLiteralStack modelAssumptions;
+      modelAssumptions.reset();
+      modelAssumptions.loadFromIterator(SATLiteralStack::ConstIterator(assumptions));
+      for (unsigned var = 1; var <= _satVarCnt; var++) {
+        modelAssumptions.push(SATLiteral(var,model[var]));
+      }
+      if (_solver->solveUnderAssumptions(modelAssumptions) == SATSolver::SATISFIABLE) {
+        return SATSolver::SATISFIABLE;
+      }
+      ASSERTION_VIOLATION;
+    } else if (reported == workerCnt) {
+      return SATSolver::UNSATISFIABLE;
+    }
+    _cubeFailedAssumptions.reset();
+  }
+
+  // nothing to split on, or a worker failed; solve the instance here
+  SATSolver::Status res = _solver->solveUnderAssumptions(assumptions);
+  if (res == SATSolver::UNSATISFIABLE) {
+    _cubeFailedAssumptions.loadFromIterator(SATLiteralStack::ConstIterator(_solver->failedAssumptions()));
+  }
+  return res;
+}
+
 void FiniteModelBuilder::onModelFound()
 {
  CALL("FiniteModelBuilder::onModelFound");
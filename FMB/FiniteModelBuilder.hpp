@@ -140,6 +140,23 @@ private:
 
   // SAT solver used to solve constraints (a new one is used for each model size)
   ScopedPtr<SATSolverWithAssumptions> _solver;
+  // number of SAT variables of the current encoding
+  unsigned _satVarCnt;
+
+  // Solve the current SAT instance under assumptions by cube-and-conquer in _cubeProcesses
+  // worker processes. If satisfiable, _solver is left with the model. Otherwise the failed
+  // assumptions are stored in _cubeFailedAssumptions.
+  SATSolver::Status solveByCubes(const SATLiteralStack& assumptions);
+  // Pick up to cnt variables of symbols (not markers) to split the instance on.
+  // The variables occurring often in both polarities in _clausesToBeAdded are preferred.
+  void selectCubeVariables(unsigned cnt, Stack<unsigned>& acc);
+  // Solve the cubes assigned to worker number idx and report the result into pipe, does not return
+  void runCubeWorker(unsigned idx, const SATLiteralStack& assumptions, const Stack<unsigned>& cubeVars,
+                     Lib::Sys::SyncPipe& pipe) __attribute__((noreturn));
+
+  // number of worker processes to use for cube-and-conquer (no cubes if <= 1)
+  unsigned _cubeProcesses;
+  SATLiteralStack _cubeFailedAssumptions;
 
   // Structures to record symbols removed during preprocessing i.e. via definition elimination
   // These are ignored throughout finite model building and then the definitions (recorded here)
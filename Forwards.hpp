@@ -272,12 +272,14 @@ namespace Indexing
 {
 class Index;
 class IndexManager;
+class IndexTrace;
 class LiteralIndex;
 class LiteralIndexingStructure;
 class TermIndex;
 class TermIndexingStructure;
 class ClauseSubsumptionIndex;
 class FormulaIndex;
+class UnificationCountSketch;
 
 class TermSharing;
 
@@ -319,6 +321,9 @@ class PassiveClauseContainer;
 typedef Lib::SmartPtr<PassiveClauseContainer> PassiveClauseContainerSP;
 
 class ActiveClauseContainer;
+struct CriticalPair;
+class CriticalPairQueue;
+class MetricsStream;
 
 class Limits;
 class Splitter;
@@ -344,6 +349,8 @@ class BackwardSimplificationEngine;
 typedef Lib::SmartPtr<BackwardSimplificationEngine> BackwardSimplificationEngineSP;
 
 class BDDMarkingSubsumption;
+
+class Superposition;
 }
 
 namespace SAT
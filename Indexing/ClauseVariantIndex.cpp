@@ -21,6 +21,7 @@
  * Implements class ClauseVariantIndex.
  */
 
+#include "Lib/Environment.hpp"
 #include "Lib/List.hpp"
 #include "Lib/Metaiterators.hpp"
 #include "Lib/SmartPtr.hpp"
@@ -33,6 +34,7 @@
 
 #include "LiteralMiniIndex.hpp"
 #include "LiteralSubstitutionTree.hpp"
+#include "TermSharing.hpp"
 
 #include "ClauseVariantIndex.hpp"
 
@@ -175,6 +177,26 @@ SubstitutionTreeClauseVariantIndex::~SubstitutionTreeClauseVariantIndex()
   }
 }
 
+void SubstitutionTreeClauseVariantIndex::markSharedTerms()
+{
+  CALL("SubstitutionTreeClauseVariantIndex::markSharedTerms");
+
+  unsigned streeArrSz=_strees.size();
+  for(unsigned i=0;i<streeArrSz;i++) {
+    if(_strees[i]!=0) {
+      _strees[i]->markSharedTerms();
+    }
+  }
+
+  DHMap<Literal*, ClauseList*>::Iterator it(_groundUnits);
+  while (it.hasNext()) {
+    Literal* lit;
+    ClauseList* cls;
+    it.next(lit, cls);
+    env.sharing->markLive(lit);
+  }
+}
+
 /**
  * Inserts a new Clause
  *
@@ -204,6 +226,46 @@ void SubstitutionTreeClauseVariantIndex::insert(Clause* cl)
   _strees[clen]->insert(mainLit, cl);
 }
 
+/**
+ * Insert the clauses of @b cls, the substitution tree of each
+ * clause length is given all its main literals at once
+ */
+void SubstitutionTreeClauseVariantIndex::bulkInsert(const ClauseStack& cls)
+{
+  CALL("SubstitutionTreeClauseVariantIndex::bulkInsert");
+
+  typedef LiteralIndexingStructure::EntryStack EntryStack;
+  DHMap<unsigned, EntryStack*> byLength;
+  Stack<unsigned> lengths;
+
+  ClauseStack::ConstIterator cit(cls);
+  while(cit.hasNext()) {
+    Clause* cl=cit.next();
+    unsigned clen=cl->length();
+    if(clen==0 || (clen==1 && (*cl)[0]->ground())) {
+      insert(cl);
+      continue;
+    }
+    EntryStack** pentries;
+    if(byLength.getValuePtr(clen, pentries)) {
+      *pentries=new EntryStack();
+      lengths.push(clen);
+    }
+    (*pentries)->push(LiteralIndexingStructure::Entry(getMainLiteral(cl->literals(), clen), cl));
+  }
+
+  Stack<unsigned>::BottomFirstIterator lit(lengths);
+  while(lit.hasNext()) {
+    unsigned clen=lit.next();
+    if(!_strees[clen]) {
+      _strees[clen]=new LiteralSubstitutionTree();
+    }
+    EntryStack* entries=byLength.get(clen);
+    _strees[clen]->bulkInsert(*entries);
+    delete entries;
+  }
+}
+
 Literal* SubstitutionTreeClauseVariantIndex::getMainLiteral(Literal* const * lits, unsigned length)
 {
   CALL("SubstitutionTreeClauseVariantIndex::getMainLiteral");
@@ -30,6 +30,7 @@
 #include "Lib/Array.hpp"
 #include "Lib/List.hpp"
 #include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
 
 namespace Indexing {
 
@@ -43,6 +44,21 @@ public:
 
   virtual void insert(Clause* cl) = 0;
 
+  /**
+   * Insert all the clauses of @b cls. Indexes that can build
+   * their content from a whole batch faster than clause by clause
+   * override this.
+   */
+  virtual void bulkInsert(const ClauseStack& cls)
+  {
+    CALL("ClauseVariantIndex::bulkInsert");
+
+    ClauseStack::ConstIterator cit(cls);
+    while(cit.hasNext()) {
+      insert(cit.next());
+    }
+  }
+
   virtual ClauseIterator retrieveVariants(Literal* const * lits, unsigned length) = 0;
   ClauseIterator retrieveVariants(Clause* cl)
   {
@@ -52,6 +68,9 @@ public:
 
     return retrieveVariants(cl->literals(), cl->length());
   }
+
+  /** Mark the shared terms used by the index as live, see TermSharing::collect */
+  virtual void markSharedTerms() {}
 protected:
   class ResultClauseToVariantClauseFn;
 };
@@ -67,9 +86,12 @@ public:
   virtual ~SubstitutionTreeClauseVariantIndex() override;
 
   virtual void insert(Clause* cl) override;
+  void bulkInsert(const ClauseStack& cls) override;
 
   ClauseIterator retrieveVariants(Literal* const * lits, unsigned length) override;
 
+  void markSharedTerms() override;
+
 private:
   class SLQueryResultToClauseFn;
 
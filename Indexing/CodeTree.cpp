@@ -27,6 +27,7 @@
 
 #include "Lib/BitUtils.hpp"
 #include "Lib/Comparison.hpp"
+#include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Portability.hpp"
 #include "Lib/Sort.hpp"
@@ -36,6 +37,8 @@
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
 
+#include "TermSharing.hpp"
+
 #include "CodeTree.hpp"
 
 #define GROUND_TERM_CHECK 0
@@ -747,6 +750,49 @@ void CodeTree::visitAllOps(Visitor visitor)
   }
 }
 
+/** Visitor marking the shared terms referenced by code operations */
+struct CodeTree::SharedTermMarker
+{
+  SharedTermMarker(void (*markResult)(void*)) : markResult(markResult) {}
+
+  void operator()(CodeOp* op)
+  {
+    if (op->isCheckGroundTerm()) {
+      env.sharing->markLive(op->getTargetTerm());
+    }
+    else if (op->isSuccess()) {
+      if (markResult) {
+        (*markResult)(op->getSuccessResult());
+      }
+    }
+    else if (op->isSearchStruct()) {
+      SearchStruct* ss = op->getSearchStruct();
+      if (ss->kind==SearchStruct::GROUND_TERM_STRUCT) {
+        GroundTermSearchStruct* gss = static_cast<GroundTermSearchStruct*>(ss);
+        for (size_t i = 0; i < gss->length; i++) {
+          env.sharing->markLive(gss->values[i]);
+        }
+      }
+    }
+  }
+
+  void (*markResult)(void*);
+};
+
+/**
+ * Mark the shared terms used by the code as live, see TermSharing::collect.
+ *
+ * The results stored in the success operations are passed to
+ * @b markResult (if non-zero), as only the descendant knows
+ * what they are.
+ */
+void CodeTree::markSharedTerms(void (*markResult)(void* result))
+{
+  CALL("CodeTree::markSharedTerms");
+
+  visitAllOps(SharedTermMarker(markResult));
+}
+
 //////////////// insertion ////////////////////
 
 void CodeTree::CompileContext::init()
@@ -1122,8 +1168,8 @@ void CodeTree::optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp
 
     if(op!=firstOp) {
       ASS(op->alternative());
-      //we only change the instruction, the alternative must remain unchanged
-      op->makeFail();
+      //the code from op on is dead, so its alternative takes its place
+      compactBlock(firstOp, op, firstsInBlocks->isEmpty() ? 0 : firstsInBlocks->top());
       return;
     }
     CodeOp* alt=firstOp->alternative();
@@ -1180,13 +1226,21 @@ void CodeTree::optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp
 	    (ss->kind==SearchStruct::GROUND_TERM_STRUCT && alt->isCheckGroundTerm()) );
 	return;
       }
+      size_t liveTargets=0;
       for(size_t i=0; i<ss->length; i++) {
 	if(ss->targets[i]!=0) {
-	  //the SearchStruct still contains something, so we won't delete it
-	  //TODO: we might want to compress the SearchStruct, if there are too many zeroes
-	  return;
+	  liveTargets++;
 	}
       }
+      if(liveTargets) {
+	//the SearchStruct still contains something, so we won't delete it,
+	//but we rebuild it once at least half of it are holes
+	if(liveTargets>1 && liveTargets*2<=ss->length) {
+	  ASS(firstsInBlocks->isNonEmpty());
+	  compactSearchStruct(ss, firstsInBlocks->top());
+	}
+	return;
+      }
 
       //if we're at this point, the SEARCH_STRUCT will be deleted
       firstOp=&ss->landingOp;
@@ -1236,6 +1290,119 @@ void CodeTree::optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp
   }
 }
 
+/**
+ * Remove the dead code of the CodeBlock starting at @b firstOp, which is
+ * the operation @b deadOp and all the operations after it, and put the
+ * code of the alternative of @b deadOp in its place
+ *
+ * @b parentFirstOp is the first operation of the CodeBlock (or the
+ * landing operation of the SearchStruct) that points to the CodeBlock,
+ * or zero if the CodeBlock is the entry point.
+ *
+ * If the alternative is a SearchStruct, it cannot be merged into the
+ * CodeBlock and @b deadOp is just replaced by a FAIL operation.
+ */
+void CodeTree::compactBlock(CodeOp* firstOp, CodeOp* deadOp, CodeOp* parentFirstOp)
+{
+  CALL("CodeTree::compactBlock");
+  ASS_G(deadOp, firstOp);
+  ASS(deadOp->alternative());
+
+  CodeBlock* cb=firstOpToCodeBlock(firstOp);
+  size_t cbLen=cb->length();
+  size_t keptLen=deadOp-firstOp;
+  ASS_L(keptLen, cbLen);
+
+  for(size_t i=keptLen; i<cbLen; i++) {
+    CodeOp& op=(*cb)[i];
+    ASS(i==keptLen || !op.alternative());
+    if(_clauseCodeTree && op.isLitEnd()) {
+      delete op.getILS();
+    }
+  }
+
+  CodeOp* alt=deadOp->alternative();
+  CodeBlock* altCb=alt->isSearchStruct() ? 0 : firstOpToCodeBlock(alt);
+  size_t altLen=altCb ? altCb->length() : 1;
+
+  CodeBlock* res=CodeBlock::allocate(keptLen+altLen);
+  for(size_t i=0; i<keptLen; i++) {
+    (*res)[i]=(*cb)[i];
+  }
+  if(altCb) {
+    for(size_t i=0; i<altLen; i++) {
+      (*res)[keptLen+i]=(*altCb)[i];
+    }
+    altCb->deallocate();
+  }
+  else {
+    CodeOp& failOp=(*res)[keptLen];
+    failOp=*deadOp;
+    failOp.makeFail();
+  }
+  redirectPointer(parentFirstOp, firstOp, &(*res)[0]);
+  cb->deallocate();
+}
+
+/**
+ * Make the pointer to the CodeBlock starting at @b oldFirstOp point to
+ * @b newFirstOp, which has the same instruction. The old CodeBlock must
+ * not be deallocated yet.
+ *
+ * @b parentFirstOp is the first operation of the CodeBlock (or the
+ * landing operation of the SearchStruct) that contains the pointer,
+ * or zero if the pointer is the entry point.
+ */
+void CodeTree::redirectPointer(CodeOp* parentFirstOp, CodeOp* oldFirstOp, CodeOp* newFirstOp)
+{
+  CALL("CodeTree::redirectPointer");
+
+  if(!parentFirstOp) {
+    ASS_EQ(_entryPoint, firstOpToCodeBlock(oldFirstOp));
+    _entryPoint=firstOpToCodeBlock(newFirstOp);
+    return;
+  }
+  if(parentFirstOp->isSearchStruct() && parentFirstOp->alternative()!=oldFirstOp) {
+    FixedSearchStruct* ss=static_cast<FixedSearchStruct*>(parentFirstOp->getSearchStruct());
+    ASS(ss->isFixedSearchStruct());
+    CodeOp** tgtPtr;
+    ALWAYS(ss->getTargetOpPtr(*newFirstOp, tgtPtr));
+    ASS_EQ(*tgtPtr, oldFirstOp);
+    *tgtPtr=newFirstOp;
+    return;
+  }
+
+  CodeOp* pointingOp=parentFirstOp;
+  DEBUG_CODE(CodeOp* afterLastOp=parentFirstOp->isSearchStruct() ? parentFirstOp+1 :
+      parentFirstOp+firstOpToCodeBlock(parentFirstOp)->length(););
+  while(pointingOp->alternative()!=oldFirstOp) {
+    pointingOp++;
+    ASS_L(pointingOp, afterLastOp);
+  }
+  pointingOp->setAlternative(newFirstOp);
+}
+
+/**
+ * Rebuild the SearchStruct @b ss without the holes left by removals
+ *
+ * @b parentFirstOp is the first operation of the CodeBlock that contains
+ * the operation whose alternative is @b ss.
+ */
+void CodeTree::compactSearchStruct(SearchStruct* ss, CodeOp* parentFirstOp)
+{
+  CALL("CodeTree::compactSearchStruct");
+  //there never are two nested SEARCH_STRUCT operations
+  ASS(!parentFirstOp->isSearchStruct());
+
+  CodeOp* pointingOp=parentFirstOp;
+  DEBUG_CODE(CodeOp* afterLastOp=parentFirstOp+firstOpToCodeBlock(parentFirstOp)->length(););
+  while(pointingOp->alternative()!=&ss->landingOp) {
+    pointingOp++;
+    ASS_L(pointingOp, afterLastOp);
+  }
+  compressCheckOps(pointingOp, ss->kind);
+}
+
 void CodeTree::RemovingMatcher::init(CodeOp* entry_, LitInfo* linfos_,
     size_t linfoCnt_, CodeTree* tree_, Stack<CodeOp*>* firstsInBlocks_)
 {
@@ -1452,84 +1619,97 @@ void CodeTree::Matcher::init(CodeTree* tree_, CodeOp* entry_)
   bindings.ensure(tree->_maxVarCnt);
 }
 
+/**
+ * Run the code from @b op until a LIT_END or a SUCCESS operation is
+ * reached (then return true) or there is nothing more to try (then
+ * return false)
+ *
+ * The interpreter is direct-threaded: each instruction jumps straight to
+ * the handler of the next one through a table indexed by the instruction
+ * bits (see CodeOp::dispatchIndex()), instead of going back to a switch.
+ */
 bool CodeTree::Matcher::execute()
 {
   CALL("CodeTree::Matcher::execute");
 
+  static void* const dispatchTable[16] = {
+      &&successOrFail, &&checkGroundTerm, &&litEnd, &&checkFun,
+      &&successOrFail, &&checkGroundTerm, &&litEnd, &&assignVar,
+      &&successOrFail, &&checkGroundTerm, &&litEnd, &&checkVar,
+      &&successOrFail, &&checkGroundTerm, &&litEnd, &&searchStruct
+  };
+
+#define DISPATCH_OP \
+  if(op->alternative()) { \
+    btStack.push(BTPoint(tp, op->alternative())); \
+  } \
+  goto *dispatchTable[op->dispatchIndex()];
+
+  //In each CodeBlock there is always either operation LIT_END or FAIL.
+  //As we haven't encountered one yet, we may safely increase the
+  //operation pointer (the SEARCH_STRUCT operation does not appear in
+  //CodeBlocks, so it never gets here)
+#define NEXT_OP \
+  ASS(!op->isSearchStruct()); \
+  op++; \
+  DISPATCH_OP
+
+#define BACKTRACK \
+  if(!backtrack()) { \
+    return false; \
+  } \
+  DISPATCH_OP
+
   if(_fresh) {
     _fresh=false;
+    DISPATCH_OP
   }
-  else {
-    //we backtrack from what we found in the previous run
-    if(!backtrack()) {
-      return false;
-    }
+  //we backtrack from what we found in the previous run
+  BACKTRACK
+
+successOrFail:
+  //yield successes only in the first round (we don't want to yield the
+  //same thing for each query literal)
+  if(op->isFail() || curLInfo!=0) {
+    BACKTRACK
   }
+  return true;
 
+litEnd:
+  return true;
 
-  bool shouldBacktrack=false;
-  for(;;) {
-    if(op->alternative()) {
-      btStack.push(BTPoint(tp, op->alternative()));
-    }
-    switch(op->instrPrefix()) {
-    case SUCCESS_OR_FAIL:
-      if(op->isFail()) {
-	shouldBacktrack=true;
-	break;
-      }
-      //yield successes only in the first round (we don't want to yield the
-      //same thing for each query literal)
-      if(curLInfo==0) {
-	return true;
-      }
-      else {
-	shouldBacktrack=true;
-      }
-      break;
-    case LIT_END:
-      return true;
-    case CHECK_GROUND_TERM:
-      shouldBacktrack=!doCheckGroundTerm();
-      break;
-    case SUFFIX_INSTR:
-      switch(op->instrSuffix()) {
-      case CHECK_FUN:
-        shouldBacktrack=!doCheckFun();
-        break;
-      case ASSIGN_VAR:
-        doAssignVar();
-        break;
-      case CHECK_VAR:
-        shouldBacktrack=!doCheckVar();
-        break;
-      case SEARCH_STRUCT:
-	if(doSearchStruct()) {
-	  //a new value of @b op is assigned, so restart the loop
-	  continue;
-	}
-	else {
-	  shouldBacktrack=true;
-	}
-	break;
-      }
-      break;
-    }
-    if(shouldBacktrack) {
-      if(!backtrack()) {
-	return false;
-      }
-      shouldBacktrack=false;
-    }
-    else {
-      //the SEARCH_STRUCT operation does not appear in CodeBlocks
-      ASS(!op->isSearchStruct());
-      //In each CodeBlock there is always either operation LIT_END or FAIL.
-      //As we haven't encountered one yet, we may safely increase the
-      //operation pointer
-      op++;
-    }
+checkGroundTerm:
+  if(!doCheckGroundTerm()) {
+    BACKTRACK
   }
+  NEXT_OP
+
+checkFun:
+  if(!doCheckFun()) {
+    BACKTRACK
+  }
+  NEXT_OP
+
+assignVar:
+  doAssignVar();
+  NEXT_OP
+
+checkVar:
+  if(!doCheckVar()) {
+    BACKTRACK
+  }
+  NEXT_OP
+
+searchStruct:
+  if(!doSearchStruct()) {
+    BACKTRACK
+  }
+  //a new value of @b op is assigned
+  DISPATCH_OP
+
+#undef DISPATCH_OP
+#undef NEXT_OP
+#undef BACKTRACK
 }
 
 /**
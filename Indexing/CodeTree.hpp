@@ -231,6 +231,22 @@ public:
       return static_cast<InstructionSuffix>(_info.suffix);
     }
 
+    /**
+     * Return the index of the instruction in the dispatch table of
+     * Matcher::execute(), i.e. the prefix and (if any) suffix bits
+     *
+     * For instructions other than SUFFIX_INSTR ones the suffix bits are
+     * a part of the pointer, so the table has the same entry for all
+     * their values.
+     */
+    inline unsigned dispatchIndex() const
+    {
+      unsigned res=static_cast<unsigned>(_data&15);
+      ASS_EQ(res&3, _info.prefix);
+      ASS(_info.prefix!=SUFFIX_INSTR || (res>>2)==_info.suffix);
+      return res;
+    }
+
     inline unsigned arg() const { return _info.arg; }
     inline CodeOp* alternative() const { return _alternative; }
     inline CodeOp*& alternative() { return _alternative; }
@@ -368,6 +384,9 @@ public:
   template<class Visitor>
   void visitAllOps(Visitor visitor);
 
+  void markSharedTerms(void (*markResult)(void* result)=0);
+  struct SharedTermMarker;
+
   //////////// insertion //////////////
 
   typedef DHMap<unsigned,unsigned> VarMap;
@@ -396,6 +415,9 @@ public:
   //////////// removal //////////////
 
   void optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp* removedOp);
+  void compactBlock(CodeOp* firstOp, CodeOp* deadOp, CodeOp* parentFirstOp);
+  void redirectPointer(CodeOp* parentFirstOp, CodeOp* oldFirstOp, CodeOp* newFirstOp);
+  void compactSearchStruct(SearchStruct* ss, CodeOp* parentFirstOp);
 
   struct RemovingMatcher
   : public BaseMatcher
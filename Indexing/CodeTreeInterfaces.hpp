@@ -58,6 +58,8 @@ public:
   TermQueryResultIterator getGeneralizations(TermList t, bool retrieveSubstitutions = true);
   bool generalizationExists(TermList t);
 
+  bool markSharedTerms() { _ct.markSharedTerms(); return true; }
+
 #if VDEBUG
   virtual void markTagged(){ NOT_IMPLEMENTED; } 
 #endif
@@ -92,6 +94,8 @@ public:
   USE_ALLOCATOR(CodeTreeSubsumptionIndex);
 
   ClauseSResResultIterator getSubsumingOrSResolvingClauses(Clause* c, bool subsumptionResolution);
+
+  bool markSharedTerms() { _ct.markSharedTerms(); return true; }
 protected:
   //overrides Index::handleClause
   void handleClause(Clause* c, bool adding);
@@ -23,15 +23,19 @@
 
 #include "GroundingIndex.hpp"
 
+#include "Lib/Environment.hpp"
 #include "Lib/SharedSet.hpp"
 
 #include "Kernel/Grounder.hpp"
 #include "Kernel/Inference.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "Shell/Options.hpp"
 
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/CDCLSolver.hpp"
 #include "SAT/BufferedSolver.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
@@ -47,6 +51,9 @@ GroundingIndex::GroundingIndex(const Options& opt)
     case Options::SatSolver::VAMPIRE:
     	_solver = new TWLSolver(opt,true);
     	break;
+    case Options::SatSolver::CDCL:
+      _solver = new CDCLSolver(opt,true);
+      break;
 #if VZ3
     case Options::SatSolver::Z3:
       //cout << "Warning, Z3 not curently used for Global Subsumption" << endl; 
@@ -61,6 +68,21 @@ GroundingIndex::GroundingIndex(const Options& opt)
   _grounder = new GlobalSubsumptionGrounder(_solver.ptr());
 }
 
+/**
+ * Mark the literals grounded so far, the grounder keeps their
+ * SAT variables.
+ */
+bool GroundingIndex::markSharedTerms()
+{
+  CALL("GroundingIndex::markSharedTerms");
+
+  LiteralIterator lits = _grounder->groundedLits();
+  while (lits.hasNext()) {
+    env.sharing->markLive(lits.next());
+  }
+  return true;
+}
+
 void GroundingIndex::handleClause(Clause* c, bool adding)
 {
   CALL("GroundingIndex::handleClause");
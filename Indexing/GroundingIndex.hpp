@@ -47,6 +47,8 @@ public:
   SATSolverWithAssumptions& getSolver() { return *_solver; }
   GlobalSubsumptionGrounder& getGrounder() { return *_grounder; }
 
+  bool markSharedTerms() override;
+
 protected:
   virtual void handleClause(Clause* c, bool adding);
 
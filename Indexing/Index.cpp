@@ -22,6 +22,15 @@
  *
  */
 
+#include <algorithm>
+
+#include "Lib/DHSet.hpp"
+#include "Lib/Environment.hpp"
+
+#include "Kernel/Clause.hpp"
+
+#include "Shell/Statistics.hpp"
+
 #include "Index.hpp"
 
 
@@ -32,6 +41,29 @@ using namespace Lib;
 using namespace Kernel;
 using namespace Saturation;
 
+/**
+ * The state of a lazy index.
+ *
+ * A lazy index keeps the set of clauses of its container at all times,
+ * but inserts them into its indexing structure only when it is first
+ * queried. If @b dropAfter is non-zero, the content of the indexing
+ * structure is removed again once that many updates happened since
+ * the last query.
+ */
+struct Index::LazyState
+{
+  CLASS_NAME(Index::LazyState);
+  USE_ALLOCATOR(Index::LazyState);
+
+  LazyState(unsigned dropAfter)
+  : built(false), dropAfter(dropAfter), sinceQuery(0) {}
+
+  DHSet<Clause*> clauses;
+  bool built;
+  unsigned dropAfter;
+  unsigned sinceQuery;
+};
+
 Index::~Index()
 {
   if(!_addedSD.isEmpty()) {
@@ -39,6 +71,9 @@ Index::~Index()
     _addedSD->unsubscribe();
     _removedSD->unsubscribe();
   }
+  if(_lazy) {
+    delete _lazy;
+  }
 }
 
 /**
@@ -54,4 +89,105 @@ void Index::attachContainer(ClauseContainer* cc)
   _removedSD = cc->removedEvent.subscribe(this,&Index::onRemovedFromContainer);
 }
 
+/**
+ * Make the index build its indexing structure only when it is queried,
+ * and if @b dropAfter is non-zero, empty the structure again after
+ * @b dropAfter updates without a query.
+ *
+ * Must be called before a container is attached, and only for indexes
+ * whose query methods call prepareForQuery().
+ */
+void Index::makeLazy(unsigned dropAfter)
+{
+  CALL("Index::makeLazy");
+  ASS(_addedSD.isEmpty());
+  ASS(!_lazy);
+
+  _lazy = new LazyState(dropAfter);
+}
+
+void Index::lazyUpdate(Clause* c, bool adding)
+{
+  CALL("Index::lazyUpdate");
+
+  if(adding) {
+    ALWAYS(_lazy->clauses.insert(c));
+  }
+  else {
+    ALWAYS(_lazy->clauses.remove(c));
+  }
+
+  if(!_lazy->built) {
+    env.statistics->deferredIndexUpdates++;
+    return;
+  }
+  handleClause(c, adding);
+
+  // the structure is only emptied on insertion, as removals can
+  // happen while a query result is being iterated
+  if(adding && _lazy->dropAfter && ++_lazy->sinceQuery>=_lazy->dropAfter) {
+    drop();
+  }
+}
+
+void Index::lazyQuery()
+{
+  CALL("Index::lazyQuery");
+
+  _lazy->sinceQuery = 0;
+  if(!_lazy->built) {
+    build();
+  }
+}
+
+struct ClauseNumberLess
+{
+  bool operator()(Clause* c1, Clause* c2) const
+  { return c1->number() < c2->number(); }
+};
+
+/**
+ * Insert all the clauses of the container into the indexing structure
+ *
+ * The clauses are inserted in the order of their numbers, so that the
+ * order of the query results does not depend on the addresses of clauses.
+ */
+void Index::build()
+{
+  CALL("Index::build");
+  ASS(!_lazy->built);
+
+  static Stack<Clause*> clauses;
+  clauses.reset();
+  clauses.loadFromIterator(DHSet<Clause*>::Iterator(_lazy->clauses));
+  std::sort(clauses.begin(), clauses.end(), ClauseNumberLess());
+
+  beginBulkInsertion();
+  Stack<Clause*>::BottomFirstIterator cit(clauses);
+  while(cit.hasNext()) {
+    handleClause(cit.next(), true);
+  }
+  endBulkInsertion();
+  _lazy->built = true;
+  env.statistics->lazyIndexBuilds++;
+  env.statistics->lazyIndexBuildUpdates += clauses.size();
+}
+
+/**
+ * Remove all the clauses from the indexing structure, the clauses of
+ * the container are kept so that the structure can be built again
+ */
+void Index::drop()
+{
+  CALL("Index::drop");
+  ASS(_lazy->built);
+
+  DHSet<Clause*>::Iterator cit(_lazy->clauses);
+  while(cit.hasNext()) {
+    handleClause(cit.next(), false);
+  }
+  _lazy->built = false;
+  env.statistics->lazyIndexDrops++;
+}
+
 }
@@ -131,21 +131,66 @@ public:
   virtual ~Index();
 
   void attachContainer(ClauseContainer* cc);
+
+  void makeLazy(unsigned dropAfter);
+  bool isLazy() const { return _lazy; }
+
+  /**
+   * Mark the shared terms used by the index as live (see
+   * TermSharing::collect) and return true, or return false if
+   * the index does not support this. In the latter case no
+   * shared terms may be collected while the index exists.
+   */
+  virtual bool markSharedTerms() { return false; }
 protected:
-  Index() {}
+  Index() : _lazy(0) {}
 
   void onAddedToContainer(Clause* c)
-  { handleClause(c, true); }
+  {
+    if(_lazy) { lazyUpdate(c, true); }
+    else { handleClause(c, true); }
+  }
   void onRemovedFromContainer(Clause* c)
-  { handleClause(c, false); }
+  {
+    if(_lazy) { lazyUpdate(c, false); }
+    else { handleClause(c, false); }
+  }
 
   virtual void handleClause(Clause* c, bool adding) {}
 
+  /**
+   * Called before and after a batch of clauses is added by calls to
+   * handleClause. Indexes whose structures can be built from the whole
+   * batch at once can postpone the insertions until the end of it.
+   * No queries nor removals happen in between.
+   */
+  virtual void beginBulkInsertion() {}
+  virtual void endBulkInsertion() {}
+
+  /**
+   * Must be called by the query methods of the indexes that can be
+   * made lazy, before the indexing structure is accessed
+   */
+  void prepareForQuery()
+  {
+    if(_lazy) { lazyQuery(); }
+  }
+
   //TODO: postponing index modifications during iteration (methods isBeingIterated() etc...)
 
 private:
+  struct LazyState;
+
+  void lazyUpdate(Clause* c, bool adding);
+  void lazyQuery();
+  void build();
+  void drop();
+
   SubscriptionData _addedSD;
   SubscriptionData _removedSD;
+
+  /** zero unless the index is lazy */
+  LazyState* _lazy;
 };
 
 
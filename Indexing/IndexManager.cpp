@@ -21,9 +21,11 @@
  * Implements class IndexManager.
  */
 
+#include "Lib/Environment.hpp"
 #include "Lib/Exception.hpp"
 
 #include "Kernel/Grounder.hpp"
+#include "Kernel/LookaheadLiteralSelector.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
@@ -33,6 +35,7 @@
 #include "GroundingIndex.hpp"
 #include "LiteralIndex.hpp"
 #include "LiteralSubstitutionTree.hpp"
+#include "RecordingIndexingStructure.hpp"
 #include "TermIndex.hpp"
 #include "TermSubstitutionTree.hpp"
 
@@ -45,6 +48,9 @@ IndexManager::IndexManager(SaturationAlgorithm* alg) : _alg(alg), _genLitIndex(0
 {
   CALL("IndexManager::IndexManager");
 
+  if(env.options->indexTrace()!="off") {
+    _trace = new IndexTrace(env.options->indexTrace());
+  }
   if(alg) {
     attach(alg);
   }
@@ -142,6 +148,51 @@ void IndexManager::provideIndex(IndexType t, Index* index)
   _store.set(t,e);
 }
 
+/**
+ * Mark the shared terms used by the indexes as live, see
+ * TermSharing::collect. Return false if some of the indexes
+ * does not support this.
+ */
+bool IndexManager::markSharedTerms()
+{
+  CALL("IndexManager::markSharedTerms");
+
+  DHMap<IndexType,Entry>::Iterator it(_store);
+  while (it.hasNext()) {
+    if (!it.next().index->markSharedTerms()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Return true if the index @b index of type @b t can be lazy (see
+ * Index::makeLazy), i.e. it is queried only through the methods of
+ * LiteralIndex or TermIndex and its indexing structure and count
+ * sketch are not used directly
+ */
+bool IndexManager::canBeLazy(IndexType t, Index* index)
+{
+  CALL("IndexManager::canBeLazy");
+
+  switch(t) {
+  case SIMPLIFYING_SUBST_TREE:
+  case SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE:
+  case GENERATING_UNIT_CLAUSE_SUBST_TREE:
+  case GENERATING_NON_UNIT_CLAUSE_SUBST_TREE:
+  case DEMODULATION_SUBTERM_SUBST_TREE:
+  case DEMODULATION_LHS_SUBST_TREE:
+  case FW_SUBSUMPTION_SUBST_TREE:
+    return true;
+  case SUPERPOSITION_SUBTERM_SUBST_TREE:
+  case SUPERPOSITION_LHS_SUBST_TREE:
+    return !static_cast<TermIndex*>(index)->countSketch();
+  default:
+    return false;
+  }
+}
+
 Index* IndexManager::create(IndexType t)
 {
   CALL("IndexManager::create");
@@ -151,67 +202,77 @@ Index* IndexManager::create(IndexType t)
   TermIndexingStructure* tis;
 
   bool isGenerating;
+  bool countSketches = LookaheadLiteralSelector::usesCountSketches(_alg->getOptions());
   static bool useConstraints = env.options->unificationWithAbstraction()!=Options::UnificationWithAbstraction::OFF;
   switch(t) {
   case GENERATING_SUBST_TREE:
-    is=new LiteralSubstitutionTree(useConstraints);
+    is=traced(new LiteralSubstitutionTree(useConstraints), t, useConstraints ? "subst_c" : "subst");
 #if VDEBUG
     //is->markTagged();
 #endif
     _genLitIndex=is;
     res=new GeneratingLiteralIndex(is);
+    if(countSketches) {
+      static_cast<LiteralIndex*>(res)->keepCountSketch();
+    }
     isGenerating = true;
     break;
   case SIMPLIFYING_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree(), t, "subst");
     res=new SimplifyingLiteralIndex(is);
     isGenerating = false;
     break;
 
   case SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree(), t, "subst");
     res=new UnitClauseLiteralIndex(is);
     isGenerating = false;
     break;
   case GENERATING_UNIT_CLAUSE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree(), t, "subst");
     res=new UnitClauseLiteralIndex(is);
     isGenerating = true;
     break;
   case GENERATING_NON_UNIT_CLAUSE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree(), t, "subst");
     res=new NonUnitClauseLiteralIndex(is);
     isGenerating = true;
     break;
 
   case SUPERPOSITION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    tis=traced(new TermSubstitutionTree(useConstraints), t, useConstraints ? "subst_c" : "subst");
 #if VDEBUG
     //tis->markTagged();
 #endif
     res=new SuperpositionSubtermIndex(tis, _alg->getOrdering());
+    if(countSketches) {
+      static_cast<TermIndex*>(res)->keepCountSketch();
+    }
     isGenerating = true;
     break;
   case SUPERPOSITION_LHS_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    tis=traced(new TermSubstitutionTree(useConstraints), t, useConstraints ? "subst_c" : "subst");
     res=new SuperpositionLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
+    if(countSketches) {
+      static_cast<TermIndex*>(res)->keepCountSketch();
+    }
     isGenerating = true;
     break;
 
   case ACYCLICITY_INDEX:
-    tis = new TermSubstitutionTree();
+    tis = traced(new TermSubstitutionTree(), t, "subst");
     res = new AcyclicityIndex(tis);
     isGenerating = true;
     break;
 
   case DEMODULATION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree();
+    tis=traced(new TermSubstitutionTree(), t, "subst");
     res=new DemodulationSubtermIndex(tis);
     isGenerating = false;
     break;
   case DEMODULATION_LHS_SUBST_TREE:
 //    tis=new TermSubstitutionTree();
-    tis=new CodeTreeTIS();
+    tis=traced(new CodeTreeTIS(), t, "code");
     res=new DemodulationLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = false;
     break;
@@ -222,14 +283,14 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case FW_SUBSUMPTION_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree(), t, "subst");
 //    is=new CodeTreeLIS();
     res=new FwSubsSimplifyingLiteralIndex(is);
     isGenerating = false;
     break;
 
   case REWRITE_RULE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=traced(new LiteralSubstitutionTree(), t, "subst");
     res=new RewriteRuleIndex(is, _alg->getOrdering());
     isGenerating = false;
     break;
@@ -247,6 +308,9 @@ Index* IndexManager::create(IndexType t)
   default:
     INVALID_OPERATION("Unsupported IndexType.");
   }
+  if(_alg->getOptions().lazyIndexes() && canBeLazy(t, res)) {
+    res->makeLazy(_alg->getOptions().lazyIndexDrop());
+  }
   if(isGenerating) {
     res->attachContainer(_alg->getGeneratingClauseContainer());
   }
@@ -255,3 +319,29 @@ Index* IndexManager::create(IndexType t)
   }
   return res;
 }
+
+/**
+ * If the index_trace option is set, return a structure that records the
+ * operations on @b is into the trace, otherwise return @b is
+ */
+LiteralIndexingStructure* IndexManager::traced(LiteralIndexingStructure* is, IndexType t,
+    const char* implementation)
+{
+  CALL("IndexManager::traced/lit");
+
+  if(!_trace) {
+    return is;
+  }
+  return new RecordingLiteralIndexingStructure(is, *_trace, t, implementation);
+}
+
+TermIndexingStructure* IndexManager::traced(TermIndexingStructure* is, IndexType t,
+    const char* implementation)
+{
+  CALL("IndexManager::traced/term");
+
+  if(!_trace) {
+    return is;
+  }
+  return new RecordingTermIndexingStructure(is, *_trace, t, implementation);
+}
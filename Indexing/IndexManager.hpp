@@ -27,6 +27,7 @@
 
 #include "Forwards.hpp"
 #include "Lib/DHMap.hpp"
+#include "Lib/ScopedPtr.hpp"
 #include "Index.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -79,6 +80,8 @@ public:
 
   void provideIndex(IndexType t, Index* index);
 
+  bool markSharedTerms();
+
   LiteralIndexingStructure* getGeneratingLiteralIndexingStructure() { ASS(_genLitIndex); return _genLitIndex; };
 private:
 
@@ -93,7 +96,13 @@ private:
 
   LiteralIndexingStructure* _genLitIndex;
 
+  /** non-zero if the index_trace option is set */
+  ScopedPtr<IndexTrace> _trace;
+
   Index* create(IndexType t);
+  bool canBeLazy(IndexType t, Index* index);
+  LiteralIndexingStructure* traced(LiteralIndexingStructure* is, IndexType t, const char* implementation);
+  TermIndexingStructure* traced(TermIndexingStructure* is, IndexType t, const char* implementation);
 };
 
 };
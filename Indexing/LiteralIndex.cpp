@@ -29,6 +29,7 @@
 
 #include "LiteralIndexingStructure.hpp"
 #include "LiteralSubstitutionTree.hpp"
+#include "UnificationCountSketch.hpp"
 
 #include "LiteralIndex.hpp"
 
@@ -40,51 +41,103 @@ using namespace Kernel;
 LiteralIndex::~LiteralIndex()
 {
   delete _is;
+  if(_sketch) {
+    delete _sketch;
+  }
+}
+
+/**
+ * Make the index maintain a unification count sketch of the literals
+ * it contains. Must be called before any literal is inserted.
+ */
+void LiteralIndex::keepCountSketch()
+{
+  CALL("LiteralIndex::keepCountSketch");
+  ASS(!_sketch);
+
+  _sketch = new UnificationCountSketch();
 }
 
 SLQueryResultIterator LiteralIndex::getAll()
 {
+  prepareForQuery();
   return _is->getAll();
 }
 
 SLQueryResultIterator LiteralIndex::getUnifications(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
+  prepareForQuery();
   return _is->getUnifications(lit, complementary, retrieveSubstitutions);
 }
 
 SLQueryResultIterator LiteralIndex::getUnificationsWithConstraints(Literal* lit,
           bool complementary, bool retrieveSubstitutions)
 {
+  prepareForQuery();
   return _is->getUnificationsWithConstraints(lit, complementary, retrieveSubstitutions);
 }
 
 SLQueryResultIterator LiteralIndex::getGeneralizations(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
+  prepareForQuery();
   return _is->getGeneralizations(lit, complementary, retrieveSubstitutions);
 }
 
 SLQueryResultIterator LiteralIndex::getInstances(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
+  prepareForQuery();
   return _is->getInstances(lit, complementary, retrieveSubstitutions);
 }
 
 size_t LiteralIndex::getUnificationCount(Literal* lit, bool complementary)
 {
+  prepareForQuery();
   return _is->getUnificationCount(lit, complementary);
 }
 
+bool LiteralIndex::markSharedTerms()
+{
+  return _is->markSharedTerms();
+}
+
 void LiteralIndex::handleLiteral(Literal* lit, Clause* cl, bool add)
 {
   CALL("LiteralIndex::handleLiteral");
 
   if(add) {
-    _is->insert(lit, cl);
+    if(_bulk) {
+      _bulk->push(LiteralIndexingStructure::Entry(lit, cl));
+    } else {
+      _is->insert(lit, cl);
+    }
   } else {
+    ASS(!_bulk);
     _is->remove(lit, cl);
   }
+  if(_sketch) {
+    _sketch->handle(lit, add);
+  }
+}
+
+void LiteralIndex::beginBulkInsertion()
+{
+  CALL("LiteralIndex::beginBulkInsertion");
+  ASS(!_bulk);
+
+  _bulk = new LiteralIndexingStructure::EntryStack();
+}
+
+void LiteralIndex::endBulkInsertion()
+{
+  CALL("LiteralIndex::endBulkInsertion");
+  ASS(_bulk);
+
+  _is->bulkInsert(*_bulk);
+  delete _bulk;
+  _bulk = 0;
 }
 
 void GeneratingLiteralIndex::handleClause(Clause* c, bool adding)
@@ -171,6 +224,11 @@ RewriteRuleIndex::~RewriteRuleIndex()
   delete _partialIndex;
 }
 
+bool RewriteRuleIndex::markSharedTerms()
+{
+  return _is->markSharedTerms() && _partialIndex->markSharedTerms();
+}
+
 /**
  * For a two-literal clause return its literal that is
  * in some ordering greater, or 0 if the two literals
@@ -28,6 +28,7 @@
 #include "Lib/DHMap.hpp"
 
 #include "Index.hpp"
+#include "LiteralIndexingStructure.hpp"
 
 namespace Indexing {
 
@@ -56,13 +57,24 @@ public:
 
   size_t getUnificationCount(Literal* lit, bool complementary);
 
+  bool markSharedTerms() override;
+
+  /** Return the unification count sketch of the index, or 0 if the index does not keep one */
+  const UnificationCountSketch* countSketch() const { return _sketch; }
+  void keepCountSketch();
 
 protected:
-  LiteralIndex(LiteralIndexingStructure* is) : _is(is) {}
+  LiteralIndex(LiteralIndexingStructure* is) : _is(is), _sketch(0), _bulk(0) {}
 
   void handleLiteral(Literal* lit, Clause* cl, bool add);
 
+  void beginBulkInsertion() override;
+  void endBulkInsertion() override;
+
   LiteralIndexingStructure* _is;
+  UnificationCountSketch* _sketch;
+  /** literals whose insertion into @b _is is postponed till the end of the bulk insertion, zero outside of it */
+  LiteralIndexingStructure::EntryStack* _bulk;
 };
 
 class GeneratingLiteralIndex
@@ -145,6 +157,8 @@ public:
   Clause* getCounterpart(Clause* c) {
     return _counterparts.get(c);
   }
+
+  bool markSharedTerms() override;
 protected:
   void handleClause(Clause* c, bool adding);
   Literal* getGreater(Clause* c);
@@ -26,6 +26,9 @@
 #define __LiteralIndexingStructure__
 
 #include "Forwards.hpp"
+
+#include "Lib/Stack.hpp"
+
 #include "Index.hpp"
 
 namespace Indexing {
@@ -37,6 +40,32 @@ public:
   virtual void insert(Literal* lit, Clause* cls) = 0;
   virtual void remove(Literal* lit, Clause* cls) = 0;
 
+  struct Entry
+  {
+    Entry() {}
+    Entry(Literal* lit, Clause* cls) : literal(lit), clause(cls) {}
+
+    Literal* literal;
+    Clause* clause;
+  };
+  typedef Stack<Entry> EntryStack;
+
+  /**
+   * Insert all the literals of @b entries. Structures that can build
+   * their content from a whole batch faster than literal by literal
+   * override this.
+   */
+  virtual void bulkInsert(const EntryStack& entries)
+  {
+    CALL("LiteralIndexingStructure::bulkInsert");
+
+    EntryStack::ConstIterator eit(entries);
+    while(eit.hasNext()) {
+      const Entry& e=eit.next();
+      insert(e.literal, e.clause);
+    }
+  }
+
   virtual SLQueryResultIterator getAll() { NOT_IMPLEMENTED; }
   virtual SLQueryResultIterator getUnifications(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
@@ -55,6 +84,13 @@ public:
     return countIteratorElements(getUnifications(lit, complementary, false));
   }
 
+  /**
+   * Mark the shared terms stored in the structure as live (see
+   * TermSharing::collect) and return true, or return false if
+   * the structure does not support this.
+   */
+  virtual bool markSharedTerms() { return false; }
+
 #if VDEBUG
   virtual vstring toString() { return "<not supported>"; }
   virtual void markTagged() = 0;
@@ -68,6 +68,30 @@ void LiteralSubstitutionTree::handleLiteral(Literal* lit, Clause* cls, bool inse
   }
 }
 
+/**
+ * Insert the literals of @b entries, empty trees are built
+ * in one pass over the literals with the same top symbol
+ */
+void LiteralSubstitutionTree::bulkInsert(const EntryStack& entries)
+{
+  CALL("LiteralSubstitutionTree::bulkInsert");
+
+  BulkEntryStack batch(entries.size());
+  EntryStack::ConstIterator eit(entries);
+  while(eit.hasNext()) {
+    const Entry& e=eit.next();
+    Literal* normLit=Renaming::normalize(e.literal);
+    BulkEntry* be=new BulkEntry(getRootNodeIndex(normLit), LeafData(e.clause, e.literal));
+    getBindings(normLit, be->bindings);
+    batch.push(be);
+  }
+  SubstitutionTree::bulkInsert(batch);
+
+  while(batch.isNonEmpty()) {
+    delete batch.pop();
+  }
+}
+
 SLQueryResultIterator LiteralSubstitutionTree::getUnifications(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
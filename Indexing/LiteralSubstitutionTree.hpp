@@ -42,6 +42,7 @@ public:
   void insert(Literal* lit, Clause* cls);
   void remove(Literal* lit, Clause* cls);
   void handleLiteral(Literal* lit, Clause* cls, bool insert);
+  void bulkInsert(const EntryStack& entries) override;
 
   SLQueryResultIterator getAll();
 
@@ -60,6 +61,8 @@ public:
   SLQueryResultIterator getVariants(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions);
 
+  bool markSharedTerms() { SubstitutionTree::markSharedTerms(); return true; }
+
 #if VDEBUG
   virtual void markTagged(){ SubstitutionTree::markTagged();}
   vstring toString() {return SubstitutionTree::toString();}
@@ -0,0 +1,311 @@
+/*
+ * File RecordingIndexingStructure.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file RecordingIndexingStructure.cpp
+ * Implements classes IndexTrace, RecordingLiteralIndexingStructure and
+ * RecordingTermIndexingStructure.
+ */
+
+#include "Lib/Exception.hpp"
+#include "Lib/Metaiterators.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Term.hpp"
+
+#include "RecordingIndexingStructure.hpp"
+
+namespace Indexing
+{
+
+///////////////////////
+// IndexTrace
+//
+
+IndexTrace::IndexTrace(vstring fileName)
+: _out(fileName.c_str()), _nextId(0)
+{
+  CALL("IndexTrace::IndexTrace");
+
+  if(!_out) {
+    USER_ERROR("Cannot open index trace file: "+fileName);
+  }
+}
+
+/**
+ * Declare a new indexing structure in the trace and return its id
+ */
+unsigned IndexTrace::declare(unsigned indexType, bool literals, const char* implementation)
+{
+  CALL("IndexTrace::declare");
+
+  unsigned id = _nextId++;
+  _out << "index " << id << ' ' << indexType << ' ' << (literals ? "lit" : "term")
+      << ' ' << implementation << '\n';
+  return id;
+}
+
+void IndexTrace::recordEntry(unsigned id, bool insert, Clause* cls, Literal* lit)
+{
+  CALL("IndexTrace::recordEntry/4");
+
+  _out << id << (insert ? " i " : " r ") << cls->number();
+  writeLiteral(lit);
+  _out << '\n';
+}
+
+void IndexTrace::recordEntry(unsigned id, bool insert, Clause* cls, TermList t, Literal* lit)
+{
+  CALL("IndexTrace::recordEntry/5");
+
+  _out << id << (insert ? " i " : " r ") << cls->number();
+  writeTerm(t);
+  writeLiteral(lit);
+  _out << '\n';
+}
+
+void IndexTrace::recordQuery(unsigned id, char kind, Literal* lit, bool complementary,
+    bool retrieveSubstitutions, size_t resultCnt)
+{
+  CALL("IndexTrace::recordQuery/6");
+
+  _out << id << " q " << kind << ' ' << complementary << ' ' << retrieveSubstitutions
+      << ' ' << resultCnt;
+  writeLiteral(lit);
+  _out << '\n';
+}
+
+void IndexTrace::recordQuery(unsigned id, char kind, TermList t, bool retrieveSubstitutions,
+    size_t resultCnt)
+{
+  CALL("IndexTrace::recordQuery/5");
+
+  _out << id << " q " << kind << " 0 " << retrieveSubstitutions << ' ' << resultCnt;
+  writeTerm(t);
+  _out << '\n';
+}
+
+/**
+ * Write the term @b t in prefix notation, preceded by a space
+ */
+void IndexTrace::writeTerm(TermList t)
+{
+  CALL("IndexTrace::writeTerm");
+
+  if(t.isVar()) {
+    _out << " X" << t.var();
+    return;
+  }
+  ASS(t.isTerm());
+  Term* trm = t.term();
+  _out << " f" << trm->functor() << '/' << trm->arity();
+  for(TermList* arg = trm->args(); arg->isNonEmpty(); arg = arg->next()) {
+    writeTerm(*arg);
+  }
+}
+
+/**
+ * Write the literal @b lit in prefix notation, preceded by a space
+ */
+void IndexTrace::writeLiteral(Literal* lit)
+{
+  CALL("IndexTrace::writeLiteral");
+
+  _out << ' ' << (lit->polarity() ? '+' : '-');
+  if(lit->isEquality()) {
+    _out << 'e' << SortHelper::getEqualityArgumentSort(lit);
+  }
+  else {
+    _out << 'p' << lit->functor() << '/' << lit->arity();
+  }
+  for(TermList* arg = lit->args(); arg->isNonEmpty(); arg = arg->next()) {
+    writeTerm(*arg);
+  }
+}
+
+//////////////////////////////////////
+// RecordingLiteralIndexingStructure
+//
+
+RecordingLiteralIndexingStructure::RecordingLiteralIndexingStructure(LiteralIndexingStructure* inner,
+    IndexTrace& trace, unsigned indexType, const char* implementation)
+: _inner(inner), _trace(trace), _id(trace.declare(indexType, true, implementation))
+{
+}
+
+RecordingLiteralIndexingStructure::~RecordingLiteralIndexingStructure()
+{
+  delete _inner;
+}
+
+void RecordingLiteralIndexingStructure::insert(Literal* lit, Clause* cls)
+{
+  CALL("RecordingLiteralIndexingStructure::insert");
+
+  _trace.recordEntry(_id, true, cls, lit);
+  _inner->insert(lit, cls);
+}
+
+void RecordingLiteralIndexingStructure::remove(Literal* lit, Clause* cls)
+{
+  CALL("RecordingLiteralIndexingStructure::remove");
+
+  _trace.recordEntry(_id, false, cls, lit);
+  _inner->remove(lit, cls);
+}
+
+SLQueryResultIterator RecordingLiteralIndexingStructure::getUnifications(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  CALL("RecordingLiteralIndexingStructure::getUnifications");
+
+  _trace.recordQuery(_id, 'u', lit, complementary, retrieveSubstitutions,
+      countIteratorElements(_inner->getUnifications(lit, complementary, false)));
+  return _inner->getUnifications(lit, complementary, retrieveSubstitutions);
+}
+
+SLQueryResultIterator RecordingLiteralIndexingStructure::getUnificationsWithConstraints(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  CALL("RecordingLiteralIndexingStructure::getUnificationsWithConstraints");
+
+  _trace.recordQuery(_id, 'w', lit, complementary, retrieveSubstitutions,
+      countIteratorElements(_inner->getUnificationsWithConstraints(lit, complementary, false)));
+  return _inner->getUnificationsWithConstraints(lit, complementary, retrieveSubstitutions);
+}
+
+SLQueryResultIterator RecordingLiteralIndexingStructure::getGeneralizations(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  CALL("RecordingLiteralIndexingStructure::getGeneralizations");
+
+  _trace.recordQuery(_id, 'g', lit, complementary, retrieveSubstitutions,
+      countIteratorElements(_inner->getGeneralizations(lit, complementary, false)));
+  return _inner->getGeneralizations(lit, complementary, retrieveSubstitutions);
+}
+
+SLQueryResultIterator RecordingLiteralIndexingStructure::getInstances(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  CALL("RecordingLiteralIndexingStructure::getInstances");
+
+  _trace.recordQuery(_id, 'n', lit, complementary, retrieveSubstitutions,
+      countIteratorElements(_inner->getInstances(lit, complementary, false)));
+  return _inner->getInstances(lit, complementary, retrieveSubstitutions);
+}
+
+SLQueryResultIterator RecordingLiteralIndexingStructure::getVariants(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  CALL("RecordingLiteralIndexingStructure::getVariants");
+
+  _trace.recordQuery(_id, 'v', lit, complementary, retrieveSubstitutions,
+      countIteratorElements(_inner->getVariants(lit, complementary, false)));
+  return _inner->getVariants(lit, complementary, retrieveSubstitutions);
+}
+
+size_t RecordingLiteralIndexingStructure::getUnificationCount(Literal* lit, bool complementary)
+{
+  CALL("RecordingLiteralIndexingStructure::getUnificationCount");
+
+  size_t res = _inner->getUnificationCount(lit, complementary);
+  _trace.recordQuery(_id, 'u', lit, complementary, false, res);
+  return res;
+}
+
+//////////////////////////////////////
+// RecordingTermIndexingStructure
+//
+
+RecordingTermIndexingStructure::RecordingTermIndexingStructure(TermIndexingStructure* inner,
+    IndexTrace& trace, unsigned indexType, const char* implementation)
+: _inner(inner), _trace(trace), _id(trace.declare(indexType, false, implementation))
+{
+}
+
+RecordingTermIndexingStructure::~RecordingTermIndexingStructure()
+{
+  delete _inner;
+}
+
+void RecordingTermIndexingStructure::insert(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("RecordingTermIndexingStructure::insert");
+
+  _trace.recordEntry(_id, true, cls, t, lit);
+  _inner->insert(t, lit, cls);
+}
+
+void RecordingTermIndexingStructure::remove(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("RecordingTermIndexingStructure::remove");
+
+  _trace.recordEntry(_id, false, cls, t, lit);
+  _inner->remove(t, lit, cls);
+}
+
+TermQueryResultIterator RecordingTermIndexingStructure::getUnifications(TermList t,
+    bool retrieveSubstitutions)
+{
+  CALL("RecordingTermIndexingStructure::getUnifications");
+
+  _trace.recordQuery(_id, 'u', t, retrieveSubstitutions,
+      countIteratorElements(_inner->getUnifications(t, false)));
+  return _inner->getUnifications(t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator RecordingTermIndexingStructure::getUnificationsWithConstraints(TermList t,
+    bool retrieveSubstitutions)
+{
+  CALL("RecordingTermIndexingStructure::getUnificationsWithConstraints");
+
+  _trace.recordQuery(_id, 'w', t, retrieveSubstitutions,
+      countIteratorElements(_inner->getUnificationsWithConstraints(t, false)));
+  return _inner->getUnificationsWithConstraints(t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator RecordingTermIndexingStructure::getGeneralizations(TermList t,
+    bool retrieveSubstitutions)
+{
+  CALL("RecordingTermIndexingStructure::getGeneralizations");
+
+  _trace.recordQuery(_id, 'g', t, retrieveSubstitutions,
+      countIteratorElements(_inner->getGeneralizations(t, false)));
+  return _inner->getGeneralizations(t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator RecordingTermIndexingStructure::getInstances(TermList t,
+    bool retrieveSubstitutions)
+{
+  CALL("RecordingTermIndexingStructure::getInstances");
+
+  _trace.recordQuery(_id, 'n', t, retrieveSubstitutions,
+      countIteratorElements(_inner->getInstances(t, false)));
+  return _inner->getInstances(t, retrieveSubstitutions);
+}
+
+bool RecordingTermIndexingStructure::generalizationExists(TermList t)
+{
+  CALL("RecordingTermIndexingStructure::generalizationExists");
+
+  bool res = _inner->generalizationExists(t);
+  _trace.recordQuery(_id, 'e', t, false, res);
+  return res;
+}
+
+}
@@ -0,0 +1,180 @@
+/*
+ * File RecordingIndexingStructure.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file RecordingIndexingStructure.hpp
+ * Defines classes IndexTrace, RecordingLiteralIndexingStructure and
+ * RecordingTermIndexingStructure.
+ */
+
+#ifndef __RecordingIndexingStructure__
+#define __RecordingIndexingStructure__
+
+#include <fstream>
+
+#include "Forwards.hpp"
+
+#include "Lib/VString.hpp"
+
+#include "LiteralIndexingStructure.hpp"
+#include "TermIndexingStructure.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Trace of the operations performed on indexing structures, written to
+ * the file given by the index_trace option and replayed by the
+ * "ir" module of vutil.
+ *
+ * The trace has one operation per line:
+ *   index <id> <index type> <lit|term> <implementation>
+ *   <id> i <clause number> <entry>
+ *   <id> r <clause number> <entry>
+ *   <id> q <query kind> <complementary> <substitutions> <result count> <query>
+ * where an entry of a literal structure is a literal, and an entry of
+ * a term structure is a term followed by its literal. The id is unique
+ * for each created structure. Query kinds are u (unifications),
+ * w (unifications with constraints), g (generalizations), n (instances),
+ * v (variants) and e (existence of a generalization).
+ *
+ * Terms are written in prefix notation with the arity after the symbol:
+ * X<n> is a variable, f<n>/<arity> the function number n, literals are
+ * +p<n>/<arity> or -p<n>/<arity>, and equalities +e<sort> or -e<sort>.
+ * Symbol names are not kept, the replay creates fresh symbols.
+ */
+class IndexTrace
+{
+public:
+  CLASS_NAME(IndexTrace);
+  USE_ALLOCATOR(IndexTrace);
+
+  IndexTrace(vstring fileName);
+
+  unsigned declare(unsigned indexType, bool literals, const char* implementation);
+
+  void recordEntry(unsigned id, bool insert, Clause* cls, Literal* lit);
+  void recordEntry(unsigned id, bool insert, Clause* cls, TermList t, Literal* lit);
+  void recordQuery(unsigned id, char kind, Literal* lit, bool complementary,
+      bool retrieveSubstitutions, size_t resultCnt);
+  void recordQuery(unsigned id, char kind, TermList t, bool retrieveSubstitutions, size_t resultCnt);
+
+private:
+  void writeTerm(TermList t);
+  void writeLiteral(Literal* lit);
+
+  std::ofstream _out;
+  unsigned _nextId;
+};
+
+/**
+ * Literal indexing structure that records the operations performed
+ * on the inner structure into an IndexTrace.
+ *
+ * The result counts of the queries are obtained by running each query
+ * once more without retrieving substitutions.
+ */
+class RecordingLiteralIndexingStructure
+: public LiteralIndexingStructure
+{
+public:
+  CLASS_NAME(RecordingLiteralIndexingStructure);
+  USE_ALLOCATOR(RecordingLiteralIndexingStructure);
+
+  RecordingLiteralIndexingStructure(LiteralIndexingStructure* inner, IndexTrace& trace,
+      unsigned indexType, const char* implementation);
+  ~RecordingLiteralIndexingStructure();
+
+  void insert(Literal* lit, Clause* cls);
+  void remove(Literal* lit, Clause* cls);
+
+  SLQueryResultIterator getAll() { return _inner->getAll(); }
+  SLQueryResultIterator getUnifications(Literal* lit,
+	  bool complementary, bool retrieveSubstitutions = true);
+  SLQueryResultIterator getUnificationsWithConstraints(Literal* lit,
+          bool complementary, bool retrieveSubstitutions = true);
+  SLQueryResultIterator getGeneralizations(Literal* lit,
+	  bool complementary, bool retrieveSubstitutions = true);
+  SLQueryResultIterator getInstances(Literal* lit,
+	  bool complementary, bool retrieveSubstitutions = true);
+  SLQueryResultIterator getVariants(Literal* lit,
+	  bool complementary, bool retrieveSubstitutions = true);
+
+  size_t getUnificationCount(Literal* lit, bool complementary);
+
+  bool markSharedTerms() { return _inner->markSharedTerms(); }
+
+#if VDEBUG
+  vstring toString() { return _inner->toString(); }
+  void markTagged() { _inner->markTagged(); }
+#endif
+
+private:
+  LiteralIndexingStructure* _inner;
+  IndexTrace& _trace;
+  unsigned _id;
+};
+
+/**
+ * Term indexing structure that records the operations performed
+ * on the inner structure into an IndexTrace.
+ *
+ * The result counts of the queries are obtained by running each query
+ * once more without retrieving substitutions.
+ */
+class RecordingTermIndexingStructure
+: public TermIndexingStructure
+{
+public:
+  CLASS_NAME(RecordingTermIndexingStructure);
+  USE_ALLOCATOR(RecordingTermIndexingStructure);
+
+  RecordingTermIndexingStructure(TermIndexingStructure* inner, IndexTrace& trace,
+      unsigned indexType, const char* implementation);
+  ~RecordingTermIndexingStructure();
+
+  void insert(TermList t, Literal* lit, Clause* cls);
+  void remove(TermList t, Literal* lit, Clause* cls);
+
+  TermQueryResultIterator getUnifications(TermList t,
+	  bool retrieveSubstitutions = true);
+  TermQueryResultIterator getUnificationsWithConstraints(TermList t,
+          bool retrieveSubstitutions = true);
+  TermQueryResultIterator getGeneralizations(TermList t,
+	  bool retrieveSubstitutions = true);
+  TermQueryResultIterator getInstances(TermList t,
+	  bool retrieveSubstitutions = true);
+
+  bool generalizationExists(TermList t);
+
+  bool markSharedTerms() { return _inner->markSharedTerms(); }
+
+#if VDEBUG
+  void markTagged() { _inner->markTagged(); }
+#endif
+
+private:
+  TermIndexingStructure* _inner;
+  IndexTrace& _trace;
+  unsigned _id;
+};
+
+};
+
+#endif /* __RecordingIndexingStructure__ */
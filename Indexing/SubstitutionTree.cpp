@@ -23,6 +23,7 @@
  * @since 16/08/2008 flight Sydney-San Francisco
  */
 
+#include <algorithm>
 #include <utility>
 
 #include "Shell/Options.hpp"
@@ -87,6 +88,61 @@ SubstitutionTree::~SubstitutionTree()
   }
 } // SubstitutionTree::~SubstitutionTree
 
+/**
+ * Mark the shared terms used by the tree as live, see TermSharing::collect.
+ *
+ * Besides the terms in the leaves, the terms at the inner nodes must be
+ * marked too, as a node can keep a term of an entry that was removed.
+ */
+void SubstitutionTree::markSharedTerms()
+{
+  CALL("SubstitutionTree::markSharedTerms");
+
+  static Stack<Node*> toDo;
+  ASS(toDo.isEmpty());
+
+  for (unsigned i = 0; i<_nodes.size(); i++) {
+    if(_nodes[i]!=0) {
+      toDo.push(_nodes[i]);
+    }
+  }
+  while (toDo.isNonEmpty()) {
+    Node* n = toDo.pop();
+    env.sharing->markLive(n->term);
+    if (n->isLeaf()) {
+      LDIterator ldit = static_cast<Leaf*>(n)->allChildren();
+      while (ldit.hasNext()) {
+        markSharedTerms(ldit.next());
+      }
+      continue;
+    }
+    IntermediateNode* inode = static_cast<IntermediateNode*>(n);
+    if (inode->_childBySortHelper) {
+      DArray<Stack<TermList> >& bySortTerms = inode->_childBySortHelper->bySortTerms;
+      for (unsigned srt = 0; srt < bySortTerms.size(); srt++) {
+        Stack<TermList>::Iterator tit(bySortTerms[srt]);
+        while (tit.hasNext()) {
+          env.sharing->markLive(tit.next());
+        }
+      }
+    }
+    NodeIterator nit = inode->allChildren();
+    while (nit.hasNext()) {
+      toDo.push(*nit.next());
+    }
+  }
+} // SubstitutionTree::markSharedTerms
+
+void SubstitutionTree::markSharedTerms(const LeafData& ld)
+{
+  CALL("SubstitutionTree::markSharedTerms(const LeafData&)");
+
+  if (ld.literal) {
+    env.sharing->markLive(ld.literal);
+  }
+  env.sharing->markLive(ld.term);
+}
+
 /**
  * Store initial bindings of term @b t into @b bq.
  *
@@ -456,6 +512,206 @@ void SubstitutionTree::remove(Node** pnode,BindingMap& svBindings,LeafData ld)
   }
 } // SubstitutionTree::remove
 
+/**
+ * Orders bulk entries by the index of their root node
+ */
+struct BulkEntryRootLess
+{
+  bool operator()(SubstitutionTree::BulkEntry* e1, SubstitutionTree::BulkEntry* e2) const
+  { return e1->rootIndex < e2->rootIndex; }
+};
+
+/**
+ * Insert a batch of entries into the substitution tree.
+ *
+ * The bindings of each entry contain the arguments of its
+ * term/literal as for insert. The order of the entries in
+ * @b entries is changed.
+ */
+void SubstitutionTree::bulkInsert(BulkEntryStack& entries)
+{
+  CALL("SubstitutionTree::bulkInsert/1");
+
+  {
+    BYPASSING_ALLOCATOR; // stable_sort allocates its buffer by the global new
+    std::stable_sort(entries.begin(), entries.end(), BulkEntryRootLess());
+  }
+
+  unsigned cnt=entries.size();
+  unsigned start=0;
+  while(start<cnt) {
+    unsigned rootIndex=entries[start]->rootIndex;
+    unsigned end=start+1;
+    while(end<cnt && entries[end]->rootIndex==rootIndex) {
+      end++;
+    }
+    bulkInsert(&_nodes[rootIndex], entries.begin()+start, end-start);
+    start=end;
+  }
+}
+
+/**
+ * Insert @b cnt entries starting at @b entries into the tree
+ * with root @b pnode.
+ *
+ * If the tree is empty, it is built in one pass over the entries,
+ * otherwise the entries are inserted one by one, as each insertion
+ * can restructure the nodes on its path.
+ */
+void SubstitutionTree::bulkInsert(Node** pnode,BulkEntry** entries,unsigned cnt)
+{
+  CALL("SubstitutionTree::bulkInsert/3");
+  ASS_EQ(_iteratorCnt,0);
+  ASS_G(cnt,0);
+
+  if(*pnode) {
+    for(unsigned i=0; i<cnt; i++) {
+      insert(pnode, entries[i]->bindings, entries[i]->ld);
+    }
+    return;
+  }
+
+  // getBindings binds the arguments to the special variables 0,...,arity-1
+  VarStack pendingVars;
+  unsigned arity=entries[0]->bindings.size();
+  for(unsigned var=0; var<arity; var++) {
+    ASS(entries[0]->bindings.find(var));
+    pendingVars.push(var);
+  }
+  TermList root;
+  root.makeEmpty();
+  buildSubtree(pnode, root, entries, cnt, pendingVars);
+}
+
+/**
+ * Orders bulk entries by the top symbol of their binding for a special variable
+ */
+struct BulkEntryTopLess
+{
+  BulkEntryTopLess(unsigned var) : var(var) {}
+
+  static unsigned long long key(TermList t)
+  {
+    if(t.isVar()) {
+      return t.var();
+    }
+    return (1ull<<32) + t.term()->functor();
+  }
+
+  bool operator()(SubstitutionTree::BulkEntry* e1, SubstitutionTree::BulkEntry* e2) const
+  { return key(e1->bindings.get(var)) < key(e2->bindings.get(var)); }
+
+  unsigned var;
+};
+
+/**
+ * Build into the empty position @b pnode a node with term @b term
+ * and below it a subtree containing @b cnt entries starting at @b entries.
+ *
+ * The entries must bind exactly the special variables in @b pendingVars.
+ * The node binds the last of them, and the entries are grouped by the top
+ * symbol of their binding of that variable, each group giving one child.
+ */
+void SubstitutionTree::buildSubtree(Node** pnode,TermList term,BulkEntry** entries,unsigned cnt,
+    VarStack& pendingVars)
+{
+  CALL("SubstitutionTree::buildSubtree");
+  ASS(!*pnode);
+  ASS_G(cnt,0);
+
+  if(pendingVars.isEmpty()) {
+    Leaf* leaf=createLeaf(term);
+    *pnode=leaf;
+    for(unsigned i=0; i<cnt; i++) {
+      ASS(entries[i]->bindings.isEmpty());
+      leaf->insert(entries[i]->ld);
+    }
+    ensureLeafEfficiency(reinterpret_cast<Leaf**>(pnode));
+    return;
+  }
+
+  unsigned var=pendingVars.pop();
+  *pnode=createIntermediateNode(term, var, _useC);
+
+  {
+    BYPASSING_ALLOCATOR; // stable_sort allocates its buffer by the global new
+    std::stable_sort(entries, entries+cnt, BulkEntryTopLess(var));
+  }
+
+  Stack<TermList> terms(cnt);
+  unsigned groupStart=0;
+  while(groupStart<cnt) {
+    TermList top=entries[groupStart]->bindings.get(var);
+    unsigned groupEnd=groupStart+1;
+    while(groupEnd<cnt && TermList::sameTop(top, entries[groupEnd]->bindings.get(var))) {
+      groupEnd++;
+    }
+
+    terms.reset();
+    for(unsigned i=groupStart; i<groupEnd; i++) {
+      terms.push(entries[i]->bindings.get(var));
+      entries[i]->bindings.remove(var);
+    }
+    VarStack childVars(pendingVars);
+    TermList childTerm=generalize(entries+groupStart, groupEnd-groupStart, terms.begin(), childVars);
+
+    IntermediateNode* inode=static_cast<IntermediateNode*>(*pnode);
+    Node** child=inode->childByTop(childTerm, true);
+    buildSubtree(child, childTerm, entries+groupStart, groupEnd-groupStart, childVars);
+    ensureIntermediateNodeEfficiency(reinterpret_cast<IntermediateNode**>(pnode));
+
+    groupStart=groupEnd;
+  }
+}
+
+/**
+ * Return the common generalization of the @b cnt terms starting at @b terms,
+ * which belong to the entries starting at @b entries.
+ *
+ * Where the terms differ in their top symbols, the generalization contains
+ * a new special variable, which is bound to the corresponding subterm in each
+ * entry and pushed on @b pendingVars. Terms containing special variables are
+ * not shared.
+ */
+TermList SubstitutionTree::generalize(BulkEntry** entries,unsigned cnt,TermList* terms,
+    VarStack& pendingVars)
+{
+  CALL("SubstitutionTree::generalize");
+
+  bool same=true;
+  bool sameTop=true;
+  for(unsigned i=1; i<cnt && sameTop; i++) {
+    same&=terms[i]==terms[0];
+    sameTop&=TermList::sameTop(terms[i], terms[0]);
+  }
+  if(same && sameTop) {
+    return terms[0];
+  }
+  if(!sameTop) {
+    unsigned var=_nextVar++;
+    for(unsigned i=0; i<cnt; i++) {
+      entries[i]->bindings.insert(var, terms[i]);
+    }
+    pendingVars.push(var);
+    TermList res;
+    res.makeSpecialVar(var);
+    return res;
+  }
+
+  ASS(terms[0].isTerm());
+  Term* res=Term::cloneNonShared(terms[0].term());
+  Stack<TermList> args(cnt);
+  unsigned arity=res->arity();
+  for(unsigned j=0; j<arity; j++) {
+    args.reset();
+    for(unsigned i=0; i<cnt; i++) {
+      args.push(*terms[i].term()->nthArgument(j));
+    }
+    *res->nthArgument(j)=generalize(entries, cnt, args.begin(), pendingVars);
+  }
+  return TermList(res);
+}
+
 /**
  * Return a pointer to the leaf that contains term specified by @b svBindings.
  * If no such leaf exists, return 0.
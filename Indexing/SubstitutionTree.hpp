@@ -116,6 +116,9 @@ public:
   };
   typedef VirtualIterator<LeafData&> LDIterator;
 
+  void markSharedTerms();
+  static void markSharedTerms(const LeafData& ld);
+
   class LDComparator
   {
   public:
@@ -653,6 +656,26 @@ public:
   void insert(Node** node,BindingMap& binding,LeafData ld);
   void remove(Node** node,BindingMap& binding,LeafData ld);
 
+  /** An entry of a batch inserted by bulkInsert */
+  struct BulkEntry
+  {
+    CLASS_NAME(SubstitutionTree::BulkEntry);
+    USE_ALLOCATOR(BulkEntry);
+
+    BulkEntry(unsigned rootIndex, LeafData ld) : rootIndex(rootIndex), ld(ld) {}
+
+    /** index of the root node in @b _nodes */
+    unsigned rootIndex;
+    LeafData ld;
+    BindingMap bindings;
+  };
+  typedef Stack<BulkEntry*> BulkEntryStack;
+
+  void bulkInsert(BulkEntryStack& entries);
+  void bulkInsert(Node** node,BulkEntry** entries,unsigned cnt);
+  void buildSubtree(Node** node,TermList term,BulkEntry** entries,unsigned cnt,VarStack& pendingVars);
+  TermList generalize(BulkEntry** entries,unsigned cnt,TermList* terms,VarStack& pendingVars);
+
   /** Number of the next variable */
   int _nextVar;
   /** Array of nodes */
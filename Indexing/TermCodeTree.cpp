@@ -25,6 +25,7 @@
  
 #include "Lib/BitUtils.hpp"
 #include "Lib/Comparison.hpp"
+#include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Sort.hpp"
 #include "Lib/TimeCounter.hpp"
@@ -34,6 +35,7 @@
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
 
+#include "TermSharing.hpp"
 #include "TermCodeTree.hpp"
 
 namespace Indexing
@@ -51,6 +53,17 @@ void TermCodeTree::onCodeOpDestroying(CodeOp* op)
   }
 }
 
+void TermCodeTree::markTermInfo(void* result)
+{
+  CALL("TermCodeTree::markTermInfo");
+
+  TermInfo* ti = static_cast<TermInfo*>(result);
+  env.sharing->markLive(ti->t);
+  if (ti->lit) {
+    env.sharing->markLive(ti->lit);
+  }
+}
+
 TermCodeTree::TermCodeTree()
 {
   _clauseCodeTree=false;
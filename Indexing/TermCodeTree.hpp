@@ -50,6 +50,7 @@ class TermCodeTree : public CodeTree
 {
 protected:
   static void onCodeOpDestroying(CodeOp* op);
+  static void markTermInfo(void* result);
   
 public:
   TermCodeTree();
@@ -76,6 +77,8 @@ public:
 
   void insert(TermInfo* ti);
   void remove(const TermInfo& ti);
+
+  void markSharedTerms() { CodeTree::markSharedTerms(markTermInfo); }
   
 private:
   struct RemovingTermMatcher
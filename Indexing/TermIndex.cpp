@@ -31,6 +31,7 @@
 
 #include "TermIndexingStructure.hpp"
 #include "TermIndex.hpp"
+#include "UnificationCountSketch.hpp"
 
 using namespace Lib;
 using namespace Kernel;
@@ -40,29 +41,92 @@ using namespace Indexing;
 TermIndex::~TermIndex()
 {
   delete _is;
+  if(_sketch) {
+    delete _sketch;
+  }
+}
+
+/**
+ * Make the index maintain a unification count sketch of the terms
+ * it contains. Must be called before any term is inserted.
+ */
+void TermIndex::keepCountSketch()
+{
+  CALL("TermIndex::keepCountSketch");
+  ASS(!_sketch);
+
+  _sketch = new UnificationCountSketch();
+}
+
+bool TermIndex::markSharedTerms()
+{
+  return _is->markSharedTerms();
+}
+
+void TermIndex::handleTerm(TermList t, Literal* lit, Clause* c, bool adding)
+{
+  CALL("TermIndex::handleTerm");
+
+  if (adding) {
+    if (_bulk) {
+      _bulk->push(TermIndexingStructure::Entry(t, lit, c));
+    }
+    else {
+      _is->insert(t, lit, c);
+    }
+  }
+  else {
+    ASS(!_bulk);
+    _is->remove(t, lit, c);
+  }
+  if (_sketch) {
+    _sketch->handle(t, adding);
+  }
+}
+
+void TermIndex::beginBulkInsertion()
+{
+  CALL("TermIndex::beginBulkInsertion");
+  ASS(!_bulk);
+
+  _bulk = new TermIndexingStructure::EntryStack();
+}
+
+void TermIndex::endBulkInsertion()
+{
+  CALL("TermIndex::endBulkInsertion");
+  ASS(_bulk);
+
+  _is->bulkInsert(*_bulk);
+  delete _bulk;
+  _bulk = 0;
 }
 
 TermQueryResultIterator TermIndex::getUnifications(TermList t,
 	  bool retrieveSubstitutions)
 {
+  prepareForQuery();
   return _is->getUnifications(t, retrieveSubstitutions);
 }
 
 TermQueryResultIterator TermIndex::getUnificationsWithConstraints(TermList t,
           bool retrieveSubstitutions)
 {
+  prepareForQuery();
   return _is->getUnificationsWithConstraints(t, retrieveSubstitutions);
 }
 
 TermQueryResultIterator TermIndex::getGeneralizations(TermList t,
 	  bool retrieveSubstitutions)
 {
+  prepareForQuery();
   return _is->getGeneralizations(t, retrieveSubstitutions);
 }
 
 TermQueryResultIterator TermIndex::getInstances(TermList t,
 	  bool retrieveSubstitutions)
 {
+  prepareForQuery();
   return _is->getInstances(t, retrieveSubstitutions);
 }
 
@@ -78,12 +142,7 @@ void SuperpositionSubtermIndex::handleClause(Clause* c, bool adding)
     Literal* lit=(*c)[i];
     TermIterator rsti=EqHelper::getRewritableSubtermIterator(lit,_ord);
     while (rsti.hasNext()) {
-      if (adding) {
-	_is->insert(rsti.next(), lit, c);
-      }
-      else {
-	_is->remove(rsti.next(), lit, c);
-      }
+      handleTerm(rsti.next(), lit, c, adding);
     }
   }
 }
@@ -99,13 +158,7 @@ void SuperpositionLHSIndex::handleClause(Clause* c, bool adding)
     Literal* lit=(*c)[i];
     TermIterator lhsi=EqHelper::getSuperpositionLHSIterator(lit, _ord, _opt);
     while (lhsi.hasNext()) {
-      TermList lhs=lhsi.next();
-      if (adding) {
-	_is->insert(lhs, lit, c);
-      }
-      else {
-	_is->remove(lhs, lit, c);
-      }
+      handleTerm(lhsi.next(), lit, c, adding);
     }
   }
 }
@@ -132,12 +185,7 @@ void DemodulationSubtermIndex::handleClause(Clause* c, bool adding)
 	nvi.right();
 	continue;
       }
-      if (adding) {
-	_is->insert(t, lit, c);
-      }
-      else {
-	_is->remove(t, lit, c);
-      }
+      handleTerm(t, lit, c, adding);
     }
   }
 }
@@ -156,11 +204,6 @@ void DemodulationLHSIndex::handleClause(Clause* c, bool adding)
   Literal* lit=(*c)[0];
   TermIterator lhsi=EqHelper::getDemodulationLHSIterator(lit, true, _ord, _opt);
   while (lhsi.hasNext()) {
-    if (adding) {
-      _is->insert(lhsi.next(), lit, c);
-    }
-    else {
-      _is->remove(lhsi.next(), lit, c);
-    }
+    handleTerm(lhsi.next(), lit, c, adding);
   }
 }
@@ -26,6 +26,7 @@
 #define __TermIndex__
 
 #include "Index.hpp"
+#include "TermIndexingStructure.hpp"
 
 namespace Indexing {
 
@@ -47,10 +48,24 @@ public:
   TermQueryResultIterator getInstances(TermList t,
 	  bool retrieveSubstitutions = true);
 
+  bool markSharedTerms() override;
+
+  /** Return the unification count sketch of the index, or 0 if the index does not keep one */
+  const UnificationCountSketch* countSketch() const { return _sketch; }
+  void keepCountSketch();
+
 protected:
-  TermIndex(TermIndexingStructure* is) : _is(is) {}
+  TermIndex(TermIndexingStructure* is) : _is(is), _sketch(0), _bulk(0) {}
+
+  void handleTerm(TermList t, Literal* lit, Clause* c, bool adding);
+
+  void beginBulkInsertion() override;
+  void endBulkInsertion() override;
 
   TermIndexingStructure* _is;
+  UnificationCountSketch* _sketch;
+  /** terms whose insertion into @b _is is postponed till the end of the bulk insertion, zero outside of it */
+  TermIndexingStructure::EntryStack* _bulk;
 };
 
 class SuperpositionSubtermIndex
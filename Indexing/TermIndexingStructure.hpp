@@ -25,6 +25,8 @@
 #ifndef __TermIndexingStructure__
 #define __TermIndexingStructure__
 
+#include "Lib/Stack.hpp"
+
 #include "Index.hpp"
 
 namespace Indexing {
@@ -36,6 +38,33 @@ public:
   virtual void insert(TermList t, Literal* lit, Clause* cls) = 0;
   virtual void remove(TermList t, Literal* lit, Clause* cls) = 0;
 
+  struct Entry
+  {
+    Entry() {}
+    Entry(TermList t, Literal* lit, Clause* cls) : term(t), literal(lit), clause(cls) {}
+
+    TermList term;
+    Literal* literal;
+    Clause* clause;
+  };
+  typedef Stack<Entry> EntryStack;
+
+  /**
+   * Insert all the terms of @b entries. Structures that can build
+   * their content from a whole batch faster than term by term
+   * override this.
+   */
+  virtual void bulkInsert(const EntryStack& entries)
+  {
+    CALL("TermIndexingStructure::bulkInsert");
+
+    EntryStack::ConstIterator eit(entries);
+    while(eit.hasNext()) {
+      const Entry& e=eit.next();
+      insert(e.term, e.literal, e.clause);
+    }
+  }
+
   virtual TermQueryResultIterator getUnifications(TermList t,
 	  bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
   virtual TermQueryResultIterator getUnificationsWithConstraints(TermList t,
@@ -47,6 +76,13 @@ public:
 
   virtual bool generalizationExists(TermList t) { NOT_IMPLEMENTED; }
 
+  /**
+   * Mark the shared terms stored in the structure as live (see
+   * TermSharing::collect) and return true, or return false if
+   * the structure does not support this.
+   */
+  virtual bool markSharedTerms() { return false; }
+
 #if VDEBUG
   virtual void markTagged() = 0;
 #endif
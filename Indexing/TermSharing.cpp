@@ -23,14 +23,20 @@
  * @since 28/12/2007 Manchester
  */
 
+#include <climits>
+
 #include "Forwards.hpp"
 
 #include "Lib/Environment.hpp"
+#include "Lib/Stack.hpp"
+#include "Kernel/Formula.hpp"
 #include "Kernel/Signature.hpp"
 #include "Kernel/SortHelper.hpp"
 #include "Kernel/Sorts.hpp"
+#include "Kernel/SubformulaIterator.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
+#include "Shell/Statistics.hpp"
 #include "TermSharing.hpp"
 
 using namespace Kernel;
@@ -46,7 +52,8 @@ TermSharing::TermSharing()
     _totalLiterals(0),
     // _groundLiterals(0), //MS: unused
     _literalInsertions(0),
-    _termInsertions(0)
+    _termInsertions(0),
+    _nextCollection(UINT_MAX)
 {
   CALL("TermSharing::TermSharing");
 }
@@ -305,6 +312,188 @@ Term* TermSharing::insertRecurrently(Term* t)
   return tRef.term();
 }
 
+/**
+ * The minimal number of terms and literals that must be added to the
+ * sharing structure between two collections
+ */
+static const unsigned MIN_COLLECTION_GROWTH = 100000;
+
+/**
+ * Make all terms and literals currently stored persistent, i.e. never
+ * reclaimed by @c collect(), and enable the collection.
+ *
+ * Called at the start of saturation, so that the terms referenced from
+ * the preprocessing structures (the problem, the signature, the
+ * inferences of input units) need not be enumerated by the roots.
+ */
+void TermSharing::makePersistent()
+{
+  CALL("TermSharing::makePersistent");
+
+  Set<Term*,TermSharing>::Iterator ts(_terms);
+  while (ts.hasNext()) {
+    ts.next()->_args[0]._info.persistent = 1u;
+  }
+  Set<Literal*,TermSharing>::Iterator ls(_literals);
+  while (ls.hasNext()) {
+    ls.next()->_args[0]._info.persistent = 1u;
+  }
+  unsigned live = _totalTerms+_totalLiterals;
+  _nextCollection = live + max(live, MIN_COLLECTION_GROWTH);
+}
+
+/**
+ * Make the shared term @b t persistent. Used for terms cached
+ * outside of any clause, such as the FOOL constants.
+ */
+void TermSharing::makePersistent(Term* t)
+{
+  CALL("TermSharing::makePersistent(Term*)");
+  ASS(t->shared());
+
+  t->_args[0]._info.persistent = 1u;
+}
+
+/**
+ * Mark term (or literal) @b t and all its shared subterms as being in use,
+ * so that they survive the next call to @c collect().
+ *
+ * Non-shared terms (e.g. those kept in the substitution tree nodes) are
+ * traversed as well, as they may point to shared subterms.
+ */
+void TermSharing::markLive(Term* t)
+{
+  CALL("TermSharing::markLive");
+
+  static Stack<Term*> toDo;
+  ASS(toDo.isEmpty());
+
+  toDo.push(t);
+  while (toDo.isNonEmpty()) {
+    Term* s = toDo.pop();
+    if (s->shared()) {
+      auto& info = s->_args[0]._info;
+      if (info.gcMark || info.persistent) {
+        continue;
+      }
+      info.gcMark = 1u;
+    }
+    for (TermList* ts = s->args(); ! ts->isEmpty(); ts = ts->next()) {
+      if (ts->isTerm()) {
+        toDo.push(ts->term());
+      }
+    }
+  }
+}
+
+/**
+ * Mark the atoms of formula @b f as being in use.
+ */
+void TermSharing::markLive(Formula* f)
+{
+  CALL("TermSharing::markLive(Formula*)");
+
+  SubformulaIterator sfit(f);
+  while (sfit.hasNext()) {
+    Formula* sf = sfit.next();
+    if (sf->connective()==LITERAL) {
+      markLive(sf->literal());
+    }
+    else if (sf->connective()==BOOL_TERM) {
+      markLive(sf->getBooleanTerm());
+    }
+  }
+}
+
+/**
+ * Destroy all shared terms and literals that are neither persistent nor
+ * were marked by @c markLive() since the last collection, and clear the
+ * marks of the surviving ones.
+ *
+ * All structures that may refer to a shared term must have marked the
+ * terms they use before this function is called.
+ */
+void TermSharing::collect()
+{
+  CALL("TermSharing::collect");
+
+  TimeCounter tc(TC_TERM_SHARING);
+
+  static Stack<Term*> dead;
+  ASS(dead.isEmpty());
+
+  Set<Term*,TermSharing>::Iterator ts(_terms);
+  while (ts.hasNext()) {
+    Term* t = ts.next();
+    auto& info = t->_args[0]._info;
+    if (info.gcMark) {
+      info.gcMark = 0u;
+    }
+    else if (!info.persistent) {
+      dead.push(t);
+    }
+  }
+  unsigned deadTerms = dead.size();
+  Set<Literal*,TermSharing>::Iterator ls(_literals);
+  while (ls.hasNext()) {
+    Literal* l = ls.next();
+    auto& info = l->_args[0]._info;
+    if (info.gcMark) {
+      info.gcMark = 0u;
+    }
+    else if (!info.persistent) {
+      dead.push(l);
+    }
+  }
+  unsigned deadLiterals = dead.size()-deadTerms;
+
+  // the hash of a term only depends on the pointers to its arguments,
+  // so the terms can be removed from the sets in any order, but they can
+  // only be destroyed once none of them is in the sets any more
+  for (unsigned i = 0; i < dead.size(); i++) {
+    if (i < deadTerms) {
+      ALWAYS(_terms.remove(dead[i]));
+    }
+    else {
+      ALWAYS(_literals.remove(static_cast<Literal*>(dead[i])));
+    }
+  }
+  size_t freed = 0;
+  while (dead.isNonEmpty()) {
+    Term* t = dead.pop();
+    freed += sizeof(Term)+t->arity()*sizeof(TermList);
+    t->_args[0]._info.shared = 0u;
+    t->destroy();
+  }
+
+  _totalTerms -= deadTerms;
+  _totalLiterals -= deadLiterals;
+  unsigned live = _totalTerms+_totalLiterals;
+  _nextCollection = live + max(live, MIN_COLLECTION_GROWTH);
+
+  env.statistics->termSharingCollections++;
+  env.statistics->reclaimedTerms += deadTerms;
+  env.statistics->reclaimedLiterals += deadLiterals;
+  env.statistics->reclaimedTermMemory += freed;
+} // TermSharing::collect
+
+/**
+ * Clear the marks set by @c markLive() without collecting anything.
+ */
+void TermSharing::clearMarks()
+{
+  CALL("TermSharing::clearMarks");
+
+  Set<Term*,TermSharing>::Iterator ts(_terms);
+  while (ts.hasNext()) {
+    ts.next()->_args[0]._info.gcMark = 0u;
+  }
+  Set<Literal*,TermSharing>::Iterator ls(_literals);
+  while (ls.hasNext()) {
+    ls.next()->_args[0]._info.gcMark = 0u;
+  }
+}
+
 /**
  * If the sharing structure contains a literal opposite to @b l, return it.
  * Otherwise return 0.
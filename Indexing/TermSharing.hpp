@@ -53,6 +53,18 @@ public:
 
   Literal* tryGetOpposite(Literal* l);
 
+  void makePersistent();
+  void makePersistent(Term* t);
+  void markLive(Term* t);
+  void markLive(Formula* f);
+  /** Mark term @b t and its subterms as being in use */
+  void markLive(TermList t)
+  { if (t.isTerm()) { markLive(t.term()); } }
+  bool collectionDue() const
+  { return _totalTerms+_totalLiterals >= _nextCollection; }
+  void collect();
+  void clearMarks();
+
   /** The hash function of this literal */
   inline static unsigned hash(const Literal* l)
   { return l->hash(); }
@@ -92,6 +104,8 @@ private:
   unsigned _literalInsertions;
   /** Number of term insertions */
   unsigned _termInsertions;
+  /** Number of stored terms and literals at which the next collection is due */
+  unsigned _nextCollection;
 }; // class TermSharing
 
 } // namespace Indexing
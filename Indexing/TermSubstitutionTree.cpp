@@ -58,6 +58,18 @@ void TermSubstitutionTree::remove(TermList t, Literal* lit, Clause* cls)
   handleTerm(t,lit,cls, false);
 }
 
+bool TermSubstitutionTree::markSharedTerms()
+{
+  CALL("TermSubstitutionTree::markSharedTerms");
+
+  SubstitutionTree::markSharedTerms();
+  LDSkipList::RefIterator vit(_vars);
+  while(vit.hasNext()) {
+    SubstitutionTree::markSharedTerms(vit.next());
+  }
+  return true;
+}
+
 /**
  * According to value of @b insert, insert or remove term.
  */
@@ -92,6 +104,37 @@ void TermSubstitutionTree::handleTerm(TermList t, Literal* lit, Clause* cls, boo
   }
 }
 
+/**
+ * Insert the terms of @b entries, empty trees are built
+ * in one pass over the terms with the same top symbol
+ */
+void TermSubstitutionTree::bulkInsert(const EntryStack& entries)
+{
+  CALL("TermSubstitutionTree::bulkInsert");
+
+  BulkEntryStack batch(entries.size());
+  EntryStack::ConstIterator eit(entries);
+  while(eit.hasNext()) {
+    const Entry& e=eit.next();
+    TermList t=e.term;
+    LeafData ld(e.clause, e.literal, t);
+    if(t.isOrdinaryVar()) {
+      _vars.insert(ld);
+      continue;
+    }
+    ASS(t.isTerm());
+    Term* normTerm=Renaming::normalize(t.term());
+    BulkEntry* be=new BulkEntry(getRootNodeIndex(normTerm), ld);
+    getBindings(normTerm, be->bindings);
+    batch.push(be);
+  }
+  SubstitutionTree::bulkInsert(batch);
+
+  while(batch.isNonEmpty()) {
+    delete batch.pop();
+  }
+}
+
 
 TermQueryResultIterator TermSubstitutionTree::getUnifications(TermList t,
 	  bool retrieveSubstitutions)
@@ -46,6 +46,7 @@ public:
 
   void insert(TermList t, Literal* lit, Clause* cls);
   void remove(TermList t, Literal* lit, Clause* cls);
+  void bulkInsert(const EntryStack& entries) override;
 
   bool generalizationExists(TermList t);
 
@@ -62,6 +63,8 @@ public:
   TermQueryResultIterator getInstances(TermList t,
 	  bool retrieveSubstitutions);
 
+  bool markSharedTerms();
+
 #if VDEBUG
   virtual void markTagged(){ SubstitutionTree::markTagged();}
 #endif
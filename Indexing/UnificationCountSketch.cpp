@@ -0,0 +1,147 @@
+/*
+ * File UnificationCountSketch.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file UnificationCountSketch.cpp
+ * Implements class UnificationCountSketch.
+ */
+
+#include <climits>
+#include <cstring>
+
+#include "Lib/Hash.hpp"
+
+#include "UnificationCountSketch.hpp"
+
+namespace Indexing
+{
+
+UnificationCountSketch::UnificationCountSketch()
+: _total(0), _varCnt(0)
+{
+  memset(_sketch, 0, sizeof(_sketch));
+}
+
+/**
+ * Return the bucket of the pair @b top, @b argFunctor in the row @b row
+ * of the sketch
+ */
+unsigned UnificationCountSketch::bucket(unsigned row, unsigned top, unsigned argFunctor)
+{
+  unsigned h = HashUtils::combine(HashUtils::combine(top, argFunctor), row*0x85ebca6bu);
+  return (h*2654435761u) >> (32-WIDTH_BITS);
+}
+
+void UnificationCountSketch::handle(unsigned top, TermList* firstArg, int delta)
+{
+  CALL("UnificationCountSketch::handle/3");
+
+  _total += delta;
+  int* pcnt;
+  _topCnts.getValuePtr(top, pcnt, 0);
+  *pcnt += delta;
+  ASS_GE(*pcnt, 0);
+
+  if(!firstArg) {
+    return;
+  }
+  if(firstArg->isVar()) {
+    _varArgCnts.getValuePtr(top, pcnt, 0);
+    *pcnt += delta;
+    return;
+  }
+  unsigned argFunctor = firstArg->term()->functor();
+  for(unsigned row = 0; row < DEPTH; row++) {
+    _sketch[row][bucket(row, top, argFunctor)] += delta;
+  }
+}
+
+/**
+ * Update the counts by adding or removing the literal @b lit
+ *
+ * The first argument of equalities is not taken into account, since
+ * their arguments may be swapped by unification.
+ */
+void UnificationCountSketch::handle(Literal* lit, bool adding)
+{
+  CALL("UnificationCountSketch::handle(Literal*)");
+
+  TermList* firstArg = (lit->arity() && !lit->isEquality()) ? lit->nthArgument(0) : 0;
+  handle(lit->header(), firstArg, adding ? 1 : -1);
+}
+
+/**
+ * Update the counts by adding or removing the term @b t
+ */
+void UnificationCountSketch::handle(TermList t, bool adding)
+{
+  CALL("UnificationCountSketch::handle(TermList)");
+
+  if(t.isVar()) {
+    _total += adding ? 1 : -1;
+    _varCnt += adding ? 1 : -1;
+    return;
+  }
+  Term* trm = t.term();
+  handle(trm->functor(), trm->arity() ? trm->nthArgument(0) : 0, adding ? 1 : -1);
+}
+
+unsigned UnificationCountSketch::estimate(unsigned top, TermList* firstArg) const
+{
+  CALL("UnificationCountSketch::estimate");
+
+  int res = _topCnts.get(top, 0);
+  if(res && firstArg && firstArg->isTerm()) {
+    unsigned argFunctor = firstArg->term()->functor();
+    int argCnt = INT_MAX;
+    for(unsigned row = 0; row < DEPTH; row++) {
+      argCnt = std::min(argCnt, _sketch[row][bucket(row, top, argFunctor)]);
+    }
+    res = std::min(res, argCnt + _varArgCnts.get(top, 0));
+  }
+  return res;
+}
+
+/**
+ * Return an upper estimate of the number of indexed literals that unify
+ * with @b lit (or with its complement if @b complementary is true)
+ */
+unsigned UnificationCountSketch::estimateUnifications(Literal* lit, bool complementary) const
+{
+  CALL("UnificationCountSketch::estimateUnifications(Literal*)");
+
+  unsigned header = complementary ? lit->complementaryHeader() : lit->header();
+  TermList* firstArg = (lit->arity() && !lit->isEquality()) ? lit->nthArgument(0) : 0;
+  return estimate(header, firstArg);
+}
+
+/**
+ * Return an upper estimate of the number of indexed terms that unify
+ * with @b t
+ */
+unsigned UnificationCountSketch::estimateUnifications(TermList t) const
+{
+  CALL("UnificationCountSketch::estimateUnifications(TermList)");
+
+  if(t.isVar()) {
+    return _total;
+  }
+  Term* trm = t.term();
+  return estimate(trm->functor(), trm->arity() ? trm->nthArgument(0) : 0) + _varCnt;
+}
+
+}
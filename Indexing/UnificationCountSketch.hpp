@@ -0,0 +1,87 @@
+/*
+ * File UnificationCountSketch.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file UnificationCountSketch.hpp
+ * Defines class UnificationCountSketch.
+ */
+
+#ifndef __UnificationCountSketch__
+#define __UnificationCountSketch__
+
+#include "Forwards.hpp"
+
+#include "Lib/DHMap.hpp"
+
+#include "Kernel/Term.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Approximate counts of the literals (or terms) stored in an index,
+ * giving a cheap estimate of the number of unifiers a query would
+ * retrieve from the index.
+ *
+ * The counts are kept per top symbol (literal header, or functor of
+ * a term), and for each top symbol the non-variable first arguments
+ * are counted by their functor in a count-min sketch. The estimate
+ * of a query is the number of indexed entries whose top symbol and
+ * the top functor of the first argument do not clash with those of
+ * the query. It is an overestimate, but it never misses an entry
+ * that can be unified with the query.
+ */
+class UnificationCountSketch
+{
+public:
+  CLASS_NAME(UnificationCountSketch);
+  USE_ALLOCATOR(UnificationCountSketch);
+
+  UnificationCountSketch();
+
+  void handle(Literal* lit, bool adding);
+  void handle(TermList t, bool adding);
+
+  unsigned estimateUnifications(Literal* lit, bool complementary) const;
+  unsigned estimateUnifications(TermList t) const;
+
+private:
+  void handle(unsigned top, TermList* firstArg, int delta);
+  unsigned estimate(unsigned top, TermList* firstArg) const;
+  static unsigned bucket(unsigned row, unsigned top, unsigned argFunctor);
+
+  static const unsigned DEPTH = 4;
+  static const unsigned WIDTH_BITS = 8;
+  static const unsigned WIDTH = 1u << WIDTH_BITS;
+
+  /** number of all indexed entries */
+  int _total;
+  /** number of indexed variables (in term indexes only) */
+  int _varCnt;
+  /** number of entries per top symbol */
+  DHMap<unsigned,int> _topCnts;
+  /** number of entries per top symbol whose first argument is a variable */
+  DHMap<unsigned,int> _varArgCnts;
+  /** count-min sketch over pairs of top symbol and the functor of the first argument */
+  int _sketch[DEPTH][WIDTH];
+};
+
+}
+
+#endif // __UnificationCountSketch__
@@ -289,6 +289,15 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
   {
   LiteralMiniIndex miniIndex(cl);
 
+  //each literal of a clause that subsumption-resolves cl matches either
+  //a literal of cl or the complement of one
+  Clause::Signature resolutionSig=cl->signature();
+  if(_subsumptionResolution) {
+    for(unsigned li=0;li<clen;li++) {
+      resolutionSig|=Clause::literalSignature((*cl)[li], true);
+    }
+  }
+
   for(unsigned li=0;li<clen;li++) {
     SLQueryResultIterator rit=_fwIndex->getGeneralizations( (*cl)[li], false, false);
     while(rit.hasNext()) {
@@ -301,6 +310,16 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
       unsigned mlen=mcl->length();
       ASS_G(mlen,1);
 
+      bool maySubsume=mcl->signatureMaySubsume(cl);
+      if(!maySubsume) {
+        env.statistics->forwardSubsumptionSignatureRejections++;
+        if(!_subsumptionResolution || (mcl->signature() & ~resolutionSig)) {
+          //mcl can be used neither for subsumption nor for subsumption resolution
+          mcl->setAux(0);
+          continue;
+        }
+      }
+
       ClauseMatches* cms=new ClauseMatches(mcl);
       mcl->setAux(cms);
       cmStore.push(cms);
@@ -308,7 +327,7 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
       //      cms->fillInMatches(&miniIndex, res.literal, (*cl)[li]);
       cms->fillInMatches(&miniIndex);
 
-      if(cms->anyNonMatched()) {
+      if(!maySubsume || cms->anyNonMatched()) {
 	continue;
       }
 
@@ -375,6 +394,11 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
 	  //we have already examined this clause
 	  continue;
 	}
+	if(mcl->signature() & ~resolutionSig) {
+	  env.statistics->forwardSubsumptionSignatureRejections++;
+	  mcl->setAux(0);
+	  continue;
+	}
 
 	ClauseMatches* cms=new ClauseMatches(mcl);
 	res.clause->setAux(cms);
@@ -473,8 +473,8 @@ Clause* HyperSuperposition::tryGetContradictionFromUnification(Clause* cl, Term*
   UnitList* premLst = 0;
   UnitList::pushFromIterator(ClauseStack::Iterator(premStack), premLst);
   UnitList::push(cl, premLst);
-  Inference* inf = new InferenceMany(Inference::HYPER_SUPERPOSITION, premLst);
   Unit::InputType inp = Unit::getInputType(premLst);
+  Inference* inf = new InferenceMany(Inference::HYPER_SUPERPOSITION, premLst);
   Clause* res = Clause::fromIterator(LiteralIterator::getEmpty(), inp, inf);
   res->setAge(cl->age());
   return res;
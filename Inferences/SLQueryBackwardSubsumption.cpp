@@ -182,6 +182,11 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
       continue;
     }
 
+    if(!cl->signatureMaySubsume(icl)) {
+      env.statistics->backwardSubsumptionSignatureRejections++;
+      continue;
+    }
+
     RSTAT_CTR_INC("bs1 0 candidates");
 
     //here we pick one literal header of the base clause and make sure that
@@ -34,6 +34,7 @@
 #include "Kernel/EqHelper.hpp"
 #include "Kernel/Inference.hpp"
 #include "Kernel/Ordering.hpp"
+#include "Kernel/RobSubstitution.hpp"
 #include "Kernel/SortHelper.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
@@ -44,6 +45,7 @@
 #include "Indexing/IndexManager.hpp"
 #include "Indexing/TermSharing.hpp"
 
+#include "Saturation/CriticalPairQueue.hpp"
 #include "Saturation/SaturationAlgorithm.hpp"
 
 #include "Shell/Options.hpp"
@@ -71,12 +73,20 @@ void Superposition::attach(SaturationAlgorithm* salg)
 	  _salg->getIndexManager()->request(SUPERPOSITION_SUBTERM_SUBST_TREE) );
   _lhsIndex=static_cast<SuperpositionLHSIndex*> (
 	  _salg->getIndexManager()->request(SUPERPOSITION_LHS_SUBST_TREE) );
+  _criticalPairs=_salg->getCriticalPairQueue();
+  if(_criticalPairs) {
+    _criticalPairs->setSuperposition(this);
+  }
 }
 
 void Superposition::detach()
 {
   CALL("Superposition::detach");
 
+  if(_criticalPairs) {
+    _criticalPairs->setSuperposition(0);
+    _criticalPairs=0;
+  }
   _subtermIndex=0;
   _lhsIndex=0;
   _salg->getIndexManager()->release(SUPERPOSITION_SUBTERM_SUBST_TREE);
@@ -149,6 +159,10 @@ struct Superposition::ForwardResultFn
     CALL("Superposition::ForwardResultFn::operator()");
 
     TermQueryResult& qr = arg.second;
+    if(_parent._criticalPairs && (qr.constraints.isEmpty() || qr.constraints->isEmpty())) {
+      return _parent.deferSuperposition(_cl, arg.first.first, arg.first.second,
+	    qr.clause, qr.literal, qr.term, qr.substitution, true);
+    }
     return _parent.performSuperposition(_cl, arg.first.first, arg.first.second,
 	    qr.clause, qr.literal, qr.term, qr.substitution, true, _limits, qr.constraints);
   }
@@ -172,6 +186,10 @@ struct Superposition::BackwardResultFn
     }
 
     TermQueryResult& qr = arg.second;
+    if(_parent._criticalPairs && (qr.constraints.isEmpty() || qr.constraints->isEmpty())) {
+      return _parent.deferSuperposition(qr.clause, qr.literal, qr.term,
+	    _cl, arg.first.first, arg.first.second, qr.substitution, false);
+    }
     return _parent.performSuperposition(qr.clause, qr.literal, qr.term,
 	    _cl, arg.first.first, arg.first.second, qr.substitution, false, _limits, qr.constraints);
   }
@@ -417,6 +435,81 @@ size_t Superposition::getSubtermOccurrenceCount(Term* trm, TermList subterm)
   return res;
 }
 
+/**
+ * Store the superposition into the queue of critical pairs instead of
+ * performing it. Only the checks that do not need the instantiated terms
+ * are done here, the weight of the result is estimated from the weights
+ * of the substitution applications. Always return 0.
+ */
+Clause* Superposition::deferSuperposition(
+    Clause* rwClause, Literal* rwLit, TermList rwTerm,
+    Clause* eqClause, Literal* eqLit, TermList eqLHS,
+    ResultSubstitutionSP subst, bool eqIsResult)
+{
+  CALL("Superposition::deferSuperposition");
+  ASS(_criticalPairs);
+  ASS_EQ(rwClause->length(),1);
+  ASS_EQ(eqClause->length(),1);
+
+  unsigned sort = SortHelper::getEqualityArgumentSort(eqLit);
+  if(SortHelper::getTermSort(rwTerm, rwLit)!=sort) {
+    return 0;
+  }
+  if(eqLHS.isVar() && !checkSuperpositionFromVariable(eqClause, eqLit, eqLHS)) {
+    return 0;
+  }
+  if(!checkClauseColorCompatibility(eqClause, rwClause)) {
+    return 0;
+  }
+
+  TermList tgtTerm = EqHelper::getOtherEqualitySide(eqLit, eqLHS);
+  int lhsSWeight = subst->getApplicationWeight(eqLHS, eqIsResult);
+  int rhsSWeight = subst->getApplicationWeight(tgtTerm, eqIsResult);
+  int rwrBalance = rhsSWeight-lhsSWeight;
+  size_t rwrCnt = (rwrBalance==0) ? 0 : getSubtermOccurrenceCount(rwLit, rwTerm);
+  int weight = subst->getApplicationWeight(rwLit, !eqIsResult)+rwrBalance*static_cast<int>(rwrCnt);
+
+  CriticalPair cp;
+  cp.rwClause = rwClause;
+  cp.rwLit = rwLit;
+  cp.rwTerm = rwTerm;
+  cp.eqClause = eqClause;
+  cp.eqLit = eqLit;
+  cp.eqLHS = eqLHS;
+  cp.weight = Int::max(weight, 1);
+  cp.age = Int::max(rwClause->age(),eqClause->age())+1;
+  cp.eqIsResult = eqIsResult;
+  _criticalPairs->add(cp);
+  env.statistics->deferredSuperpositions++;
+  return 0;
+}
+
+/**
+ * Perform the superposition stored in the critical pair @c cp and
+ * return its result, or 0 if the superposition should not be performed
+ * or if one of its parents is no longer active.
+ */
+Clause* Superposition::performDeferredSuperposition(const CriticalPair& cp)
+{
+  CALL("Superposition::performDeferredSuperposition");
+
+  if(cp.rwClause->store()!=Clause::ACTIVE || cp.eqClause->store()!=Clause::ACTIVE) {
+    env.statistics->deadCriticalPairs++;
+    return 0;
+  }
+
+  static RobSubstitution subst;
+  subst.reset();
+  int rwBank = cp.eqIsResult ? 0 : 1;
+  int eqBank = cp.eqIsResult ? 1 : 0;
+  ALWAYS(subst.unify(cp.rwTerm, rwBank, cp.eqLHS, eqBank));
+
+  TimeCounter tc(TC_SUPERPOSITION);
+  return performSuperposition(cp.rwClause, cp.rwLit, cp.rwTerm, cp.eqClause, cp.eqLit, cp.eqLHS,
+      ResultSubstitution::fromSubstitution(&subst, 0, 1), cp.eqIsResult, _salg->getLimits(),
+      UnificationConstraintStackSP());
+}
+
 /**
  * If superposition should be performed, return result of the superposition,
  * otherwise return 0.
@@ -48,8 +48,14 @@ public:
 
   ClauseIterator generateClauses(Clause* premise);
 
+  Clause* performDeferredSuperposition(const CriticalPair& cp);
 
 private:
+  Clause* deferSuperposition(
+	  Clause* rwClause, Literal* rwLiteral, TermList rwTerm,
+	  Clause* eqClause, Literal* eqLiteral, TermList eqLHS,
+	  ResultSubstitutionSP subst, bool eqIsResult);
+
   Clause* performSuperposition(
 	  Clause* rwClause, Literal* rwLiteral, TermList rwTerm,
 	  Clause* eqClause, Literal* eqLiteral, TermList eqLHS,
@@ -76,6 +82,8 @@ private:
 
   SuperpositionSubtermIndex* _subtermIndex;
   SuperpositionLHSIndex* _lhsIndex;
+  /** if non-zero, the unconstrained superpositions are stored here instead of being performed */
+  CriticalPairQueue* _criticalPairs;
 };
 
 
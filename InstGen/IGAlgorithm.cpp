@@ -46,6 +46,7 @@
 #include "SAT/SATClause.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/CDCLSolver.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
@@ -102,6 +103,9 @@ IGAlgorithm::IGAlgorithm(Problem& prb,const Options& opt)
     case Options::SatSolver::MINISAT:
       _satSolver = new MinisatInterfacing(opt,true);
       break;
+    case Options::SatSolver::CDCL:
+      _satSolver = new CDCLSolver(opt,true);
+      break;
 #if VZ3
     case Options::SatSolver::Z3:
       //cout << "Warning: Z3 not compatible with inst_gen, using Minisat" << endl;
@@ -127,6 +131,7 @@ IGAlgorithm::IGAlgorithm(Problem& prb,const Options& opt)
   } else {
     _variantIdx = new SubstitutionTreeClauseVariantIndex();
   }
+  _postponedVariants = 0;
   _selected = new LiteralSubstitutionTree();
 
   _doingSatisfiabilityCheck = false;
@@ -214,6 +219,7 @@ bool IGAlgorithm::addClause(Clause* cl)
 
   TimeCounter tc(TC_INST_GEN_SIMPLIFICATIONS);
 
+  Clause* orig = cl;
   cl = _duplicateLiteralRemoval.simplify(cl);
   if(cl) { cl = _tautologyDeletion.simplify(cl); }
   if(cl) { cl = _trivialInequalityRemoval.simplify(cl); }
@@ -223,7 +229,11 @@ bool IGAlgorithm::addClause(Clause* cl)
   }
 
 redundancy_check:
-  {
+  if(_postponedVariants && cl!=orig) {
+    // the modified clause may be a variant of a postponed one
+    flushPostponedVariants();
+  }
+  if(!_postponedVariants) {
     bool redundant;
     {
       TimeCounter tc2(TC_INST_GEN_VARIANT_DETECTION);
@@ -260,7 +270,11 @@ redundancy_check:
   }
 
   cl->incRefCnt();
-  _variantIdx->insert(cl);
+  if(_postponedVariants) {
+    _postponedVariants->push(cl);
+  } else {
+    _variantIdx->insert(cl);
+  }
 
   _unprocessed.push(cl);
   env.statistics->instGenKeptClauses++;
@@ -766,6 +780,22 @@ void IGAlgorithm::wipeIndexes()
   _selected = new LiteralSubstitutionTree();
 }
 
+/**
+ * Insert the clauses postponed while adding back the current clauses
+ * on a restart into the variant index, the clauses added afterwards
+ * are checked for being variants as usual
+ */
+void IGAlgorithm::flushPostponedVariants()
+{
+  CALL("IGAlgorithm::flushPostponedVariants");
+  ASS(_postponedVariants);
+
+  TimeCounter tc(TC_INST_GEN_VARIANT_DETECTION);
+
+  _variantIdx->bulkInsert(*_postponedVariants);
+  _postponedVariants = 0;
+}
+
 
 void IGAlgorithm::restartWithCurrentClauses()
 {
@@ -786,11 +816,22 @@ void IGAlgorithm::restartWithCurrentClauses()
 
   wipeIndexes();
 
+  // The current clauses are not variants of each other, so unless
+  // a clause is modified when being added back, it need not be checked
+  // for being a variant and the variant index can be built from all
+  // of them at once.
+  static ClauseStack postponedVariants;
+  postponedVariants.reset();
+  _postponedVariants = &postponedVariants;
+
   while(allClauses.isNonEmpty()) {
     Clause* cl = allClauses.popWithoutDec();
     addClause(cl);
     cl->decRefCnt();//corresponds to the removal from the active and passive container
   }
+  if(_postponedVariants) {
+    flushPostponedVariants();
+  }
 }
 
 void IGAlgorithm::restartFromBeginning()
@@ -93,6 +93,7 @@ private:
 
 
   void wipeIndexes();
+  void flushPostponedVariants();
 
   void processUnprocessed();
   void activate(Clause* cl, bool wasDeactivated=false);
@@ -168,6 +169,11 @@ private:
 
   bool _use_hashing;
   ClauseVariantIndex* _variantIdx;
+  /**
+   * Clauses whose insertion into @b _variantIdx is postponed while the
+   * current clauses are added back on a restart, zero otherwise
+   */
+  ClauseStack* _postponedVariants;
 
   LiteralSubstitutionTree* _selected;
 
@@ -29,11 +29,11 @@
 
 #include "Lib/Allocator.hpp"
 #include "Lib/DArray.hpp"
+#include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/SharedSet.hpp"
 #include "Lib/Stack.hpp"
-#include "Lib/BitUtils.hpp"
 
 #include "Saturation/ClauseContainer.hpp"
 
@@ -59,6 +59,7 @@ using namespace Saturation;
 using namespace Shell;
 
 size_t Clause::_auxCurrTimestamp = 0;
+DHSet<Clause*>* Clause::_liveClauses = 0;
 #if VDEBUG
 bool Clause::_auxInUse = false;
 #endif
@@ -78,6 +79,7 @@ Clause::Clause(unsigned length,InputType it,Inference* inf)
     _numSelected(0),
     _age(0),
     _weight(0),
+    _signature(0),
     _store(NONE),
     _in_active(0),
     _refCnt(0),
@@ -114,6 +116,9 @@ Clause::Clause(unsigned length,InputType it,Inference* inf)
     _theoryDescendant=td;
     _inductionDepth=id;
   }
+  if(_liveClauses){
+    _liveClauses->insert(this);
+  }
 }
 
 /**
@@ -156,6 +161,9 @@ void Clause::destroyExceptInferenceObject()
   if (_literalPositions) {
     delete _literalPositions;
   }
+  if (_liveClauses) {
+    _liveClauses->remove(this);
+  }
 
   RSTAT_CTR_INC("clauses deleted");
 
@@ -169,6 +177,19 @@ void Clause::destroyExceptInferenceObject()
 }
 
 
+/**
+ * Start keeping the set of existing clauses, see liveClauses().
+ * Only the clauses created after the call are in the set.
+ */
+void Clause::trackLiveClauses()
+{
+  CALL("Clause::trackLiveClauses");
+
+  if(!_liveClauses) {
+    _liveClauses = new DHSet<Clause*>();
+  }
+}
+
 Clause* Clause::fromStack(const Stack<Literal*>& lits, InputType it, Inference* inf)
 {
   CALL("Clause::fromStack");
@@ -258,7 +279,11 @@ void Clause::destroy()
 /** Set the store to @b s
  *
  * Can lead to clause deletion if the store is @b NONE
- * and there Clause's reference counter is zero. */
+ * and there Clause's reference counter is zero.
+ *
+ * With Options::pruneDeletedInferences(), a clause whose store
+ * becomes @b NONE also releases its premises, as its derivation
+ * is not needed any more. */
 void Clause::setStore(Store s)
 {
   CALL("Clause::setStore");
@@ -276,6 +301,9 @@ void Clause::setStore(Store s)
   }
 #endif
   _store = s;
+  if (s == NONE && env.options->pruneDeletedInferences()) {
+    _inference->releasePremises();
+  }
   destroyIfUnnecessary();
 }
 
@@ -545,6 +573,44 @@ void Clause::computeWeight() const
 
 } // Clause::computeWeight
 
+/**
+ * Return the signature of a single literal, or of its complement
+ * if @b complementary is true.
+ *
+ * One bit stands for the header of the literal and one for each pair
+ * of the header and the top functor of a non-variable argument. The
+ * argument position is not taken into account, so that the signature
+ * is invariant under the commutativity of equality.
+ */
+Clause::Signature Clause::literalSignature(Literal* lit, bool complementary)
+{
+  CALL("Clause::literalSignature");
+
+  unsigned header = complementary ? lit->complementaryHeader() : lit->header();
+  Signature res = 1ull << ((header*2654435761u) >> 26);
+  for(TermList* arg = lit->args(); arg->isNonEmpty(); arg = arg->next()) {
+    if(arg->isTerm()) {
+      unsigned code = header ^ ((arg->term()->functor()+1)*40503u);
+      res |= 1ull << ((code*2654435761u) >> 26);
+    }
+  }
+  return res;
+}
+
+/**
+ * Compute the signature of the clause.
+ * @see Clause::Signature
+ */
+void Clause::computeSignature() const
+{
+  CALL("Clause::computeSignature");
+
+  _signature = 0;
+  for(unsigned i = 0; i < _length; i++) {
+    _signature |= literalSignature(_literals[i]);
+  }
+}
+
 
 /**
  * Return weight of the split part of the clause
@@ -584,7 +650,7 @@ unsigned Clause::getNumeralWeight()
       }
       IntegerConstantType intVal;
       if (theory->tryInterpretConstant(t,intVal)) {
-	int w = BitUtils::log2(abs(intVal.toInner()))-1;
+	int w = intVal.log2Abs()-1;
 	if (w > 0) {
 	  res += w;
 	}
@@ -603,8 +669,8 @@ unsigned Clause::getNumeralWeight()
       if (!haveRat) {
 	continue;
       }
-      int wN = BitUtils::log2(abs(ratVal.numerator().toInner()))-1;
-      int wD = BitUtils::log2(abs(ratVal.denominator().toInner()))-1;
+      int wN = ratVal.numerator().log2Abs()-1;
+      int wD = ratVal.denominator().log2Abs()-1;
       int v = wN + wD;
       if (v > 0) {
 	res += v;
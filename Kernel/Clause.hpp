@@ -105,6 +105,11 @@ public:
 
   static Clause* fromClause(Clause* c);
 
+  static void trackLiveClauses();
+  /** The set of all clauses created since trackLiveClauses() was called
+   * and not destroyed yet, or 0 if the clauses are not being tracked */
+  static DHSet<Clause*>* liveClauses() { return _liveClauses; }
+
   /**
    * Return the (reference to) the nth literal
    *
@@ -176,6 +181,34 @@ public:
   }
   void computeWeight() const;
 
+  /**
+   * Bit-set abstraction of the literal headers and the top functors of
+   * their arguments. If a clause C subsumes a clause D, each bit of
+   * C's signature is set in D's signature as well, so subsumption can
+   * be ruled out by checking the signatures first.
+   */
+  typedef unsigned long long Signature;
+
+  /** Return the signature of the clause */
+  Signature signature() const
+  {
+    if(!_signature) {
+      computeSignature();
+    }
+    return _signature;
+  }
+  void computeSignature() const;
+  static Signature literalSignature(Literal* lit, bool complementary=false);
+
+  /**
+   * Return false if the signatures rule out that @b this
+   * subsumes @b cl
+   */
+  bool signatureMaySubsume(Clause* cl) const
+  {
+    return _length<=cl->_length && !(signature() & ~cl->signature());
+  }
+
   /** Return the color of a clause */
   Color color() const
   {
@@ -374,6 +407,8 @@ protected:
   unsigned _age;
   /** weight */
   mutable unsigned _weight;
+  /** signature, zero if not computed yet */
+  mutable Signature _signature;
   /** storage class */
   Store _store;
   /** in active index **/
@@ -392,6 +427,7 @@ protected:
   void* _auxData;
 
   static size_t _auxCurrTimestamp;
+  static DHSet<Clause*>* _liveClauses;
 #if VDEBUG
   static bool _auxInUse;
 #endif
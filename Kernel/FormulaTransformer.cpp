@@ -487,8 +487,8 @@ bool ScanAndApplyLiteralTransformer::apply(FormulaUnit* unit, Unit*& res)
   UnitList::pushFromIterator(UnitStack::Iterator(prems), premLst);
   UnitList::push(unit, premLst);
 
-  Inference* inf = new InferenceMany(_infRule, premLst);
   Unit::InputType inpType = Unit::getInputType(premLst);
+  Inference* inf = new InferenceMany(_infRule, premLst);
 
   res = new FormulaUnit(newForm, inf, inpType);
 
@@ -525,8 +525,8 @@ bool ScanAndApplyLiteralTransformer::apply(Clause* cl, Unit*& res)
   UnitList::pushFromIterator(UnitStack::Iterator(prems), premLst);
   UnitList::push(cl, premLst);
 
-  Inference* inf = new InferenceMany(_infRule, premLst);
   Unit::InputType inpType = Unit::getInputType(premLst);
+  Inference* inf = new InferenceMany(_infRule, premLst);
 
   res = Clause::fromIterator(LiteralStack::Iterator(lits), inpType, inf);
   return true;
@@ -25,13 +25,14 @@
 
 #include "Debug/Tracer.hpp"
 #include "Kernel/Term.hpp"
+#include "Lib/DHMap.hpp"
 
 #include "Inference.hpp"
 
 using namespace Kernel;
 
 Inference::Inference(Rule r)
-  : _rule(r), _extra(""),_maxDepth(0)
+  : _rule(r), _maxDepth(0), _hasExtra(0)
 {
 //  switch(r) {
 //  //TODO: move env.statistics object updates here.
@@ -39,6 +40,43 @@ Inference::Inference(Rule r)
 //  }
 }
 
+/**
+ * The extra strings of inferences. Only few inferences have one
+ * (see Options::proofExtra()), so they are not stored in the objects.
+ */
+static DHMap<const Inference*,vstring>& extras()
+{
+  static DHMap<const Inference*,vstring> map;
+  return map;
+}
+
+Inference::~Inference()
+{
+  if (_hasExtra) {
+    extras().remove(this);
+  }
+}
+
+/** Set extra string */
+void Inference::setExtra(vstring e)
+{
+  CALL("Inference::setExtra");
+
+  extras().set(this,e);
+  _hasExtra = 1;
+}
+
+/** Return the extra string */
+vstring Inference::extra()
+{
+  CALL("Inference::extra");
+
+  if (!_hasExtra) {
+    return "";
+  }
+  return extras().get(this);
+}
+
 
 /**
  * Destroy an inference with no premises.
@@ -57,10 +95,22 @@ void Inference::destroy()
 void Inference1::destroy()
 {
   CALL ("Inference1::destroy");
-  _premise1->decRefCnt();
+  if (_premise1) {
+    _premise1->decRefCnt();
+  }
   delete this;
 }
 
+void Inference1::releasePremises()
+{
+  CALL ("Inference1::releasePremises");
+  if (_premise1) {
+    Unit* prem = _premise1;
+    _premise1 = 0;
+    prem->decRefCnt();
+  }
+}
+
 /**
  * Destroy an inference with two premises.
  * @since 07/01/2008 Torrevieja
@@ -68,29 +118,77 @@ void Inference1::destroy()
 void Inference2::destroy()
 {
   CALL ("Inference2::destroy");
-  _premise1->decRefCnt();
-  _premise2->decRefCnt();
+  if (_premise1) {
+    _premise1->decRefCnt();
+    _premise2->decRefCnt();
+  }
   delete this;
 }
 
+void Inference2::releasePremises()
+{
+  CALL ("Inference2::releasePremises");
+  if (_premise1) {
+    Unit* prem1 = _premise1;
+    Unit* prem2 = _premise2;
+    _premise1 = 0;
+    _premise2 = 0;
+    prem1->decRefCnt();
+    prem2->decRefCnt();
+  }
+}
+
 /**
  * Create an inference object with multiple premisses
+ *
+ * The premises are copied into an array and the list is destroyed.
  */
 InferenceMany::InferenceMany(Rule rule,UnitList* premises)
   : Inference(rule),
-    _premises(premises)
+    _premCnt(0),
+    _premises(0)
 {
   CALL("InferenceMany::InferenceMany");
-  UnitList* it=_premises;
+
+  setPremises(premises);
   unsigned md = 0;
-  while(it) {
-    it->head()->incRefCnt();
-    md = max(md,it->head()->inference()->maxDepth());
-    it=it->tail();
+  for (unsigned i = 0; i < _premCnt; i++) {
+    md = max(md,_premises[i]->inference()->maxDepth());
   }
   _maxDepth = md+1;
 }
 
+/**
+ * Replace the premises by @b premises, increasing their reference
+ * counters, and destroy the list. The reference counters of the
+ * previous premises are not decreased.
+ */
+void InferenceMany::setPremises(UnitList* premises)
+{
+  CALL("InferenceMany::setPremises");
+
+  deletePremiseArray();
+  _premCnt = UnitList::length(premises);
+  if (_premCnt) {
+    _premises = static_cast<Unit**>(ALLOC_KNOWN(_premCnt*sizeof(Unit*),"InferenceMany::premises"));
+  }
+  Unit** ptr = _premises;
+  while(premises) {
+    Unit* prem = UnitList::pop(premises);
+    prem->incRefCnt();
+    *(ptr++) = prem;
+  }
+}
+
+void InferenceMany::deletePremiseArray()
+{
+  if (_premises) {
+    DEALLOC_KNOWN(_premises,_premCnt*sizeof(Unit*),"InferenceMany::premises");
+    _premises = 0;
+  }
+  _premCnt = 0;
+}
+
 /**
  * Destroy an inference with many premises.
  * @since 04/01/2008 Torrevieja
@@ -98,15 +196,30 @@ InferenceMany::InferenceMany(Rule rule,UnitList* premises)
 void InferenceMany::destroy()
 {
   CALL ("InferenceMany::destroy");
-  UnitList* it=_premises;
-  while(it) {
-    it->head()->decRefCnt();
-    it=it->tail();
+  for (unsigned i = 0; i < _premCnt; i++) {
+    _premises[i]->decRefCnt();
   }
 
   delete this;
 }
 
+void InferenceMany::releasePremises()
+{
+  CALL ("InferenceMany::releasePremises");
+
+  // the array is deleted first, as decreasing the counters may destroy units
+  unsigned cnt = _premCnt;
+  Unit** prems = _premises;
+  _premCnt = 0;
+  _premises = 0;
+  for (unsigned i = 0; i < cnt; i++) {
+    prems[i]->decRefCnt();
+  }
+  if (prems) {
+    DEALLOC_KNOWN(prems,cnt*sizeof(Unit*),"InferenceMany::premises");
+  }
+}
+
 /**
  * Return an iterator for an inference with many premises.
  * @since 04/01/2008 Torrevieja
@@ -114,7 +227,7 @@ void InferenceMany::destroy()
 Inference::Iterator InferenceMany::iterator()
 {
   Iterator it;
-  it.pointer = _premises;
+  it.integer = 0;
   return it;
 }
 
@@ -125,7 +238,7 @@ Inference::Iterator InferenceMany::iterator()
 Inference::Iterator Inference1::iterator()
 {
   Iterator it;
-  it.integer = 1;
+  it.integer = _premise1 ? 1 : 0;
   return it;
 }
 
@@ -136,7 +249,7 @@ Inference::Iterator Inference1::iterator()
 Inference::Iterator Inference2::iterator()
 {
   Iterator it;
-  it.integer = 0;
+  it.integer = _premise1 ? 0 : 2;
   return it;
 }
 
@@ -159,7 +272,7 @@ Inference::Iterator Inference::iterator()
  */
 bool InferenceMany::hasNext(Iterator& it)
 {
-  return it.pointer;
+  return static_cast<unsigned>(it.integer) < _premCnt;
 }
 
 /**
@@ -195,10 +308,8 @@ bool Inference::hasNext(Iterator&)
  */
 Unit* InferenceMany::next(Iterator& it)
 {
-  ASS(it.pointer);
-  UnitList* lst = reinterpret_cast<UnitList*>(it.pointer);
-  it.pointer = lst->tail();
-  return lst->head();
+  ASS_L(static_cast<unsigned>(it.integer),_premCnt);
+  return _premises[it.integer++];
 } // InferenceMany::next
 
 /**
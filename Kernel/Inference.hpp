@@ -332,7 +332,16 @@ public:
    * refered clauses are decreased extra. (Such as in Clause::destroy()
    * which does not use Inference::destroy() to avoid deep recursion.)
    */
-  virtual ~Inference() {}
+  virtual ~Inference();
+
+  /**
+   * Forget the premises, decreasing their reference counters, so that
+   * the inference has no premises afterwards.
+   *
+   * Only for inferences that will never be part of an output proof,
+   * see Clause::setStore().
+   */
+  virtual void releasePremises() {}
 
   /**
    * To implement lazy minimization of proofs coming from a SAT solver
@@ -376,20 +385,18 @@ public:
   /** Return the inference rule */
   Rule rule() const { return _rule; }
 
-  /** Set extra string */
-  void setExtra(vstring e){ _extra=e; }
-  /** Return the extra string */
-  vstring extra() { return _extra; }
+  void setExtra(vstring e);
+  vstring extra();
 
   unsigned maxDepth(){ return _maxDepth; }
 
 protected:
   /** The rule used */
   Rule _rule;
-  /** Extra information */
-  vstring _extra;
   /** The depth */
-  unsigned _maxDepth;
+  unsigned _maxDepth : 31;
+  /** True if an extra string is stored for the inference, see setExtra() */
+  unsigned _hasExtra : 1;
 }; // class Inference
 
 /**
@@ -410,6 +417,7 @@ public:
   }
 
   virtual void destroy();
+  virtual void releasePremises();
   virtual Iterator iterator();
   virtual bool hasNext(Iterator& it);
   virtual Unit* next(Iterator& it);
@@ -418,7 +426,7 @@ public:
   USE_ALLOCATOR(Inference1);
 
 protected:
-  /** The premise */
+  /** The premise, or zero if released */
   Unit* _premise1;
 };
 
@@ -431,9 +439,10 @@ class InferenceMany
 {
 public:
   InferenceMany(Rule rule,UnitList* premises);
-  virtual ~InferenceMany() { UnitList::destroy(_premises); }
+  virtual ~InferenceMany() { deletePremiseArray(); }
 
   virtual void destroy();
+  virtual void releasePremises();
   virtual Iterator iterator();
   virtual bool hasNext(Iterator& it);
   virtual Unit* next(Iterator& it);
@@ -442,8 +451,13 @@ public:
   USE_ALLOCATOR(InferenceMany);
 
 protected:
-  /** The premises */
-  UnitList* _premises;
+  void setPremises(UnitList* premises);
+  void deletePremiseArray();
+
+  /** The number of premises */
+  unsigned _premCnt;
+  /** The premises, an array of length _premCnt */
+  Unit** _premises;
 };
 
 /**
@@ -465,6 +479,7 @@ public:
   }
 
   virtual void destroy();
+  virtual void releasePremises();
   virtual Iterator iterator();
   virtual bool hasNext(Iterator& it);
   virtual Unit* next(Iterator& it);
@@ -473,9 +488,9 @@ public:
   USE_ALLOCATOR(Inference2);
 
 protected:
-  /** First premise */
+  /** First premise, or zero if released */
   Unit* _premise1;
-  /** Second premise */
+  /** Second premise, or zero if released */
   Unit* _premise2;
 };
 
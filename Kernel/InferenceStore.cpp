@@ -37,6 +37,8 @@
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "Parse/TPTP.hpp"
 
 #include "Saturation/Splitter.hpp"
@@ -100,6 +102,20 @@ void InferenceStore::recordSplittingNameLiteral(Unit* us, Literal* lit)
   ALWAYS(_splittingNameLiterals.insert(us, lit));
 }
 
+/**
+ * Mark the recorded splitting name literals as live,
+ * see TermSharing::collect.
+ */
+void InferenceStore::markSharedTerms()
+{
+  CALL("InferenceStore::markSharedTerms");
+
+  DHMap<Unit*, Literal*>::Iterator it(_splittingNameLiterals);
+  while (it.hasNext()) {
+    env.sharing->markLive(it.next());
+  }
+}
+
 
 /**
  * Record the introduction of a new symbol
@@ -82,6 +82,7 @@ public:
   };
 
   void recordSplittingNameLiteral(Unit* us, Literal* lit);
+  void markSharedTerms();
   void recordIntroducedSymbol(Unit* u, bool func, unsigned number);
   void recordIntroducedSplitName(Unit* u, vstring name);
 
@@ -537,10 +537,10 @@ class InterpretedLiteralEvaluator::IntEvaluator : public TypedEvaluator<IntegerC
 {
 protected:
 
-  virtual bool isZero(IntegerConstantType arg){ return arg.toInner()==0;}
+  virtual bool isZero(IntegerConstantType arg){ return arg.isZero();}
   virtual TermList getZero(){ return TermList(theory->representConstant(IntegerConstantType(0))); }
-  virtual bool isOne(IntegerConstantType arg){ return arg.toInner()==1;}
-  virtual bool isMinusOne(IntegerConstantType arg){ return arg.toInner()==-1;}
+  virtual bool isOne(IntegerConstantType arg){ return arg==1;}
+  virtual bool isMinusOne(IntegerConstantType arg){ return arg==-1;}
 
   virtual TermList invert(TermList t){ 
     unsigned um = env.signature->getInterpretingSymbol(Theory::INT_UNARY_MINUS);
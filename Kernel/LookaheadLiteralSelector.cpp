@@ -21,6 +21,8 @@
  * Implements class LookaheadLiteralSelector.
  */
 
+#include <climits>
+
 #include "Lib/DArray.hpp"
 #include "Lib/Exception.hpp"
 #include "Lib/Stack.hpp"
@@ -29,6 +31,7 @@
 #include "Indexing/LiteralIndex.hpp"
 #include "Indexing/LiteralIndexingStructure.hpp"
 #include "Indexing/TermIndex.hpp"
+#include "Indexing/UnificationCountSketch.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
@@ -187,14 +190,26 @@ VirtualIterator<void> LookaheadLiteralSelector::getGeneraingInferenceIterator(Li
 }
 
 /**
- * Return the literal from the @b lits array (of length @b cnt) that
- * is the best to be selected. This selection is done irregardless any
- * completeness constraints, the caller has to handle that, if necessary.
+ * Return true if the selector with options @b options estimates the
+ * numbers of inferences by the count sketches of the generating indexes,
+ * so the IndexManager has to create the indexes with the sketches.
  */
-Literal* LookaheadLiteralSelector::pickTheBest(Literal** lits, unsigned cnt)
+bool LookaheadLiteralSelector::usesCountSketches(const Options& options)
 {
-  CALL("LookaheadLiteralSelector::pickTheBest");
-  ASS_G(cnt,1); //special cases are handled elsewhere
+  int sel=options.selection();
+  return (sel==11 || sel==1011 || sel==-11 || sel==-1011) && !options.lookaheadExact();
+}
+
+/**
+ * Into @b candidates put the literals of the @b lits array (of length @b cnt)
+ * that have the least number of generating inferences
+ *
+ * The inferences are enumerated by the generating indexes, for all the
+ * literals at once, until the first literal runs out of them.
+ */
+void LookaheadLiteralSelector::leastExactInferences(Literal** lits, unsigned cnt, LiteralStack& candidates)
+{
+  CALL("LookaheadLiteralSelector::leastExactInferences");
 
   static DArray<VirtualIterator<void> > runifs; //resolution unification iterators
   runifs.ensure(cnt);
@@ -203,8 +218,6 @@ Literal* LookaheadLiteralSelector::pickTheBest(Literal** lits, unsigned cnt)
     runifs[i]=getGeneraingInferenceIterator(lits[i]);
   }
 
-  static Stack<Literal*> candidates;
-  candidates.reset();
   do {
     for(unsigned i=0;i<cnt;i++) {
       if(runifs[i].hasNext()) {
@@ -216,6 +229,122 @@ Literal* LookaheadLiteralSelector::pickTheBest(Literal** lits, unsigned cnt)
     }
   } while(candidates.isEmpty());
 
+  for(unsigned i=0;i<cnt;i++) {
+    runifs[i].drop(); //release the iterators
+  }
+}
+
+/**
+ * Return an estimate of the number of generating inferences that can be
+ * performed with @b lit selected, using the count sketches of the indexes
+ * of @b imgr
+ */
+unsigned LookaheadLiteralSelector::estimateInferences(Literal* lit, IndexManager* imgr)
+{
+  CALL("LookaheadLiteralSelector::estimateInferences");
+
+  unsigned res=0;
+
+  //resolution
+  if(imgr->contains(GENERATING_SUBST_TREE)) {
+    const UnificationCountSketch* sketch=static_cast<LiteralIndex*>(imgr->get(GENERATING_SUBST_TREE))->countSketch();
+    res+=sketch->estimateUnifications(lit, true);
+  }
+  //backward superposition
+  if(imgr->contains(SUPERPOSITION_SUBTERM_SUBST_TREE)) {
+    const UnificationCountSketch* sketch=static_cast<TermIndex*>(imgr->get(SUPERPOSITION_SUBTERM_SUBST_TREE))->countSketch();
+    TermIterator lhsi=EqHelper::getLHSIterator(lit, _ord);
+    while(lhsi.hasNext()) {
+      res+=sketch->estimateUnifications(lhsi.next());
+    }
+  }
+  //forward superposition
+  if(imgr->contains(SUPERPOSITION_LHS_SUBST_TREE)) {
+    const UnificationCountSketch* sketch=static_cast<TermIndex*>(imgr->get(SUPERPOSITION_LHS_SUBST_TREE))->countSketch();
+    TermIterator rsti=EqHelper::getRewritableSubtermIterator(lit, _ord);
+    while(rsti.hasNext()) {
+      res+=sketch->estimateUnifications(rsti.next());
+    }
+  }
+  //equality resolution
+  if(lit->isNegative() && lit->isEquality()) {
+    RobSubstitution rs;
+    if(rs.unify(*lit->nthArgument(0), 0, *lit->nthArgument(1), 0)) {
+      res++;
+    }
+  }
+  return res;
+}
+
+/**
+ * Into @b candidates put the literals of the @b lits array (of length @b cnt)
+ * that have the least estimated number of generating inferences with the
+ * indexes of @b imgr
+ */
+void LookaheadLiteralSelector::leastEstimatedInferences(Literal** lits, unsigned cnt, IndexManager* imgr,
+    LiteralStack& candidates)
+{
+  CALL("LookaheadLiteralSelector::leastEstimatedInferences");
+
+  unsigned least=UINT_MAX;
+  for(unsigned i=0;i<cnt;i++) {
+    unsigned est=estimateInferences(lits[i], imgr);
+    if(est<least) {
+      least=est;
+      candidates.reset();
+    }
+    if(est==least) {
+      candidates.push(lits[i]);
+    }
+  }
+}
+
+/**
+ * Return true if all the generating indexes of @b imgr that are used
+ * for the lookahead keep count sketches
+ */
+static bool haveCountSketches(IndexManager* imgr)
+{
+  CALL("haveCountSketches");
+
+  if(imgr->contains(GENERATING_SUBST_TREE) &&
+      !static_cast<LiteralIndex*>(imgr->get(GENERATING_SUBST_TREE))->countSketch()) {
+    return false;
+  }
+  if(imgr->contains(SUPERPOSITION_SUBTERM_SUBST_TREE) &&
+      !static_cast<TermIndex*>(imgr->get(SUPERPOSITION_SUBTERM_SUBST_TREE))->countSketch()) {
+    return false;
+  }
+  if(imgr->contains(SUPERPOSITION_LHS_SUBST_TREE) &&
+      !static_cast<TermIndex*>(imgr->get(SUPERPOSITION_LHS_SUBST_TREE))->countSketch()) {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Return the literal from the @b lits array (of length @b cnt) that
+ * is the best to be selected. This selection is done irregardless any
+ * completeness constraints, the caller has to handle that, if necessary.
+ */
+Literal* LookaheadLiteralSelector::pickTheBest(Literal** lits, unsigned cnt)
+{
+  CALL("LookaheadLiteralSelector::pickTheBest");
+  ASS_G(cnt,1); //special cases are handled elsewhere
+
+  static LiteralStack candidates;
+  candidates.reset();
+
+  SaturationAlgorithm* salg=SaturationAlgorithm::tryGetInstance();
+  //the indexes are not guaranteed to keep the sketches when the selector
+  //is created with different options than the saturation algorithm
+  if(!_exact && salg && haveCountSketches(salg->getIndexManager())) {
+    leastEstimatedInferences(lits, cnt, salg->getIndexManager(), candidates);
+  }
+  else {
+    leastExactInferences(lits, cnt, candidates);
+  }
+
   using namespace LiteralComparators;
   typedef Composite<ColoredFirst,
 	    Composite<NoPositiveEquality,
@@ -232,10 +361,6 @@ Literal* LookaheadLiteralSelector::pickTheBest(Literal** lits, unsigned cnt)
       }
     }
   }
-
-  for(unsigned i=0;i<cnt;i++) {
-    runifs[i].drop(); //release the iterators
-  }
   return res;
 }
 
@@ -26,6 +26,8 @@
 
 #include "Forwards.hpp"
 
+#include "Shell/Options.hpp"
+
 #include "LiteralSelector.hpp"
 
 namespace Kernel {
@@ -38,7 +40,7 @@ public:
   USE_ALLOCATOR(LookaheadLiteralSelector);
   
   LookaheadLiteralSelector(bool completeSelection, const Ordering& ordering, const Options& options)
-  : LiteralSelector(ordering, options), _completeSelection(completeSelection) 
+  : LiteralSelector(ordering, options), _completeSelection(completeSelection), _exact(options.lookaheadExact())
   {
     _delay = options.lookaheadDelay();
     _skipped = 0;
@@ -46,16 +48,23 @@ public:
   }
 
   bool isBGComplete() const override { return _completeSelection; }
+
+  static bool usesCountSketches(const Options& options);
 protected:
   void doSelection(Clause* c, unsigned eligible) override;
 private:
   Literal* pickTheBest(Literal** lits, unsigned cnt);
   void removeVariants(LiteralStack& lits);
   VirtualIterator<void> getGeneraingInferenceIterator(Literal* lit);
+  void leastExactInferences(Literal** lits, unsigned cnt, LiteralStack& candidates);
+  void leastEstimatedInferences(Literal** lits, unsigned cnt, Indexing::IndexManager* imgr, LiteralStack& candidates);
+  unsigned estimateInferences(Literal* lit, Indexing::IndexManager* imgr);
 
   struct GenIteratorIterator;
 
   bool _completeSelection;
+  /** count the inferences exactly rather than estimating them by the index count sketches */
+  bool _exact;
   LiteralSelector* _startupSelector;
   int _delay;
   int _skipped;
@@ -998,12 +998,18 @@ Term* Term::create2(unsigned fn, TermList arg1, TermList arg2)
  */ 
 Term* Term::foolTrue(){
     static Term* _foolTrue = 0;
-    if(!_foolTrue){ _foolTrue = createConstant(env.signature->getFoolConstantSymbol(true));}
+    if(!_foolTrue){
+      _foolTrue = createConstant(env.signature->getFoolConstantSymbol(true));
+      env.sharing->makePersistent(_foolTrue);
+    }
     return _foolTrue;
   }
 Term* Term::foolFalse(){
     static Term* _foolFalse = 0;
-    if(!_foolFalse){ _foolFalse = createConstant(env.signature->getFoolConstantSymbol(false));}
+    if(!_foolFalse){
+      _foolFalse = createConstant(env.signature->getFoolConstantSymbol(false));
+      env.sharing->makePersistent(_foolFalse);
+    }
     return _foolFalse;
   }
 
@@ -1293,6 +1299,8 @@ Term::Term(const Term& t) throw()
   _args[0]._info.shared = 0u;
   _args[0]._info.order = 0u;
   _args[0]._info.distinctVars = TERM_DIST_VAR_UNKNOWN;
+  _args[0]._info.persistent = 0u;
+  _args[0]._info.gcMark = 0u;
 #if USE_MATCH_TAG
   matchTag().makeEmpty();
 #endif
@@ -1324,6 +1332,8 @@ Term::Term() throw()
   _args[0]._info.order = 0;
   _args[0]._info.tag = FUN;
   _args[0]._info.distinctVars = TERM_DIST_VAR_UNKNOWN;
+  _args[0]._info.persistent = 0;
+  _args[0]._info.gcMark = 0;
 #if USE_MATCH_TAG
   matchTag().makeEmpty();
 #endif
@@ -48,7 +48,7 @@
 
 #include "Sorts.hpp"
 
-#define TERM_DIST_VAR_UNKNOWN 0x7FFFFF
+#define TERM_DIST_VAR_UNKNOWN 0x1FFFFF
 
 namespace Kernel {
 
@@ -196,7 +196,11 @@ private:
       /** Number of distincs variables in the term, equal
        * to TERM_DIST_VAR_UNKNOWN if the number has not been
        * computed yet. */
-      mutable unsigned distinctVars : 23;
+      mutable unsigned distinctVars : 21;
+      /** true if a shared term must never be collected by TermSharing::collect */
+      unsigned persistent : 1;
+      /** mark used by TermSharing::collect, set iff the term is in use */
+      unsigned gcMark : 1;
       /** reserved for whatever */
 #if ARCH_X64
 # if USE_MATCH_TAG
@@ -48,13 +48,47 @@ using namespace Lib;
 //
 
 IntegerConstantType::IntegerConstantType(const vstring& str)
+: _val(0)
 {
   CALL("IntegerConstantType::IntegerConstantType(vstring)");
 
-  if (!Int::stringToInt(str, _val)) {
-    //TODO: raise exception only on overflow, the proper syntax should be guarded by assertion
+  BigInt* big = new BigInt();
+  if (!BigInt::fromString(str, *big)) {
+    delete big;
+    //TODO: the proper syntax should be guarded by assertion
     throw ArithmeticException();
   }
+  *this = fromBig(big);
+}
+
+/**
+ * Return the number stored in @b big, taking the ownership of @b big.
+ * The number is moved inline if it fits there.
+ */
+IntegerConstantType IntegerConstantType::fromBig(BigInt* big)
+{
+  CALL("IntegerConstantType::fromBig");
+
+  IntegerConstantType res;
+  if (big->toLongLong(res._val)) {
+    delete big;
+  }
+  else {
+    res._big = big;
+  }
+  return res;
+}
+
+/**
+ * Return the value as a BigInt, using @b tmp to hold it if it is stored inline
+ */
+const BigInt& IntegerConstantType::asBig(BigInt& tmp) const
+{
+  if (!fitsInner()) {
+    return *_big;
+  }
+  tmp = BigInt(_val);
+  return tmp;
 }
 
 IntegerConstantType IntegerConstantType::operator+(const IntegerConstantType& num) const
@@ -62,10 +96,13 @@ IntegerConstantType IntegerConstantType::operator+(const IntegerConstantType& nu
   CALL("IntegerConstantType::operator+");
 
   InnerType res;
-  if (!Int::safePlus(_val, num._val, res)) {
-    throw ArithmeticException();
+  if (fitsInner() && num.fitsInner() && !__builtin_add_overflow(_val, num._val, &res)) {
+    return IntegerConstantType(res);
   }
-  return IntegerConstantType(res);
+  BigInt tmp1, tmp2;
+  BigInt* big = new BigInt();
+  BigInt::add(asBig(tmp1), num.asBig(tmp2), *big);
+  return fromBig(big);
 }
 
 IntegerConstantType IntegerConstantType::operator-(const IntegerConstantType& num) const
@@ -73,21 +110,20 @@ IntegerConstantType IntegerConstantType::operator-(const IntegerConstantType& nu
   CALL("IntegerConstantType::operator-/1");
 
   InnerType res;
-  if (!Int::safeMinus(_val, num._val, res)) {
-    throw ArithmeticException();
+  if (fitsInner() && num.fitsInner() && !__builtin_sub_overflow(_val, num._val, &res)) {
+    return IntegerConstantType(res);
   }
-  return IntegerConstantType(res);
+  BigInt tmp1, tmp2;
+  BigInt* big = new BigInt();
+  BigInt::subtract(asBig(tmp1), num.asBig(tmp2), *big);
+  return fromBig(big);
 }
 
 IntegerConstantType IntegerConstantType::operator-() const
 {
   CALL("IntegerConstantType::operator-/0");
 
-  InnerType res;
-  if (!Int::safeUnaryMinus(_val, res)) {
-    throw ArithmeticException();
-  }
-  return IntegerConstantType(res);
+  return IntegerConstantType(0)-(*this);
 }
 
 IntegerConstantType IntegerConstantType::operator*(const IntegerConstantType& num) const
@@ -95,10 +131,38 @@ IntegerConstantType IntegerConstantType::operator*(const IntegerConstantType& nu
   CALL("IntegerConstantType::operator*");
 
   InnerType res;
-  if (!Int::safeMultiply(_val, num._val, res)) {
+  if (fitsInner() && num.fitsInner() && !__builtin_mul_overflow(_val, num._val, &res)) {
+    return IntegerConstantType(res);
+  }
+  BigInt tmp1, tmp2;
+  BigInt* big = new BigInt();
+  BigInt::multiply(asBig(tmp1), num.asBig(tmp2), *big);
+  return fromBig(big);
+}
+
+/**
+ * Divide by @b num rounding towards zero, so that @b rem has the sign
+ * of this number
+ */
+void IntegerConstantType::divide(const IntegerConstantType& num, IntegerConstantType& quot, IntegerConstantType& rem) const
+{
+  CALL("IntegerConstantType::divide");
+
+  if (num.isZero()) {
     throw ArithmeticException();
   }
-  return IntegerConstantType(res);
+  if (fitsInner() && num.fitsInner() &&
+      !(_val == numeric_limits<InnerType>::min() && num._val == -1)) {
+    quot = IntegerConstantType(_val/num._val);
+    rem = IntegerConstantType(_val%num._val);
+    return;
+  }
+  BigInt tmp1, tmp2;
+  BigInt* bigQuot = new BigInt();
+  BigInt* bigRem = new BigInt();
+  BigInt::divide(asBig(tmp1), num.asBig(tmp2), *bigQuot, *bigRem);
+  quot = fromBig(bigQuot);
+  rem = fromBig(bigRem);
 }
 
 IntegerConstantType IntegerConstantType::operator/(const IntegerConstantType& num) const
@@ -106,13 +170,9 @@ IntegerConstantType IntegerConstantType::operator/(const IntegerConstantType& nu
   CALL("IntegerConstantType::operator/");
 
   //TODO: check if division corresponds to the TPTP semantic
-  if (num._val==0) {
-    throw ArithmeticException();
-  }
-  if(_val == numeric_limits<InnerType>::min() && num._val == -1){
-    throw ArithmeticException();
-  }
-  return IntegerConstantType(_val/num._val);
+  IntegerConstantType quot, rem;
+  divide(num, quot, rem);
+  return quot;
 }
 
 IntegerConstantType IntegerConstantType::operator%(const IntegerConstantType& num) const
@@ -120,24 +180,129 @@ IntegerConstantType IntegerConstantType::operator%(const IntegerConstantType& nu
   CALL("IntegerConstantType::operator%");
 
   //TODO: check if modulo corresponds to the TPTP semantic
-  if (num._val==0) {
-    throw ArithmeticException();
+  IntegerConstantType quot, rem;
+  divide(num, quot, rem);
+  return rem;
+}
+
+bool IntegerConstantType::divides(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::divides");
+
+  // if this is zero it shouldn't divide anything, if num is zero dividing it doesn't make sense
+  if (isZero() || num.isZero()) {
+    return false;
+  }
+  return (num % (*this)).isZero();
+}
+
+/**
+ * Quotient of the Euclidean division, i.e. the one where the remainder
+ * is non-negative
+ */
+IntegerConstantType IntegerConstantType::quotientE(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::quotientE");
+
+  IntegerConstantType quot, rem;
+  divide(num, quot, rem);
+  if (rem.isNegative()) {
+    return num.isNegative() ? quot+1 : quot-1;
+  }
+  return quot;
+}
+
+/**
+ * Quotient of the division rounding towards zero
+ */
+IntegerConstantType IntegerConstantType::quotientT(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::quotientT");
+
+  return (*this)/num;
+}
+
+/**
+ * Quotient of the division rounding towards minus infinity
+ */
+IntegerConstantType IntegerConstantType::quotientF(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::quotientF");
+
+  IntegerConstantType quot, rem;
+  divide(num, quot, rem);
+  if (!rem.isZero() && rem.isNegative()!=num.isNegative()) {
+    return quot-1;
   }
-  return IntegerConstantType(_val%num._val);
+  return quot;
 }
 
 bool IntegerConstantType::operator==(const IntegerConstantType& num) const
 {
   CALL("IntegerConstantType::operator==");
 
-  return _val==num._val;
+  if (fitsInner() || num.fitsInner()) {
+    // the representation is canonical
+    return fitsInner() && num.fitsInner() && _val==num._val;
+  }
+  return BigInt::compare(*_big, *num._big)==0;
 }
 
 bool IntegerConstantType::operator>(const IntegerConstantType& num) const
 {
   CALL("IntegerConstantType::operator>");
 
-  return _val>num._val;
+  if (fitsInner() && num.fitsInner()) {
+    return _val>num._val;
+  }
+  BigInt tmp1, tmp2;
+  return BigInt::compare(asBig(tmp1), num.asBig(tmp2))>0;
+}
+
+double IntegerConstantType::toDouble() const
+{
+  CALL("IntegerConstantType::toDouble");
+
+  return fitsInner() ? static_cast<double>(_val) : _big->toDouble();
+}
+
+/**
+ * Return the binary logarithm of the absolute value rounded down, or zero
+ * for zero
+ */
+unsigned IntegerConstantType::log2Abs() const
+{
+  CALL("IntegerConstantType::log2Abs");
+
+  if (!fitsInner()) {
+    return _big->bitLength()-1;
+  }
+  if (_val==0) {
+    return 0;
+  }
+  unsigned long long mag = _val<0 ? 0ull-static_cast<unsigned long long>(_val) : _val;
+  return 63-__builtin_clzll(mag);
+}
+
+/**
+ * Return the greatest common divisor of @b n1 and @b n2, or one if
+ * any of them is zero
+ */
+IntegerConstantType IntegerConstantType::gcd(const IntegerConstantType& n1, const IntegerConstantType& n2)
+{
+  CALL("IntegerConstantType::gcd");
+
+  if (n1.isZero() || n2.isZero()) {
+    return IntegerConstantType(1);
+  }
+  IntegerConstantType a = n1.abs();
+  IntegerConstantType b = n2.abs();
+  while (!b.isZero()) {
+    IntegerConstantType r = a%b;
+    a = b;
+    b = r;
+  }
+  return a;
 }
 
 IntegerConstantType IntegerConstantType::floor(RationalConstantType rat)
@@ -180,43 +345,30 @@ IntegerConstantType IntegerConstantType::ceiling(RationalConstantType rat)
   return res;
 }
 
+/**
+ * Numbers are ordered by their absolute value, a negative number being
+ * greater than the positive one with the same absolute value
+ */
 Comparison IntegerConstantType::comparePrecedence(IntegerConstantType n1, IntegerConstantType n2)
 {
   CALL("IntegerConstantType::comparePrecedence");
-  try {
-    if (n1 == numeric_limits<InnerType>::min()) {
-      if (n2 == numeric_limits<InnerType>::min()) {
-        return EQUAL;
-      } else {
-        return GREATER;
-      }
-    } else {
-      if (n2 == numeric_limits<InnerType>::min()) {
-        return LESS;
-      } else {
-        InnerType an1 = abs(n1.toInner());
-        InnerType an2 = abs(n2.toInner());
-
-        ASS_GE(an1,0);
-        ASS_GE(an2,0);
-
-        return an1 < an2 ? LESS : (an1 == an2 ? // compare the signed ones, making negative greater than positive
-            static_cast<Comparison>(-Int::compare(n1.toInner(), n2.toInner()))
-                              : GREATER);
-      }
-    }
+
+  if (n1==n2) {
+    return EQUAL;
   }
-  catch(ArithmeticException) {
-    ASSERTION_VIOLATION;
-    throw;
+  IntegerConstantType an1 = n1.abs();
+  IntegerConstantType an2 = n2.abs();
+  if (an1==an2) {
+    return n1.isNegative() ? GREATER : LESS;
   }
+  return an1 < an2 ? LESS : GREATER;
 }
 
 vstring IntegerConstantType::toString() const
 {
   CALL("IntegerConstantType::toString");
 
-  return Int::toString(_val);
+  return fitsInner() ? Int::toString(_val) : _big->toString();
 }
 
 ///////////////////////
@@ -253,7 +405,7 @@ void RationalConstantType::init(InnerType num, InnerType den)
   cannonize();
 
   // Dividing by zero is bad!
-  if(_den.toInner()==0) throw ArithmeticException();
+  if(_den.isZero()) throw ArithmeticException();
 }
 
 RationalConstantType RationalConstantType::operator+(const RationalConstantType& o) const
@@ -335,7 +487,7 @@ void RationalConstantType::cannonize()
 {
   CALL("RationalConstantType::cannonize");
 
-  InnerType gcd = Int::gcd(_num.toInner(), _den.toInner());
+  InnerType gcd = InnerType::gcd(_num, _den);
   if (gcd!=1) {
     _num = _num/gcd;
     _den = _den/gcd;
@@ -353,56 +505,18 @@ void RationalConstantType::cannonize()
 Comparison RationalConstantType::comparePrecedence(RationalConstantType n1, RationalConstantType n2)
 {
   CALL("RationalConstantType::comparePrecedence");
-  try {
-
-    if (n1==n2) { return EQUAL; }
-
-    bool haveRepr1 = true;
-    bool haveRepr2 = true;
 
-    IntegerConstantType repr1, repr2;
+  if (n1==n2) { return EQUAL; }
 
-    try {
-      repr1 = n1.numerator()+n1.denominator();
-    } catch(ArithmeticException) {
-      haveRepr1 = false;
-    }
-
-    try {
-      repr2 = n2.numerator()+n2.denominator();
-    } catch(ArithmeticException) {
-      haveRepr2 = false;
-    }
+  IntegerConstantType repr1 = n1.numerator()+n1.denominator();
+  IntegerConstantType repr2 = n2.numerator()+n2.denominator();
 
-    if (haveRepr1 && haveRepr2) {
-      Comparison res = IntegerConstantType::comparePrecedence(repr1, repr2);
-      if (res==EQUAL) {
-	res = IntegerConstantType::comparePrecedence(n1.numerator(), n2.numerator());
-      }
-      ASS_NEQ(res, EQUAL);
-      return res;
-    }
-    if (haveRepr1 && !haveRepr2) {
-      return LESS;
-    }
-    if (!haveRepr1 && haveRepr2) {
-      return GREATER;
-    }
-
-    ASS(!haveRepr1);
-    ASS(!haveRepr2);
-
-    Comparison res = IntegerConstantType::comparePrecedence(n1.denominator(), n2.denominator());
-    if (res==EQUAL) {
-      res = IntegerConstantType::comparePrecedence(n1.numerator(), n2.numerator());
-    }
-    ASS_NEQ(res, EQUAL);
-    return res;
-  }
-  catch(ArithmeticException) {
-    ASSERTION_VIOLATION;
-    throw;
+  Comparison res = IntegerConstantType::comparePrecedence(repr1, repr2);
+  if (res==EQUAL) {
+    res = IntegerConstantType::comparePrecedence(n1.numerator(), n2.numerator());
   }
+  ASS_NEQ(res, EQUAL);
+  return res;
 }
 
 
@@ -484,6 +598,10 @@ RealConstantType::RealConstantType(const vstring& number)
     numDbl *= 10;
   }
 
+  if (!(::fabs(numDbl) < 9223372036854775808.0)) {
+    //the numerator part of double doesn't fit inside the inner integer type
+    throw ArithmeticException();
+  }
   InnerType::InnerType numerator = static_cast<InnerType::InnerType>(numDbl);
   if (numerator!=numDbl) {
     //the numerator part of double doesn't fit inside the inner integer type
@@ -496,10 +614,10 @@ vstring RealConstantType::toNiceString() const
 {
   CALL("RealConstantType::toNiceString");
 
-  if (denominator().toInner()==1) {
+  if (denominator()==1) {
     return numerator().toString()+".0";
   }
-  float frep = (float) numerator().toInner() /(float) denominator().toInner();
+  float frep = (float) numerator().toDouble() /(float) denominator().toDouble();
   return Int::toString(frep);
   //return toString();
 }
@@ -28,8 +28,10 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/BigInt.hpp"
 #include "Lib/DHMap.hpp"
 #include "Lib/Exception.hpp"
+#include "Lib/RCPtr.hpp"
 
 #include "Shell/TermAlgebra.hpp"
 
@@ -40,18 +42,27 @@ namespace Kernel {
 
 /**
  * Exception to be thrown when the requested operation cannot be performed,
- * e.g. because of overflow of a native type.
+ * e.g. because of division by zero.
  */
 class ArithmeticException : public ThrowableBase {};
 
+/**
+ * A class for representing integers
+ *
+ * Numbers that fit into InnerType are stored inline and operations on
+ * them are done natively. When the result of an operation does not fit,
+ * it is stored in a shared BigInt instead, so that the arithmetic
+ * operations never overflow. The representation is canonical: a number
+ * is stored in a BigInt only if it does not fit into InnerType.
+ */
 class IntegerConstantType
 {
 public:
   static unsigned getSort() { return Sorts::SRT_INTEGER; }
 
-  typedef int InnerType;
+  typedef long long InnerType;
 
-  IntegerConstantType() {}
+  IntegerConstantType() : _val(0) {}
   IntegerConstantType(InnerType v) : _val(v) {}
   explicit IntegerConstantType(const vstring& str);
 
@@ -63,52 +74,11 @@ public:
   IntegerConstantType operator%(const IntegerConstantType& num) const;
 
   // true if this divides num
-  bool divides(const IntegerConstantType& num) const {
-    CALL("IntegerConstantType:divides");
-    // if this is zero it shouldn't divide anything, if num is zero dividing it doesn't make sense
-    if(_val==0 || num._val==0){ return false; }
-    // if this is bigger than num then the result cannot be an integer
-    if(_val > num._val){ return false; }
-    // now we only need to check the absolute value
-    int safeVal=_val;
-    if (_val < 0 && ! Lib::Int::safeUnaryMinus<int>(_val,safeVal)) {
-      return false;
-    }
-    return (num._val % safeVal ==0);
-  }
+  bool divides(const IntegerConstantType& num) const;
 
-  float realDivide(const IntegerConstantType& num) const { 
-    if(num._val==0) throw ArithmeticException();
-    return ((float)_val)/num._val; 
-  }
-  int intDivide(const IntegerConstantType& num) const {
-      CALL("IntegerConstantType::intDivide");
-      ASS(num.divides(*this));
-      if(num._val==0){ throw ArithmeticException(); }
-      return _val/num._val;
-  }
-  // TODO: shouldn't we always be using intDivide for quotientE - when are they different (apart from real rounding)?
-  IntegerConstantType quotientE(const IntegerConstantType& num) const { 
-    CALL("IntegerConstantType::quotientE");
-    //cout << "quotientE " << _val << " and " << num._val << endl;
-    if(num.divides(*this)){
-      return IntegerConstantType(intDivide(num));
-    }
-    if(num._val>0) return IntegerConstantType(::floor(realDivide(num)));
-    else return IntegerConstantType(::ceil(realDivide(num)));
-  }
-  IntegerConstantType quotientT(const IntegerConstantType& num) const { 
-    if(num.divides(*this)){
-      return IntegerConstantType(intDivide(num));
-    }
-    return IntegerConstantType(::trunc(realDivide(num)));
-  }
-  IntegerConstantType quotientF(const IntegerConstantType& num) const { 
-    if(num.divides(*this)){
-      return IntegerConstantType(intDivide(num));
-    }
-    return IntegerConstantType(::floor(realDivide(num)));
-  }
+  IntegerConstantType quotientE(const IntegerConstantType& num) const;
+  IntegerConstantType quotientT(const IntegerConstantType& num) const;
+  IntegerConstantType quotientF(const IntegerConstantType& num) const;
 
   bool operator==(const IntegerConstantType& num) const;
   bool operator>(const IntegerConstantType& num) const;
@@ -118,10 +88,17 @@ public:
   bool operator>=(const IntegerConstantType& o) const { return !(o>(*this)); }
   bool operator<=(const IntegerConstantType& o) const { return !((*this)>o); }
 
-  InnerType toInner() const { return _val; }
+  /** True if the number can be retrieved by toInner() */
+  bool fitsInner() const { return _big.isEmpty(); }
+  InnerType toInner() const { ASS(fitsInner()); return _val; }
+  double toDouble() const;
+
+  bool isZero() const { return fitsInner() && _val==0; }
+  bool isNegative() const { return fitsInner() ? _val<0 : _big->isNegative(); }
+  IntegerConstantType abs() const { return isNegative() ? -(*this) : *this; }
+  unsigned log2Abs() const;
 
-  bool isZero(){ return _val==0; }
-  bool isNegative(){ return _val<0; }
+  static IntegerConstantType gcd(const IntegerConstantType& n1, const IntegerConstantType& n2);
 
   static IntegerConstantType floor(RationalConstantType rat);
   static IntegerConstantType ceiling(RationalConstantType rat);
@@ -130,20 +107,25 @@ public:
 
   vstring toString() const;
 private:
+  static IntegerConstantType fromBig(BigInt* big);
+  const BigInt& asBig(BigInt& tmp) const;
+  void divide(const IntegerConstantType& num, IntegerConstantType& quot, IntegerConstantType& rem) const;
+
+  /** the value if @b _big is empty */
   InnerType _val;
+  RCPtr<BigInt> _big;
 };
 
 inline
 std::ostream& operator<< (ostream& out, const IntegerConstantType& val) {
-  return out << val.toInner();
+  return out << val.toString();
 }
 
 /**
  * A class for representing rational numbers
  *
- * The class uses IntegerConstantType to store the numerator and denominator.
- * This ensures that if there is an overflow in the operations, an exception
- * will be raised by the IntegerConstantType methods.
+ * The class uses IntegerConstantType to store the numerator and denominator,
+ * so the operations do not overflow.
  */
 struct RationalConstantType {
   typedef IntegerConstantType InnerType;
@@ -182,12 +164,12 @@ struct RationalConstantType {
   bool operator>=(const RationalConstantType& o) const { return !(o>(*this)); }
   bool operator<=(const RationalConstantType& o) const { return !((*this)>o); }
 
-  bool isZero(){ return _num.toInner()==0; } 
+  bool isZero(){ return _num.isZero(); } 
   // relies on the fact that cannonize ensures that _den>=0
-  bool isNegative(){ ASS(_den>=0); return _num.toInner() < 0; }
+  bool isNegative(){ ASS(_den>=0); return _num.isNegative(); }
 
   RationalConstantType quotientE(const RationalConstantType& num) const {
-    if(_num.toInner()>0 && _den.toInner()>0){
+    if(_num>0 && _den>0){
        return ((*this)/num).floor(); 
     }
     else return ((*this)/num).ceiling();
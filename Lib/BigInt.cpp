@@ -0,0 +1,429 @@
+
+/*
+ * File BigInt.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file BigInt.cpp
+ * Implements class BigInt of arbitrary-precision integers.
+ *
+ * The division is the algorithm D of Knuth (TAOCP vol. 2, 4.3.1).
+ */
+
+#include <cstdio>
+
+#include "Debug/Tracer.hpp"
+
+#include "BigInt.hpp"
+
+namespace Lib {
+
+typedef unsigned long long Wide;
+
+BigInt::BigInt(long long val)
+: _neg(val<0), _refCnt(0)
+{
+  CALL("BigInt::BigInt");
+
+  Wide mag = val<0 ? Wide(0)-Wide(val) : Wide(val);
+  while(mag) {
+    _digits.push(static_cast<unsigned>(mag));
+    mag >>= 32;
+  }
+}
+
+/**
+ * Read a decimal number with an optional sign into @b res.
+ * Return false if @b str is not such a number.
+ */
+bool BigInt::fromString(const vstring& str, BigInt& res)
+{
+  CALL("BigInt::fromString");
+
+  size_t i = 0;
+  bool neg = false;
+  if(i<str.size() && (str[i]=='-' || str[i]=='+')) {
+    neg = str[i]=='-';
+    i++;
+  }
+  if(i==str.size()) {
+    return false;
+  }
+  res._digits.reset();
+  // digits are added in groups of nine, which still fit a 32-bit digit
+  while(i<str.size()) {
+    unsigned chunk = 0;
+    unsigned mul = 1;
+    for(unsigned j=0; j<9 && i<str.size(); j++, i++) {
+      char c = str[i];
+      if(c<'0' || c>'9') {
+        return false;
+      }
+      chunk = chunk*10 + (c-'0');
+      mul *= 10;
+    }
+    multiplyAddSmall(res._digits, mul, chunk);
+  }
+  res._neg = neg && !res.isZero();
+  return true;
+}
+
+/**
+ * If the number fits into long long, assign it to @b res and return true.
+ */
+bool BigInt::toLongLong(long long& res) const
+{
+  CALL("BigInt::toLongLong");
+
+  if(_digits.size()>2) {
+    return false;
+  }
+  Wide mag = 0;
+  for(size_t i=_digits.size(); i>0; i--) {
+    mag = (mag<<32) | _digits[i-1];
+  }
+  const Wide limit = Wide(1)<<63;
+  if(_neg) {
+    if(mag>limit) {
+      return false;
+    }
+    res = mag==limit ? -static_cast<long long>(limit-1)-1 : -static_cast<long long>(mag);
+  }
+  else {
+    if(mag>=limit) {
+      return false;
+    }
+    res = static_cast<long long>(mag);
+  }
+  return true;
+}
+
+double BigInt::toDouble() const
+{
+  CALL("BigInt::toDouble");
+
+  double res = 0;
+  for(size_t i=_digits.size(); i>0; i--) {
+    res = res*4294967296.0 + _digits[i-1];
+  }
+  return _neg ? -res : res;
+}
+
+/**
+ * Return the number of bits of the magnitude, zero having none
+ */
+unsigned BigInt::bitLength() const
+{
+  if(isZero()) {
+    return 0;
+  }
+  return (_digits.size()-1)*32 + (32-__builtin_clz(_digits.top()));
+}
+
+vstring BigInt::toString() const
+{
+  CALL("BigInt::toString");
+
+  if(isZero()) {
+    return "0";
+  }
+  // produce groups of nine decimal digits, the least significant first
+  Digits mag(_digits);
+  Stack<unsigned> groups;
+  while(mag.isNonEmpty()) {
+    groups.push(divideBySmall(mag, 1000000000));
+  }
+  vstring res = _neg ? "-" : "";
+  char buf[16];
+  sprintf(buf, "%u", groups.pop());
+  res += buf;
+  while(groups.isNonEmpty()) {
+    sprintf(buf, "%09u", groups.pop());
+    res += buf;
+  }
+  return res;
+}
+
+void BigInt::add(const BigInt& a, const BigInt& b, BigInt& res)
+{
+  CALL("BigInt::add");
+
+  addSigned(a, b, b._neg, res);
+}
+
+void BigInt::subtract(const BigInt& a, const BigInt& b, BigInt& res)
+{
+  CALL("BigInt::subtract");
+
+  addSigned(a, b, !b._neg && !b.isZero(), res);
+}
+
+/**
+ * Assign to @b res the sum of @b a and of the magnitude of @b b with
+ * the sign @b bNeg.
+ */
+void BigInt::addSigned(const BigInt& a, const BigInt& b, bool bNeg, BigInt& res)
+{
+  ASS_NEQ(&res, &a);
+  ASS_NEQ(&res, &b);
+
+  if(a._neg==bNeg) {
+    addMagnitudes(a._digits, b._digits, res._digits);
+    res._neg = bNeg;
+  }
+  else if(compareMagnitudes(a._digits, b._digits)>=0) {
+    subtractMagnitudes(a._digits, b._digits, res._digits);
+    res._neg = a._neg;
+  }
+  else {
+    subtractMagnitudes(b._digits, a._digits, res._digits);
+    res._neg = bNeg;
+  }
+  res._neg = res._neg && !res.isZero();
+}
+
+void BigInt::multiply(const BigInt& a, const BigInt& b, BigInt& res)
+{
+  CALL("BigInt::multiply");
+  ASS_NEQ(&res, &a);
+  ASS_NEQ(&res, &b);
+
+  multiplyMagnitudes(a._digits, b._digits, res._digits);
+  res._neg = a._neg!=b._neg && !res.isZero();
+}
+
+/**
+ * Divide @b a by a non-zero @b b rounding towards zero, so that
+ * @b rem has the sign of @b a, as the / and % operators of C++ do.
+ */
+void BigInt::divide(const BigInt& a, const BigInt& b, BigInt& quot, BigInt& rem)
+{
+  CALL("BigInt::divide");
+  ASS(!b.isZero());
+  ASS_NEQ(&quot, &rem);
+
+  divideMagnitudes(a._digits, b._digits, quot._digits, rem._digits);
+  quot._neg = a._neg!=b._neg && !quot.isZero();
+  rem._neg = a._neg && !rem.isZero();
+}
+
+int BigInt::compare(const BigInt& a, const BigInt& b)
+{
+  CALL("BigInt::compare");
+
+  if(a._neg!=b._neg) {
+    return a._neg ? -1 : 1;
+  }
+  int res = compareMagnitudes(a._digits, b._digits);
+  return a._neg ? -res : res;
+}
+
+void BigInt::normalize(Digits& d)
+{
+  while(d.isNonEmpty() && d.top()==0) {
+    d.pop();
+  }
+}
+
+int BigInt::compareMagnitudes(const Digits& a, const Digits& b)
+{
+  if(a.size()!=b.size()) {
+    return a.size()<b.size() ? -1 : 1;
+  }
+  for(size_t i=a.size(); i>0; i--) {
+    if(a[i-1]!=b[i-1]) {
+      return a[i-1]<b[i-1] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+void BigInt::addMagnitudes(const Digits& a, const Digits& b, Digits& res)
+{
+  const Digits& longer = a.size()>=b.size() ? a : b;
+  const Digits& shorter = a.size()>=b.size() ? b : a;
+
+  res.reset();
+  Wide carry = 0;
+  for(size_t i=0; i<longer.size(); i++) {
+    Wide cur = carry + longer[i] + (i<shorter.size() ? shorter[i] : 0);
+    res.push(static_cast<unsigned>(cur));
+    carry = cur>>32;
+  }
+  if(carry) {
+    res.push(static_cast<unsigned>(carry));
+  }
+}
+
+/**
+ * Assign |a|-|b| to @b res, where |a|>=|b|
+ */
+void BigInt::subtractMagnitudes(const Digits& a, const Digits& b, Digits& res)
+{
+  ASS_GE(compareMagnitudes(a, b), 0);
+
+  res.reset();
+  Wide borrow = 0;
+  for(size_t i=0; i<a.size(); i++) {
+    Wide sub = borrow + (i<b.size() ? b[i] : 0);
+    Wide cur = a[i];
+    borrow = cur<sub;
+    res.push(static_cast<unsigned>(cur - sub + (borrow<<32)));
+  }
+  ASS_EQ(borrow, 0);
+  normalize(res);
+}
+
+void BigInt::multiplyMagnitudes(const Digits& a, const Digits& b, Digits& res)
+{
+  res.reset();
+  if(a.isEmpty() || b.isEmpty()) {
+    return;
+  }
+  for(size_t i=0; i<a.size()+b.size(); i++) {
+    res.push(0);
+  }
+  for(size_t i=0; i<a.size(); i++) {
+    Wide carry = 0;
+    for(size_t j=0; j<b.size(); j++) {
+      Wide cur = Wide(a[i])*b[j] + res[i+j] + carry;
+      res[i+j] = static_cast<unsigned>(cur);
+      carry = cur>>32;
+    }
+    res[i+b.size()] = static_cast<unsigned>(carry);
+  }
+  normalize(res);
+}
+
+/**
+ * Divide @b a by the small non-zero number @b d in place and return
+ * the remainder
+ */
+unsigned BigInt::divideBySmall(Digits& a, unsigned d)
+{
+  ASS_G(d,0);
+
+  Wide rem = 0;
+  for(size_t i=a.size(); i>0; i--) {
+    Wide cur = (rem<<32) | a[i-1];
+    a[i-1] = static_cast<unsigned>(cur/d);
+    rem = cur%d;
+  }
+  normalize(a);
+  return static_cast<unsigned>(rem);
+}
+
+/**
+ * Assign a*m+add to @b a
+ */
+void BigInt::multiplyAddSmall(Digits& a, unsigned m, unsigned add)
+{
+  Wide carry = add;
+  for(size_t i=0; i<a.size(); i++) {
+    Wide cur = Wide(a[i])*m + carry;
+    a[i] = static_cast<unsigned>(cur);
+    carry = cur>>32;
+  }
+  if(carry) {
+    a.push(static_cast<unsigned>(carry));
+  }
+}
+
+void BigInt::divideMagnitudes(const Digits& a, const Digits& b, Digits& quot, Digits& rem)
+{
+  ASS(b.isNonEmpty());
+
+  quot.reset();
+  rem.reset();
+  if(compareMagnitudes(a, b)<0) {
+    rem = a;
+    return;
+  }
+  size_t n = b.size();
+  size_t m = a.size()-n;
+  for(size_t i=0; i<=m; i++) {
+    quot.push(0);
+  }
+  if(n==1) {
+    quot = a;
+    unsigned r = divideBySmall(quot, b[0]);
+    if(r) {
+      rem.push(r);
+    }
+    return;
+  }
+
+  // D1: normalize so that the top digit of the divisor has its highest bit set
+  unsigned s = __builtin_clz(b[n-1]);
+  Digits bn;
+  for(size_t i=0; i<n; i++) {
+    bn.push(static_cast<unsigned>((Wide(b[i])<<s) | (i ? Wide(b[i-1])>>(32-s) : 0)));
+  }
+  Digits an;
+  for(size_t i=0; i<a.size(); i++) {
+    an.push(static_cast<unsigned>((Wide(a[i])<<s) | (i ? Wide(a[i-1])>>(32-s) : 0)));
+  }
+  an.push(static_cast<unsigned>(Wide(a[a.size()-1])>>(32-s)));
+
+  const Wide base = Wide(1)<<32;
+  for(size_t j=m+1; j>0; j--) {
+    size_t k = j-1;
+    // D3: estimate the quotient digit
+    Wide num = (Wide(an[k+n])<<32) | an[k+n-1];
+    Wide qhat = num/bn[n-1];
+    Wide rhat = num%bn[n-1];
+    while(qhat>=base || qhat*bn[n-2] > ((rhat<<32) | an[k+n-2])) {
+      qhat--;
+      rhat += bn[n-1];
+      if(rhat>=base) {
+        break;
+      }
+    }
+    // D4: multiply and subtract
+    long long t;
+    long long borrow = 0;
+    for(size_t i=0; i<n; i++) {
+      Wide p = qhat*bn[i];
+      t = static_cast<long long>(an[i+k]) - borrow - static_cast<long long>(p & 0xFFFFFFFFULL);
+      an[i+k] = static_cast<unsigned>(t);
+      borrow = static_cast<long long>(p>>32) - (t>>32);
+    }
+    t = static_cast<long long>(an[k+n]) - borrow;
+    an[k+n] = static_cast<unsigned>(t);
+
+    // D5, D6: the estimate was one too large, add the divisor back
+    if(t<0) {
+      qhat--;
+      Wide carry = 0;
+      for(size_t i=0; i<n; i++) {
+        Wide cur = Wide(an[i+k]) + bn[i] + carry;
+        an[i+k] = static_cast<unsigned>(cur);
+        carry = cur>>32;
+      }
+      an[k+n] = static_cast<unsigned>(an[k+n] + carry);
+    }
+    quot[k] = static_cast<unsigned>(qhat);
+  }
+  normalize(quot);
+
+  // D8: unnormalize the remainder
+  for(size_t i=0; i<n; i++) {
+    rem.push(static_cast<unsigned>((Wide(an[i])>>s) | ((Wide(an[i+1])<<(32-s)) & 0xFFFFFFFFULL)));
+  }
+  normalize(rem);
+}
+
+}
@@ -0,0 +1,110 @@
+
+/*
+ * File BigInt.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file BigInt.hpp
+ * Defines class BigInt of arbitrary-precision integers.
+ */
+
+#ifndef __BigInt__
+#define __BigInt__
+
+#include "Debug/Assertion.hpp"
+
+#include "Allocator.hpp"
+#include "Stack.hpp"
+#include "VString.hpp"
+
+namespace Lib {
+
+/**
+ * Arbitrary-precision signed integer
+ *
+ * The magnitude is a sequence of 32-bit digits, the least significant
+ * first, without leading zero digits, so that zero has no digits at all.
+ * The arithmetic operations store their result in an object distinct from
+ * their arguments.
+ *
+ * The objects carry a reference counter, so that they can be shared
+ * through RCPtr. They are not meant to be used for numbers that fit into
+ * a machine integer, Kernel::IntegerConstantType keeps those inline.
+ */
+class BigInt
+{
+public:
+  CLASS_NAME(BigInt);
+  USE_ALLOCATOR(BigInt);
+
+  BigInt() : _neg(false), _refCnt(0) {}
+  explicit BigInt(long long val);
+  BigInt(const BigInt& o) : _digits(o._digits), _neg(o._neg), _refCnt(0) {}
+  BigInt& operator=(const BigInt& o)
+  {
+    _digits = o._digits;
+    _neg = o._neg;
+    return *this;
+  }
+
+  static bool fromString(const vstring& str, BigInt& res);
+
+  bool isZero() const { return _digits.isEmpty(); }
+  bool isNegative() const { return _neg; }
+  void negate() { _neg = !_neg && !isZero(); }
+
+  bool toLongLong(long long& res) const;
+  double toDouble() const;
+  unsigned bitLength() const;
+  vstring toString() const;
+
+  static void add(const BigInt& a, const BigInt& b, BigInt& res);
+  static void subtract(const BigInt& a, const BigInt& b, BigInt& res);
+  static void multiply(const BigInt& a, const BigInt& b, BigInt& res);
+  static void divide(const BigInt& a, const BigInt& b, BigInt& quot, BigInt& rem);
+  static int compare(const BigInt& a, const BigInt& b);
+
+  void incRefCnt() { _refCnt++; }
+  void decRefCnt()
+  {
+    ASS_G(_refCnt,0);
+    _refCnt--;
+    if(!_refCnt) {
+      delete this;
+    }
+  }
+
+private:
+  typedef Stack<unsigned> Digits;
+
+  static void normalize(Digits& d);
+  static int compareMagnitudes(const Digits& a, const Digits& b);
+  static void addMagnitudes(const Digits& a, const Digits& b, Digits& res);
+  static void subtractMagnitudes(const Digits& a, const Digits& b, Digits& res);
+  static void multiplyMagnitudes(const Digits& a, const Digits& b, Digits& res);
+  static void divideMagnitudes(const Digits& a, const Digits& b, Digits& quot, Digits& rem);
+  static unsigned divideBySmall(Digits& a, unsigned d);
+  static void multiplyAddSmall(Digits& a, unsigned m, unsigned add);
+  static void addSigned(const BigInt& a, const BigInt& b, bool bNeg, BigInt& res);
+
+  Digits _digits;
+  bool _neg;
+  unsigned _refCnt;
+};
+
+}
+
+#endif // __BigInt__
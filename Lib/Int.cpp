@@ -83,6 +83,15 @@ vstring Int::toString(long l)
   return result;
 } // Int::toString
 
+vstring Int::toString(long long l)
+{
+  char tmp [256];
+  sprintf(tmp,"%lld",l);
+  vstring result(tmp);
+
+  return result;
+} // Int::toString
+
 
 /**
  * Return the string representation of an unsigned integer.
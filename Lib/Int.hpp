@@ -54,6 +54,7 @@ class Int
   static vstring toString(unsigned i);
   static vstring toString(unsigned long i);
   static vstring toString(long l);
+  static vstring toString(long long l);
   /** Return the vstring representation of a float */
   static vstring toString(float f) { return toString((double)f); }
   static vstring toString(double d);
@@ -230,12 +230,20 @@ void Multiprocessing::killNoCheck(pid_t child, int signal)
   ::kill(child, signal);
 }
 
-pid_t Multiprocessing::poll_children(bool &stopped, bool &exited, int &code)
+/**
+ * Wait for a child to terminate or stop and return its pid. If @b block
+ * is false and no child has changed its state, return 0 right away.
+ */
+pid_t Multiprocessing::poll_children(bool &stopped, bool &exited, int &code, bool block)
 {
   CALL("Multiprocessing::poll_child");
 
   int status;
-  pid_t pid = waitpid(-1, &status, WUNTRACED);
+  pid_t pid = waitpid(-1, &status, block ? WUNTRACED : (WUNTRACED | WNOHANG));
+  if(!block && pid <= 0)
+  {
+    return 0;
+  }
   stopped = WIFSTOPPED(status);
   exited = WIFEXITED(status);
   if(exited)
@@ -368,6 +368,20 @@ void System::registerForSIGHUPOnParentDeath()
 #endif
 }
 
+/**
+ * Make the orphaned descendants of this process become its children
+ * (so that it can wait for them) instead of children of the init process.
+ * Return false if this is not supported by the system.
+ */
+bool System::registerAsChildSubreaper()
+{
+#if __APPLE__ || __CYGWIN__ || !defined(PR_SET_CHILD_SUBREAPER)
+  return false;
+#else
+  return prctl(PR_SET_CHILD_SUBREAPER, 1) == 0;
+#endif
+}
+
 /**
  * Read command line arguments into @c res and register the executable name
  * (0-th element of @c argv) using the @c registerArgv0() function.
@@ -72,6 +72,7 @@ public:
   static void terminateImmediately(int resultStatus) __attribute__((noreturn));
 
   static void registerForSIGHUPOnParentDeath();
+  static bool registerAsChildSubreaper();
 
   static void readCmdArgs(int argc, char* argv[], StringStack& res);
 
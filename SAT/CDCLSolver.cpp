@@ -0,0 +1,1276 @@
+/*
+ * File CDCLSolver.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CDCLSolver.cpp
+ * Implements class CDCLSolver.
+ */
+
+#include <algorithm>
+
+#include "Debug/RuntimeStatistics.hpp"
+
+#include "CDCLSolver.hpp"
+
+namespace SAT
+{
+
+using namespace Lib;
+
+CDCLSolver::Clause* CDCLSolver::Clause::create(const Lit* lits, unsigned size, bool learnt)
+{
+  CALL("CDCLSolver::Clause::create");
+
+  size_t bytes = sizeof(Clause) + sizeof(Lit)*(size ? size-1 : 0);
+  Clause* res = static_cast<Clause*>(ALLOC_UNKNOWN(bytes, "CDCLSolver::Clause"));
+
+  res->size = size;
+  res->lbd = size;
+  res->learnt = learnt;
+  res->removed = 0;
+  res->used = 0;
+  res->vivified = 0;
+  res->activity = 0;
+  for (unsigned i = 0; i < size; i++) {
+    res->lits[i] = lits[i];
+  }
+  return res;
+}
+
+void CDCLSolver::Clause::destroy()
+{
+  CALL("CDCLSolver::Clause::destroy");
+
+  DEALLOC_UNKNOWN(this, "CDCLSolver::Clause");
+}
+
+CDCLSolver::CDCLSolver(const Options& opt, bool generateProofs)
+: _varCnt(0), _ok(true), _status(SATISFIABLE), _qhead(0), _varInc(1), _clauseInc(1),
+  _stamp(0), _fastLbd(0), _lbdSum(0), _conflicts(0), _learntCnt(0), _conflictsAtRestart(0),
+  _nextReduce(FIRST_REDUCE), _reduceCnt(0), _propagations(0), _conflictsAtVivify(0),
+  _simplifiedTrailSize(0)
+{
+  CALL("CDCLSolver::CDCLSolver");
+
+  // slot 0 for the unused variable 0
+  ensureVarCount(0);
+}
+
+CDCLSolver::~CDCLSolver()
+{
+  CALL("CDCLSolver::~CDCLSolver");
+
+  Stack<Clause*>::Iterator cit(_clauses);
+  while (cit.hasNext()) {
+    cit.next()->destroy();
+  }
+  Stack<Clause*>::Iterator lit(_learnts);
+  while (lit.hasNext()) {
+    lit.next()->destroy();
+  }
+}
+
+void CDCLSolver::ensureVarCount(unsigned newVarCnt)
+{
+  CALL("CDCLSolver::ensureVarCount");
+
+  if (newVarCnt < _varCnt) {
+    return;
+  }
+  unsigned oldVarCnt = _varCnt;
+  _varCnt = newVarCnt;
+
+  _values.expand(_varCnt+1, V_UNDEF);
+  _levels.expand(_varCnt+1, 0);
+  _reasons.expand(_varCnt+1, 0);
+  _phase.expand(_varCnt+1, 0);
+  _seen.expand(_varCnt+1, 0);
+  _activity.expand(_varCnt+1, 0);
+  _heapPos.expand(_varCnt+1, 0);
+  _model.expand(_varCnt+1, V_UNDEF);
+  _levelStamps.expand(_varCnt+1, 0);
+  _watches.expand(2*_varCnt+2);
+
+  for (unsigned v = oldVarCnt+1; v <= _varCnt; v++) {
+    heapInsert(v);
+  }
+}
+
+unsigned CDCLSolver::newVar()
+{
+  CALL("CDCLSolver::newVar");
+
+  ensureVarCount(_varCnt+1);
+  return _varCnt;
+}
+
+void CDCLSolver::addAssumption(SATLiteral lit)
+{
+  CALL("CDCLSolver::addAssumption");
+  ASS_G(lit.var(),0); ASS_LE(lit.var(),_varCnt);
+
+  _assumptions.push(lit.content());
+}
+
+void CDCLSolver::retractAllAssumptions()
+{
+  CALL("CDCLSolver::retractAllAssumptions");
+
+  _assumptions.reset();
+  _status = UNKNOWN;
+}
+
+/**
+ * Add clause into the solver.
+ *
+ * Clauses are only ever added on the level zero, between the calls to solve.
+ * Literals false on the level zero are not stored.
+ */
+void CDCLSolver::addClause(SATClause* cl)
+{
+  CALL("CDCLSolver::addClause");
+  ASS_EQ(decisionLevel(),0);
+
+  // store to later generate the refutation
+  PrimitiveProofRecordingSATSolver::addClause(cl);
+
+  if (!_ok) {
+    return;
+  }
+
+  _learntBuffer.reset();
+  unsigned clen = cl->length();
+  for (unsigned i = 0; i < clen; i++) {
+    Lit l = (*cl)[i].content();
+    ASS_G(litVar(l),0); ASS_LE(litVar(l),_varCnt);
+    switch (value(l)) {
+      case V_TRUE:
+        return;
+      case V_FALSE:
+        break;
+      case V_UNDEF:
+        _learntBuffer.push(l);
+        break;
+    }
+  }
+
+  if (_learntBuffer.isEmpty()) {
+    _ok = false;
+    return;
+  }
+  if (_learntBuffer.size() == 1) {
+    assign(_learntBuffer[0], 0, 0);
+    if (propagate()) {
+      _ok = false;
+    }
+    return;
+  }
+
+  Clause* icl = Clause::create(_learntBuffer.begin(), _learntBuffer.size(), false);
+  _clauses.push(icl);
+  attach(icl);
+}
+
+void CDCLSolver::attach(Clause* cl)
+{
+  CALL("CDCLSolver::attach");
+  ASS_GE(cl->size,2);
+
+  _watches[cl->lits[0]].push(Watch(cl, cl->lits[1]));
+  _watches[cl->lits[1]].push(Watch(cl, cl->lits[0]));
+}
+
+void CDCLSolver::detach(Clause* cl)
+{
+  CALL("CDCLSolver::detach");
+
+  removeWatch(cl->lits[0], cl);
+  removeWatch(cl->lits[1], cl);
+}
+
+void CDCLSolver::removeWatch(Lit watched, Clause* cl)
+{
+  CALL("CDCLSolver::removeWatch");
+
+  WatchList& ws = _watches[watched];
+  unsigned sz = ws.size();
+  unsigned i = 0;
+  while (ws[i].cl != cl) {
+    i++;
+    ASS_L(i,sz);
+  }
+  for (i++; i < sz; i++) {
+    ws[i-1] = ws[i];
+  }
+  ws.pop();
+}
+
+/**
+ * True if @b cl is the reason of an assigned literal (which then must be its first one).
+ */
+bool CDCLSolver::locked(Clause* cl) const
+{
+  Lit l = cl->lits[0];
+  return _reasons[litVar(l)] == cl && isTrue(l);
+}
+
+/**
+ * Mark @b cl as removed. The clause must have been detached already, or its
+ * watches must be swept before it is destroyed.
+ */
+void CDCLSolver::removeClause(Clause* cl)
+{
+  CALL("CDCLSolver::removeClause");
+  ASS(!cl->removed);
+
+  if (locked(cl)) {
+    // only happens on the level zero, where reasons are never inspected
+    ASS_EQ(level(cl->lits[0]),0);
+    _reasons[litVar(cl->lits[0])] = 0;
+  }
+  cl->removed = 1;
+}
+
+void CDCLSolver::assign(Lit l, Clause* reason, unsigned lev)
+{
+  ASS_EQ(value(l),V_UNDEF);
+  ASS_LE(lev,decisionLevel());
+
+  unsigned var = litVar(l);
+  _values[var] = l&1;
+  _levels[var] = lev;
+  _reasons[var] = reason;
+  _trail.push(l);
+}
+
+/**
+ * Return the level at which the first literal of @b reason gets implied,
+ * i.e. the maximal level of its other literals. Since we backtrack
+ * chronologically, this may be less than the current decision level.
+ *
+ * @b falsifiedLevel is the level of the literal whose falsification made
+ * the clause unit.
+ */
+unsigned CDCLSolver::implicationLevel(Clause* reason, unsigned falsifiedLevel) const
+{
+  if (falsifiedLevel == decisionLevel()) {
+    return falsifiedLevel;
+  }
+  unsigned res = 0;
+  for (unsigned i = 1; i < reason->size; i++) {
+    res = max(res, level(reason->lits[i]));
+  }
+  return res;
+}
+
+/**
+ * Undo all the assignments above the level @b tgtLevel.
+ *
+ * With chronological backtracking the trail is not ordered by levels,
+ * so the assignments of lower levels found above the backtracking point
+ * are kept, and propagated again.
+ */
+void CDCLSolver::backtrack(unsigned tgtLevel)
+{
+  CALL("CDCLSolver::backtrack");
+
+  if (decisionLevel() <= tgtLevel) {
+    return;
+  }
+
+  unsigned start = _trailLim[tgtLevel];
+  unsigned j = start;
+  unsigned sz = _trail.size();
+  for (unsigned i = start; i < sz; i++) {
+    Lit l = _trail[i];
+    unsigned var = litVar(l);
+    if (_levels[var] > tgtLevel) {
+      _values[var] = V_UNDEF;
+      _reasons[var] = 0;
+      _phase[var] = l&1;
+      heapInsert(var);
+    } else {
+      _trail[j++] = l;
+    }
+  }
+  _trail.truncate(j);
+  _trailLim.truncate(tgtLevel);
+  if (_qhead > start) {
+    _qhead = start;
+  }
+}
+
+/**
+ * Propagate all the enqueued assignments and return
+ * a conflict clause, or zero if there is no conflict.
+ */
+CDCLSolver::Clause* CDCLSolver::propagate()
+{
+  CALL("CDCLSolver::propagate");
+
+  Clause* confl = 0;
+
+  while (_qhead < _trail.size()) {
+    Lit p = _trail[_qhead++];
+    Lit falseLit = litNeg(p);
+    unsigned falseLevel = level(p);
+    WatchList& ws = _watches[falseLit];
+    _propagations++;
+
+    Watch* i = ws.begin();
+    Watch* j = i;
+    Watch* end = ws.end();
+    while (i != end) {
+      Watch w = *i++;
+      if (isTrue(w.blocker)) {
+        *j++ = w;
+        continue;
+      }
+
+      Clause* cl = w.cl;
+      Lit* lits = cl->lits;
+      // make sure the false literal is the second one
+      if (lits[0] == falseLit) {
+        lits[0] = lits[1];
+        lits[1] = falseLit;
+      }
+      ASS_EQ(lits[1],falseLit);
+
+      Lit first = lits[0];
+      Watch nw(cl, first);
+      if (first != w.blocker && isTrue(first)) {
+        *j++ = nw;
+        continue;
+      }
+
+      // look for a new literal to watch
+      bool moved = false;
+      for (unsigned k = 2; k < cl->size; k++) {
+        if (!isFalse(lits[k])) {
+          lits[1] = lits[k];
+          lits[k] = falseLit;
+          _watches[lits[1]].push(nw);
+          moved = true;
+          break;
+        }
+      }
+      if (moved) {
+        continue;
+      }
+
+      // the clause is unit or conflicting
+      *j++ = nw;
+      if (isFalse(first)) {
+        confl = cl;
+        _qhead = _trail.size();
+        while (i != end) {
+          *j++ = *i++;
+        }
+      } else {
+        assign(first, cl, implicationLevel(cl, falseLevel));
+      }
+    }
+    ws.truncate(j-ws.begin());
+
+    if (confl) {
+      break;
+    }
+  }
+  return confl;
+}
+
+/**
+ * Return the maximal level of a literal in the conflicting clause @b confl and
+ * move the two literals of the highest levels to the watched positions.
+ *
+ * If there is just one literal on the maximal level, it is assigned in @b forced,
+ * otherwise @b forced is set to NO_LIT.
+ */
+unsigned CDCLSolver::conflictLevel(Clause* confl, Lit& forced)
+{
+  CALL("CDCLSolver::conflictLevel");
+
+  Lit* lits = confl->lits;
+  Lit old0 = lits[0];
+  Lit old1 = lits[1];
+
+  unsigned maxLevel = 0;
+  unsigned cnt = 0;
+  unsigned maxIdx = 0;
+  for (unsigned i = 0; i < confl->size; i++) {
+    unsigned lev = level(lits[i]);
+    if (lev > maxLevel) {
+      maxLevel = lev;
+      maxIdx = i;
+      cnt = 1;
+    } else if (lev == maxLevel) {
+      cnt++;
+    }
+  }
+  forced = cnt == 1 ? lits[maxIdx] : NO_LIT;
+
+  std::swap(lits[0], lits[maxIdx]);
+  unsigned secondIdx = 1;
+  for (unsigned i = 2; i < confl->size; i++) {
+    if (level(lits[i]) > level(lits[secondIdx])) {
+      secondIdx = i;
+    }
+  }
+  std::swap(lits[1], lits[secondIdx]);
+
+  // update the watches if the watched literals changed
+  for (unsigned i = 0; i < 2; i++) {
+    if (lits[i] != old0 && lits[i] != old1) {
+      _watches[lits[i]].push(Watch(confl, lits[1-i]));
+    }
+  }
+  if (old0 != lits[0] && old0 != lits[1]) {
+    removeWatch(old0, confl);
+  }
+  if (old1 != lits[0] && old1 != lits[1]) {
+    removeWatch(old1, confl);
+  }
+
+  return maxLevel;
+}
+
+/**
+ * Learn from the conflict @b confl and backtrack.
+ *
+ * Return false if the conflict is on the level zero,
+ * i.e. the clauses are unsatisfiable.
+ */
+bool CDCLSolver::handleConflict(Clause* confl)
+{
+  CALL("CDCLSolver::handleConflict");
+
+  _conflicts++;
+  RSTAT_CTR_INC("cdcl conflicts");
+
+  Lit forced;
+  unsigned confLevel = conflictLevel(confl, forced);
+  if (confLevel == 0) {
+    return false;
+  }
+
+  if (forced != NO_LIT) {
+    // a missed implication on a lower level, no learning needed
+    backtrack(confLevel-1);
+    assign(forced, confl, implicationLevel(confl, UINT_MAX));
+    return true;
+  }
+
+  backtrack(confLevel);
+
+  unsigned btLevel;
+  unsigned lbd;
+  analyze(confl, _learntBuffer, btLevel, lbd);
+
+  _learntCnt++;
+  _lbdSum += lbd;
+  _fastLbd = _learntCnt == 1 ? lbd : _fastLbd + (lbd - _fastLbd)/32;
+
+  if (_learntBuffer.size() == 1) {
+    backtrack(0);
+    assign(_learntBuffer[0], 0, 0);
+  } else {
+    if (confLevel - btLevel > CHRONO_LEVEL_LIMIT) {
+      RSTAT_CTR_INC("cdcl chronological backtracks");
+      backtrack(confLevel-1);
+    } else {
+      backtrack(btLevel);
+    }
+    Clause* lcl = Clause::create(_learntBuffer.begin(), _learntBuffer.size(), true);
+    lcl->lbd = lbd;
+    _learnts.push(lcl);
+    attach(lcl);
+    bumpClause(lcl);
+    assign(_learntBuffer[0], lcl, btLevel);
+  }
+
+  decayVarActivity();
+  decayClauseActivity();
+  return true;
+}
+
+/**
+ * First UIP conflict analysis on the current decision level, which must be the conflict level.
+ *
+ * The learnt clause is stored in @b learnt with the asserting literal first and
+ * a literal of the backtracking level @b btLevel second.
+ */
+void CDCLSolver::analyze(Clause* confl, Stack<Lit>& learnt, unsigned& btLevel, unsigned& lbd)
+{
+  CALL("CDCLSolver::analyze");
+
+  unsigned curLevel = decisionLevel();
+  learnt.reset();
+  learnt.push(NO_LIT); // placeholder for the asserting literal
+
+  int pathCnt = 0;
+  Lit p = NO_LIT;
+  unsigned index = _trail.size();
+  Clause* cl = confl;
+
+  do {
+    ASS(cl);
+    if (cl->learnt) {
+      cl->used = 1;
+      bumpClause(cl);
+      if (cl->lbd > CORE_LBD) {
+        unsigned newLbd = computeLbd(cl->lits, cl->size);
+        if (newLbd < cl->lbd) {
+          cl->lbd = newLbd;
+        }
+      }
+    }
+
+    for (unsigned j = (p == NO_LIT) ? 0 : 1; j < cl->size; j++) {
+      Lit q = cl->lits[j];
+      unsigned v = litVar(q);
+      if (!_seen[v] && _levels[v] > 0) {
+        bumpVar(v);
+        _seen[v] = 1;
+        if (_levels[v] >= curLevel) {
+          pathCnt++;
+        } else {
+          learnt.push(q);
+        }
+      }
+    }
+
+    // the next literal of the current level to look at
+    do {
+      ASS_G(index,0);
+      index--;
+    } while (!_seen[litVar(_trail[index])] || _levels[litVar(_trail[index])] != curLevel);
+    p = _trail[index];
+    cl = _reasons[litVar(p)];
+    _seen[litVar(p)] = 0;
+    pathCnt--;
+  } while (pathCnt > 0);
+
+  learnt[0] = litNeg(p);
+
+  minimize(learnt);
+
+  // find the backtracking level and put its literal second
+  btLevel = 0;
+  if (learnt.size() > 1) {
+    unsigned maxIdx = 1;
+    for (unsigned i = 2; i < learnt.size(); i++) {
+      if (level(learnt[i]) > level(learnt[maxIdx])) {
+        maxIdx = i;
+      }
+    }
+    std::swap(learnt[1], learnt[maxIdx]);
+    btLevel = level(learnt[1]);
+  }
+
+  lbd = computeLbd(learnt.begin(), learnt.size());
+}
+
+/**
+ * Recursive minimization of the learnt clause (as in Minisat), also
+ * clears the seen flags set in analyze.
+ */
+void CDCLSolver::minimize(Stack<Lit>& learnt)
+{
+  CALL("CDCLSolver::minimize");
+
+  _analyzeToClear.reset();
+  unsigned abstractLevels = 0;
+  for (unsigned i = 1; i < learnt.size(); i++) {
+    _analyzeToClear.push(litVar(learnt[i]));
+    abstractLevels |= 1u << (level(learnt[i]) & 31);
+  }
+
+  unsigned j = 1;
+  for (unsigned i = 1; i < learnt.size(); i++) {
+    Lit l = learnt[i];
+    if (_reasons[litVar(l)] == 0 || !litRedundant(l, abstractLevels)) {
+      learnt[j++] = l;
+    }
+  }
+  RSTAT_CTR_INC_MANY("cdcl minimized literals", learnt.size()-j);
+  learnt.truncate(j);
+
+  Stack<unsigned>::Iterator it(_analyzeToClear);
+  while (it.hasNext()) {
+    _seen[it.next()] = 0;
+  }
+}
+
+/**
+ * Return true if @b l is implied by the other literals of the learnt clause
+ * (which are marked as seen).
+ */
+bool CDCLSolver::litRedundant(Lit l, unsigned abstractLevels)
+{
+  CALL("CDCLSolver::litRedundant");
+
+  _analyzeStack.reset();
+  _analyzeStack.push(l);
+  unsigned top = _analyzeToClear.size();
+
+  while (_analyzeStack.isNonEmpty()) {
+    Clause* cl = _reasons[litVar(_analyzeStack.pop())];
+    ASS(cl);
+    for (unsigned i = 1; i < cl->size; i++) {
+      Lit q = cl->lits[i];
+      unsigned v = litVar(q);
+      if (_seen[v] || _levels[v] == 0) {
+        continue;
+      }
+      if (_reasons[v] != 0 && ((1u << (_levels[v] & 31)) & abstractLevels) != 0) {
+        _seen[v] = 1;
+        _analyzeStack.push(q);
+        _analyzeToClear.push(v);
+      } else {
+        for (unsigned k = top; k < _analyzeToClear.size(); k++) {
+          _seen[_analyzeToClear[k]] = 0;
+        }
+        _analyzeToClear.truncate(top);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Return the number of distinct levels of the literals @b lits.
+ */
+unsigned CDCLSolver::computeLbd(const Lit* lits, unsigned size)
+{
+  CALL("CDCLSolver::computeLbd");
+
+  _stamp++;
+  unsigned res = 0;
+  for (unsigned i = 0; i < size; i++) {
+    unsigned lev = level(lits[i]);
+    if (_levelStamps[lev] != _stamp) {
+      _levelStamps[lev] = _stamp;
+      res++;
+    }
+  }
+  return res;
+}
+
+/**
+ * Compute the subset of assumptions which imply the negation of
+ * the assumption @b failed and store it together with @b failed
+ * into _conflict.
+ */
+void CDCLSolver::analyzeFinal(Lit failed)
+{
+  CALL("CDCLSolver::analyzeFinal");
+
+  _conflict.reset();
+  _conflict.push(failed);
+
+  if (decisionLevel() == 0) {
+    return;
+  }
+
+  _seen[litVar(failed)] = 1;
+  for (unsigned i = _trail.size(); i > _trailLim[0]; ) {
+    i--;
+    unsigned v = litVar(_trail[i]);
+    if (!_seen[v]) {
+      continue;
+    }
+    Clause* reason = _reasons[v];
+    if (reason == 0) {
+      ASS_G(_levels[v],0);
+      // an assumption
+      _conflict.push(_trail[i]);
+    } else {
+      for (unsigned j = 1; j < reason->size; j++) {
+        if (level(reason->lits[j]) > 0) {
+          _seen[litVar(reason->lits[j])] = 1;
+        }
+      }
+    }
+    _seen[v] = 0;
+  }
+  _seen[litVar(failed)] = 0;
+}
+
+void CDCLSolver::bumpVar(unsigned var)
+{
+  if ((_activity[var] += _varInc) > 1e100) {
+    for (unsigned v = 1; v <= _varCnt; v++) {
+      _activity[v] *= 1e-100;
+    }
+    _varInc *= 1e-100;
+  }
+  if (_heapPos[var]) {
+    heapUp(_heapPos[var]-1);
+  }
+}
+
+void CDCLSolver::bumpClause(Clause* cl)
+{
+  if ((cl->activity += _clauseInc) > 1e20) {
+    Stack<Clause*>::Iterator it(_learnts);
+    while (it.hasNext()) {
+      it.next()->activity *= 1e-20;
+    }
+    _clauseInc *= 1e-20;
+  }
+}
+
+void CDCLSolver::heapInsert(unsigned var)
+{
+  if (_heapPos[var]) {
+    return;
+  }
+  _heap.push(var);
+  _heapPos[var] = _heap.size();
+  heapUp(_heap.size()-1);
+}
+
+void CDCLSolver::heapUp(unsigned pos)
+{
+  unsigned var = _heap[pos];
+  while (pos > 0) {
+    unsigned parent = (pos-1) >> 1;
+    if (!heapLess(var, _heap[parent])) {
+      break;
+    }
+    _heap[pos] = _heap[parent];
+    _heapPos[_heap[pos]] = pos+1;
+    pos = parent;
+  }
+  _heap[pos] = var;
+  _heapPos[var] = pos+1;
+}
+
+void CDCLSolver::heapDown(unsigned pos)
+{
+  unsigned var = _heap[pos];
+  unsigned sz = _heap.size();
+  for (;;) {
+    unsigned child = 2*pos+1;
+    if (child >= sz) {
+      break;
+    }
+    if (child+1 < sz && heapLess(_heap[child+1], _heap[child])) {
+      child++;
+    }
+    if (!heapLess(_heap[child], var)) {
+      break;
+    }
+    _heap[pos] = _heap[child];
+    _heapPos[_heap[pos]] = pos+1;
+    pos = child;
+  }
+  _heap[pos] = var;
+  _heapPos[var] = pos+1;
+}
+
+unsigned CDCLSolver::heapPop()
+{
+  ASS(_heap.isNonEmpty());
+
+  unsigned res = _heap[0];
+  unsigned last = _heap.pop();
+  _heapPos[res] = 0;
+  if (_heap.isNonEmpty()) {
+    _heap[0] = last;
+    _heapPos[last] = 1;
+    heapDown(0);
+  }
+  return res;
+}
+
+CDCLSolver::Lit CDCLSolver::pickBranchLit()
+{
+  CALL("CDCLSolver::pickBranchLit");
+
+  while (_heap.isNonEmpty()) {
+    unsigned var = heapPop();
+    if (_values[var] == V_UNDEF) {
+      return mkLit(var, _phase[var]);
+    }
+  }
+  return NO_LIT;
+}
+
+bool CDCLSolver::shouldRestart() const
+{
+  return _conflicts - _conflictsAtRestart >= RESTART_MIN_CONFLICTS &&
+    _fastLbd*_learntCnt > RESTART_MARGIN*_lbdSum;
+}
+
+/**
+ * Reduce the learnt clause database.
+ *
+ * Core clauses are kept forever, tier2 clauses as long as they
+ * keep being used in conflict analysis. Half of the remaining ones,
+ * those with the highest LBD and lowest activity, are removed.
+ */
+void CDCLSolver::reduceDB()
+{
+  CALL("CDCLSolver::reduceDB");
+
+  _reduceCnt++;
+  _nextReduce = _conflicts + FIRST_REDUCE + REDUCE_INCREMENT*_reduceCnt;
+
+  static Stack<Clause*> candidates;
+  candidates.reset();
+
+  Stack<Clause*>::Iterator it(_learnts);
+  while (it.hasNext()) {
+    Clause* cl = it.next();
+    Tier tier = tierOf(cl->lbd);
+    bool used = cl->used;
+    cl->used = 0;
+    if (tier == TIER_CORE || used || locked(cl)) {
+      continue;
+    }
+    candidates.push(cl);
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](Clause* c1, Clause* c2) {
+    if (c1->lbd != c2->lbd) {
+      return c1->lbd > c2->lbd;
+    }
+    return c1->activity < c2->activity;
+  });
+
+  unsigned toRemove = candidates.size()/2;
+  for (unsigned i = 0; i < toRemove; i++) {
+    removeClause(candidates[i]);
+  }
+  RSTAT_CTR_INC_MANY("cdcl removed learnts", toRemove);
+
+  if (toRemove) {
+    // sweep the watches and free the clauses
+    for (unsigned l = 0; l < _watches.size(); l++) {
+      WatchList& ws = _watches[l];
+      unsigned j = 0;
+      for (unsigned i = 0; i < ws.size(); i++) {
+        if (!ws[i].cl->removed) {
+          ws[j++] = ws[i];
+        }
+      }
+      ws.truncate(j);
+    }
+    unsigned j = 0;
+    for (unsigned i = 0; i < _learnts.size(); i++) {
+      Clause* cl = _learnts[i];
+      if (cl->removed) {
+        cl->destroy();
+      } else {
+        _learnts[j++] = cl;
+      }
+    }
+    _learnts.truncate(j);
+  }
+}
+
+/**
+ * Remove clauses satisfied on the level zero and literals false there.
+ *
+ * Must be called on the level zero with everything propagated.
+ * As level zero assignments are consequences of the clauses alone,
+ * this stays valid under any future assumptions.
+ */
+void CDCLSolver::simplifyLevelZero()
+{
+  CALL("CDCLSolver::simplifyLevelZero");
+  ASS_EQ(decisionLevel(),0);
+  ASS_EQ(_qhead,_trail.size());
+
+  if (_trail.size() == _simplifiedTrailSize) {
+    return;
+  }
+  _simplifiedTrailSize = _trail.size();
+
+  bool anyRemoved = false;
+  for (unsigned s = 0; s < 2; s++) {
+    Stack<Clause*>& clauses = s ? _learnts : _clauses;
+    Stack<Clause*>::Iterator it(clauses);
+    while (it.hasNext()) {
+      Clause* cl = it.next();
+      bool satisfied = false;
+      unsigned j = 0;
+      for (unsigned i = 0; i < cl->size; i++) {
+        Lit l = cl->lits[i];
+        Value val = value(l);
+        if (val == V_TRUE) {
+          satisfied = true;
+          break;
+        }
+        if (val == V_UNDEF) {
+          cl->lits[j++] = l;
+        }
+      }
+      if (satisfied) {
+        removeClause(cl);
+        anyRemoved = true;
+      } else {
+        // the watched literals of an unsatisfied clause are not false after propagation
+        ASS(value(cl->lits[0]) == V_UNDEF && value(cl->lits[1]) == V_UNDEF);
+        cl->size = j;
+      }
+    }
+  }
+
+  if (!anyRemoved) {
+    return;
+  }
+  for (unsigned l = 0; l < _watches.size(); l++) {
+    WatchList& ws = _watches[l];
+    unsigned j = 0;
+    for (unsigned i = 0; i < ws.size(); i++) {
+      if (!ws[i].cl->removed) {
+        ws[j++] = ws[i];
+      }
+    }
+    ws.truncate(j);
+  }
+  for (unsigned s = 0; s < 2; s++) {
+    Stack<Clause*>& clauses = s ? _learnts : _clauses;
+    unsigned j = 0;
+    for (unsigned i = 0; i < clauses.size(); i++) {
+      Clause* cl = clauses[i];
+      if (cl->removed) {
+        cl->destroy();
+      } else {
+        clauses[j++] = cl;
+      }
+    }
+    clauses.truncate(j);
+  }
+}
+
+/**
+ * Try to shorten the clause @b cl by assigning its literals to false
+ * one by one and propagating (vivification). Must be called on the level
+ * zero. Return false if the level zero became inconsistent.
+ *
+ * The resulting clause is implied by the clause database, so the
+ * shortening is sound for any future assumptions and added clauses.
+ */
+bool CDCLSolver::vivify(Clause* cl)
+{
+  CALL("CDCLSolver::vivify");
+  ASS_EQ(decisionLevel(),0);
+  ASS(!cl->removed);
+
+  cl->vivified = 1;
+  if (locked(cl)) {
+    return true;
+  }
+
+  detach(cl);
+
+  _learntBuffer.reset();
+  bool satisfied = false;
+  for (unsigned i = 0; i < cl->size; i++) {
+    Lit l = cl->lits[i];
+    Value val = value(l);
+    if (val == V_TRUE) {
+      if (level(l) == 0) {
+        satisfied = true;
+      } else {
+        // implied by the negation of the preceding literals
+        _learntBuffer.push(l);
+      }
+      break;
+    }
+    if (val == V_FALSE) {
+      // implied false by the negation of the preceding literals
+      continue;
+    }
+    _learntBuffer.push(l);
+    newDecisionLevel();
+    assign(litNeg(l), 0, decisionLevel());
+    if (propagate()) {
+      break;
+    }
+  }
+  backtrack(0);
+
+  if (satisfied) {
+    removeClause(cl);
+    return true;
+  }
+  if (_learntBuffer.size() == cl->size) {
+    attach(cl);
+    return true;
+  }
+
+  RSTAT_CTR_INC("cdcl vivified clauses");
+  RSTAT_CTR_INC_MANY("cdcl vivified literals", cl->size-_learntBuffer.size());
+
+  if (_learntBuffer.size() == 1) {
+    removeClause(cl);
+    assign(_learntBuffer[0], 0, 0);
+    return propagate() == 0;
+  }
+  ASS_GE(_learntBuffer.size(),2);
+
+  for (unsigned i = 0; i < _learntBuffer.size(); i++) {
+    cl->lits[i] = _learntBuffer[i];
+  }
+  cl->size = _learntBuffer.size();
+  if (cl->lbd > cl->size) {
+    cl->lbd = cl->size;
+  }
+  attach(cl);
+  return true;
+}
+
+/**
+ * Vivify the not yet vivified learnt clauses of the core and tier2,
+ * within a propagation budget proportional to the number of conflicts
+ * since the last vivification.
+ */
+void CDCLSolver::vivifyLearnts()
+{
+  CALL("CDCLSolver::vivifyLearnts");
+  ASS_EQ(decisionLevel(),0);
+
+  unsigned long long budget = _propagations + VIVIFY_EFFORT*(_conflicts-_conflictsAtVivify);
+  _conflictsAtVivify = _conflicts;
+
+  // the most recent clauses first, the older ones were probably tried already
+  for (unsigned i = _learnts.size(); i > 0 && _propagations < budget && _ok; ) {
+    i--;
+    Clause* cl = _learnts[i];
+    if (cl->removed || cl->vivified || tierOf(cl->lbd) == TIER_LOCAL) {
+      continue;
+    }
+    if (!vivify(cl)) {
+      _ok = false;
+    }
+  }
+
+  unsigned j = 0;
+  for (unsigned i = 0; i < _learnts.size(); i++) {
+    Clause* cl = _learnts[i];
+    if (cl->removed) {
+      cl->destroy();
+    } else {
+      _learnts[j++] = cl;
+    }
+  }
+  _learnts.truncate(j);
+}
+
+void CDCLSolver::simplify()
+{
+  CALL("CDCLSolver::simplify");
+  ASS_EQ(decisionLevel(),0);
+
+  if (!_ok) {
+    return;
+  }
+  if (propagate()) {
+    _ok = false;
+    return;
+  }
+  simplifyLevelZero();
+  vivifyLearnts();
+}
+
+/**
+ * The CDCL loop. Return UNKNOWN if more than @b conflictCountLimit conflicts
+ * were encountered, otherwise return the status, leaving the model on
+ * the trail if satisfiable.
+ */
+SATSolver::Status CDCLSolver::search(unsigned conflictCountLimit)
+{
+  CALL("CDCLSolver::search");
+
+  unsigned long long conflictsAtStart = _conflicts;
+
+  for (;;) {
+    Clause* confl = propagate();
+    if (confl) {
+      if (!handleConflict(confl)) {
+        _ok = false;
+        return UNSATISFIABLE;
+      }
+      continue;
+    }
+
+    if (conflictCountLimit != UINT_MAX && _conflicts - conflictsAtStart >= conflictCountLimit) {
+      return UNKNOWN;
+    }
+
+    if (shouldRestart()) {
+      RSTAT_CTR_INC("cdcl restarts");
+      _conflictsAtRestart = _conflicts;
+      // reset the moving average so that we do not restart again right away
+      _fastLbd = _lbdSum/_learntCnt;
+      backtrack(0);
+      continue;
+    }
+
+    if (_conflicts >= _nextReduce) {
+      reduceDB();
+    }
+    if (decisionLevel() == 0) {
+      simplifyLevelZero();
+      if (_conflicts - _conflictsAtVivify >= VIVIFY_INTERVAL) {
+        unsigned trailSize = _trail.size();
+        vivifyLearnts();
+        if (!_ok) {
+          return UNSATISFIABLE;
+        }
+        if (_trail.size() != trailSize) {
+          // new units to propagate
+          continue;
+        }
+      }
+    }
+
+    Lit next = NO_LIT;
+    while (decisionLevel() < _assumptions.size()) {
+      Lit a = _assumptions[decisionLevel()];
+      Value val = value(a);
+      if (val == V_TRUE) {
+        // dummy decision level
+        newDecisionLevel();
+      } else if (val == V_FALSE) {
+        analyzeFinal(a);
+        return UNSATISFIABLE;
+      } else {
+        next = a;
+        break;
+      }
+    }
+
+    if (next == NO_LIT) {
+      next = pickBranchLit();
+      if (next == NO_LIT) {
+        return SATISFIABLE;
+      }
+    }
+
+    newDecisionLevel();
+    assign(next, 0, decisionLevel());
+  }
+}
+
+SATSolver::Status CDCLSolver::doSolving(unsigned conflictCountLimit)
+{
+  CALL("CDCLSolver::doSolving");
+  ASS_EQ(decisionLevel(),0);
+
+  _conflict.reset();
+
+  if (!_ok) {
+    _status = UNSATISFIABLE;
+    return _status;
+  }
+
+  _status = search(conflictCountLimit);
+
+  if (_status == SATISFIABLE) {
+    for (unsigned v = 1; v <= _varCnt; v++) {
+      _model[v] = _values[v];
+    }
+  }
+  backtrack(0);
+
+  return _status;
+}
+
+SATSolver::Status CDCLSolver::solve(unsigned conflictCountLimit)
+{
+  CALL("CDCLSolver::solve");
+
+  return doSolving(conflictCountLimit);
+}
+
+SATSolver::Status CDCLSolver::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool)
+{
+  CALL("CDCLSolver::solveUnderAssumptions");
+  ASS(!hasAssumptions());
+
+  SATLiteralStack::ConstIterator it(assumps);
+  while (it.hasNext()) {
+    addAssumption(it.next());
+  }
+
+  doSolving(conflictCountLimit);
+
+  if (_status == UNSATISFIABLE) {
+    _failedAssumptionBuffer.reset();
+    Stack<Lit>::Iterator cit(_conflict);
+    while (cit.hasNext()) {
+      _failedAssumptionBuffer.push(SATLiteral(cit.next()));
+    }
+  }
+
+  _assumptions.reset();
+  return _status;
+}
+
+SATSolver::VarAssignment CDCLSolver::getAssignment(unsigned var)
+{
+  CALL("CDCLSolver::getAssignment");
+  ASS_EQ(_status, SATISFIABLE);
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  switch (_model[var]) {
+    case V_TRUE:
+      return TRUE;
+    case V_FALSE:
+      return FALSE;
+    default:
+      // new vars have been added but the model didn't grow yet
+      return DONT_CARE;
+  }
+}
+
+bool CDCLSolver::isZeroImplied(unsigned var)
+{
+  CALL("CDCLSolver::isZeroImplied");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  return _values[var] != V_UNDEF && _levels[var] == 0;
+}
+
+void CDCLSolver::collectZeroImplied(SATLiteralStack& acc)
+{
+  CALL("CDCLSolver::collectZeroImplied");
+
+  Stack<Lit>::Iterator it(_trail);
+  while (it.hasNext()) {
+    Lit l = it.next();
+    if (level(l) == 0) {
+      acc.push(SATLiteral(l));
+    }
+  }
+}
+
+SATClause* CDCLSolver::getZeroImpliedCertificate(unsigned)
+{
+  CALL("CDCLSolver::getZeroImpliedCertificate");
+
+  // not supported, as in MinisatInterfacing
+  return 0;
+}
+
+} // namespace SAT
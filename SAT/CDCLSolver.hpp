@@ -0,0 +1,281 @@
+/*
+ * File CDCLSolver.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CDCLSolver.hpp
+ * Defines class CDCLSolver.
+ */
+
+#ifndef __CDCLSolver__
+#define __CDCLSolver__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/Stack.hpp"
+
+#include "SATSolver.hpp"
+#include "SATLiteral.hpp"
+#include "SATClause.hpp"
+
+namespace SAT {
+
+using namespace Lib;
+using namespace Shell;
+
+/**
+ * A conflict driven clause learning solver in the style of
+ * the modern (post Minisat 2.2) solvers.
+ *
+ * On top of the usual watched literals, VSIDS, phase saving and
+ * recursive learnt clause minimization, the solver implements
+ * - a three tiered learnt clause database (core, tier2, local)
+ *   reduced by literal block distance (LBD),
+ * - Glucose-style restarts driven by moving averages of LBD,
+ * - chronological backtracking (Nadel and Ryvchin, SAT 2018)
+ *   for conflicts whose backjump would undo many levels,
+ * - vivification of learnt clauses.
+ *
+ * All in-processing works on the level zero trail only and never
+ * removes variables (no elimination), so it stays sound when
+ * further clauses are added and when solving under assumptions,
+ * which is what AVATAR and FMB require.
+ *
+ * Literals are represented internally by the content of SATLiteral,
+ * i.e. as 2*var+polarity.
+ */
+class CDCLSolver : public PrimitiveProofRecordingSATSolver
+{
+public:
+  CLASS_NAME(CDCLSolver);
+  USE_ALLOCATOR(CDCLSolver);
+
+  CDCLSolver(const Options& opt, bool generateProofs=false);
+  ~CDCLSolver();
+
+  virtual void addClause(SATClause* cl) override;
+
+  /**
+   * Remove satisfied clauses and false literals on the level zero
+   * and vivify the learnt clauses.
+   */
+  virtual void simplify() override;
+
+  virtual Status solve(unsigned conflictCountLimit) override;
+
+  virtual VarAssignment getAssignment(unsigned var) override;
+  virtual bool isZeroImplied(unsigned var) override;
+  virtual void collectZeroImplied(SATLiteralStack& acc) override;
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override;
+
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+  virtual unsigned newVar() override;
+
+  virtual void suggestPolarity(unsigned var, unsigned pol) override {
+    ASS_G(var,0); ASS_LE(var,_varCnt);
+    _phase[var] = pol;
+  }
+
+  virtual void addAssumption(SATLiteral lit) override;
+  virtual void retractAllAssumptions() override;
+  virtual bool hasAssumptions() const override { return _assumptions.isNonEmpty(); }
+
+  virtual void recordSource(unsigned satlitvar, Literal* lit) override {
+    // unused by this solver; intentionally no-op
+  }
+
+  Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool) override;
+
+private:
+  /** Internal literal, the content of a SATLiteral */
+  typedef unsigned Lit;
+
+  static unsigned litVar(Lit l) { return l>>1; }
+  static Lit litNeg(Lit l) { return l^1; }
+  static Lit mkLit(unsigned var, unsigned pol) { return (var<<1)|pol; }
+  /** variable 0 is never used, so neither are its literals */
+  static const Lit NO_LIT = 0;
+
+  enum Value {
+    V_FALSE = 0,
+    V_TRUE = 1,
+    V_UNDEF = 2
+  };
+
+  /**
+   * Internal clause representation, allocated with the literals inline.
+   */
+  struct Clause {
+    unsigned size;
+    unsigned lbd : 28;
+    unsigned learnt : 1;
+    unsigned removed : 1;
+    /** used in conflict analysis since the last database reduction */
+    unsigned used : 1;
+    /** already considered by vivification */
+    unsigned vivified : 1;
+    float activity;
+    Lit lits[1];
+
+    static Clause* create(const Lit* lits, unsigned size, bool learnt);
+    void destroy();
+  };
+
+  struct Watch {
+    Watch() {}
+    Watch(Clause* cl, Lit blocker) : cl(cl), blocker(blocker) {}
+    Clause* cl;
+    Lit blocker;
+  };
+  typedef Stack<Watch> WatchList;
+
+  /** The tier into which a learnt clause of given LBD belongs */
+  enum Tier {
+    TIER_CORE,
+    TIER_2,
+    TIER_LOCAL
+  };
+  static Tier tierOf(unsigned lbd) {
+    return lbd <= CORE_LBD ? TIER_CORE : (lbd <= TIER2_LBD ? TIER_2 : TIER_LOCAL);
+  }
+
+  Value value(Lit l) const {
+    char v = _values[litVar(l)];
+    return v == V_UNDEF ? V_UNDEF : static_cast<Value>((v^l)&1 ? V_FALSE : V_TRUE);
+  }
+  bool isTrue(Lit l) const { return value(l) == V_TRUE; }
+  bool isFalse(Lit l) const { return value(l) == V_FALSE; }
+  unsigned level(Lit l) const { return _levels[litVar(l)]; }
+  unsigned decisionLevel() const { return _trailLim.size(); }
+
+  void attach(Clause* cl);
+  void detach(Clause* cl);
+  void removeWatch(Lit watched, Clause* cl);
+  bool locked(Clause* cl) const;
+  void removeClause(Clause* cl);
+
+  void newDecisionLevel() { _trailLim.push(_trail.size()); }
+  void assign(Lit l, Clause* reason, unsigned lev);
+  unsigned implicationLevel(Clause* reason, unsigned falsifiedLevel) const;
+  void backtrack(unsigned tgtLevel);
+  Clause* propagate();
+
+  bool handleConflict(Clause* confl);
+  unsigned conflictLevel(Clause* confl, Lit& forced);
+  void analyze(Clause* confl, Stack<Lit>& learnt, unsigned& btLevel, unsigned& lbd);
+  bool litRedundant(Lit l, unsigned abstractLevels);
+  void minimize(Stack<Lit>& learnt);
+  unsigned computeLbd(const Lit* lits, unsigned size);
+  void analyzeFinal(Lit failed);
+
+  void bumpVar(unsigned var);
+  void decayVarActivity() { _varInc /= VAR_DECAY; }
+  void bumpClause(Clause* cl);
+  void decayClauseActivity() { _clauseInc /= CLAUSE_DECAY; }
+
+  void heapInsert(unsigned var);
+  void heapUp(unsigned pos);
+  void heapDown(unsigned pos);
+  unsigned heapPop();
+  bool heapLess(unsigned v1, unsigned v2) const { return _activity[v1] > _activity[v2]; }
+
+  Lit pickBranchLit();
+  bool shouldRestart() const;
+
+  void reduceDB();
+  void simplifyLevelZero();
+  bool vivify(Clause* cl);
+  void vivifyLearnts();
+
+  Status search(unsigned conflictCountLimit);
+  Status doSolving(unsigned conflictCountLimit);
+
+  static const unsigned CORE_LBD = 2;
+  static const unsigned TIER2_LBD = 6;
+  /** chronological backtracking is used if the backjump would skip more levels than this */
+  static const unsigned CHRONO_LEVEL_LIMIT = 100;
+  static const unsigned FIRST_REDUCE = 2000;
+  static const unsigned REDUCE_INCREMENT = 300;
+  static const unsigned RESTART_MIN_CONFLICTS = 50;
+  static constexpr double VAR_DECAY = 0.95;
+  static constexpr double CLAUSE_DECAY = 0.999;
+  static constexpr double RESTART_MARGIN = 1.25;
+  /** minimal number of conflicts between two vivification rounds */
+  static const unsigned VIVIFY_INTERVAL = 2000;
+  /** propagations allowed in vivification per conflict since the last vivification */
+  static const unsigned VIVIFY_EFFORT = 10;
+
+  unsigned _varCnt;
+  /** false if a conflict was derived on the level zero */
+  bool _ok;
+  Status _status;
+
+  DArray<char> _values;
+  DArray<unsigned> _levels;
+  DArray<Clause*> _reasons;
+  DArray<char> _phase;
+  DArray<char> _seen;
+  DArray<double> _activity;
+  /** indexed by literals, contains the clauses watching the literal */
+  DArray<WatchList> _watches;
+
+  Stack<Lit> _trail;
+  Stack<unsigned> _trailLim;
+  unsigned _qhead;
+
+  /** binary heap of variables ordered by activity */
+  Stack<unsigned> _heap;
+  /** position in _heap plus one, zero when not in the heap */
+  DArray<unsigned> _heapPos;
+  double _varInc;
+  double _clauseInc;
+
+  Stack<Clause*> _clauses;
+  Stack<Clause*> _learnts;
+
+  Stack<Lit> _assumptions;
+  /** the assumptions responsible for the last unsatisfiable result */
+  Stack<Lit> _conflict;
+  /** the model obtained from the last satisfiable call */
+  DArray<char> _model;
+
+  DArray<unsigned> _levelStamps;
+  unsigned _stamp;
+
+  /** exponential moving average of recent LBDs and the sum of all of them, for restarts */
+  double _fastLbd;
+  double _lbdSum;
+
+  unsigned long long _conflicts;
+  unsigned long long _learntCnt;
+  unsigned long long _conflictsAtRestart;
+  unsigned long long _nextReduce;
+  unsigned long long _reduceCnt;
+  unsigned long long _propagations;
+  unsigned long long _conflictsAtVivify;
+  /** number of level zero assignments at the last level zero simplification */
+  unsigned _simplifiedTrailSize;
+
+  Stack<Lit> _learntBuffer;
+  Stack<Lit> _analyzeStack;
+  Stack<unsigned> _analyzeToClear;
+};
+
+}
+
+#endif // __CDCLSolver__
@@ -0,0 +1,109 @@
+/*
+ * File ClauseArena.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ClauseArena.cpp
+ * Implements class ClauseArena.
+ */
+
+#include "SATClause.hpp"
+
+#include "ClauseArena.hpp"
+
+namespace SAT
+{
+
+/**
+ * Store the literals of @b cl (in their current order) into the arena
+ * and return the reference to them.
+ */
+ClauseArena::Ref ClauseArena::alloc(SATClause* cl)
+{
+  CALL("ClauseArena::alloc");
+
+  unsigned len = cl->length();
+  ASS_L(len, 1u<<(32-FLAG_BITS));
+  ASS_L(size()+clauseWords(len), 0xFFFFFFFFu);
+
+  Ref res = _mem.size();
+  _mem.push(len << FLAG_BITS);
+  unsigned ptrWords[HEADER_WORDS-1];
+  memcpy(ptrWords, &cl, sizeof(SATClause*));
+  for (unsigned i = 0; i < HEADER_WORDS-1; i++) {
+    _mem.push(ptrWords[i]);
+  }
+  for (unsigned i = 0; i < len; i++) {
+    _mem.push((*cl)[i].content());
+  }
+  return res;
+}
+
+/**
+ * Mark the clause as removed. Its space is reclaimed by the next relocation.
+ */
+void ClauseArena::remove(Ref r)
+{
+  CALL("ClauseArena::remove");
+
+  if (removed(r)) {
+    return;
+  }
+  _mem[r] |= REMOVED_FLAG;
+  _wasted += clauseWords(length(r));
+}
+
+/**
+ * Copy the clause @b r into the arena @b to (unless already done)
+ * and return its new reference.
+ *
+ * The live clauses are moved to a new arena by relocating all the
+ * references held by the solver and then calling @b moveTo.
+ */
+ClauseArena::Ref ClauseArena::relocate(Ref r, ClauseArena& to)
+{
+  CALL("ClauseArena::relocate");
+  ASS(!removed(r));
+
+  if (relocated(r)) {
+    return _mem[r+1];
+  }
+
+  unsigned words = clauseWords(length(r));
+  Ref res = to._mem.size();
+  for (unsigned i = 0; i < words; i++) {
+    to._mem.push(_mem[r+i]);
+  }
+  _mem[r] |= RELOCATED_FLAG;
+  _mem[r+1] = res;
+  return res;
+}
+
+/**
+ * Replace the content of the arena @b to by the content of this arena,
+ * this arena becomes empty.
+ */
+void ClauseArena::moveTo(ClauseArena& to)
+{
+  CALL("ClauseArena::moveTo");
+
+  to._mem.reset();
+  std::swap(_mem, to._mem);
+  to._wasted = _wasted;
+  _wasted = 0;
+}
+
+}
@@ -0,0 +1,122 @@
+/*
+ * File ClauseArena.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ClauseArena.hpp
+ * Defines class ClauseArena.
+ */
+
+#ifndef __ClauseArena__
+#define __ClauseArena__
+
+#include <cstring>
+
+#include "Forwards.hpp"
+
+#include "Debug/Assertion.hpp"
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+#include "SATLiteral.hpp"
+
+namespace SAT {
+
+using namespace Lib;
+
+/**
+ * Contiguous storage of the literals of the clauses watched by a SAT solver.
+ *
+ * A clause is referred to by a 32-bit offset into the arena. Each clause
+ * occupies a header word (length and flags), the pointer to the SATClause
+ * it was created from (which carries the inference and the activity) and
+ * the contents of its literals, i.e. 2*var+polarity.
+ *
+ * The order of literals in the arena is independent of the order in the
+ * SATClause, so the solver can keep its watched literals in front without
+ * touching the SATClause during propagation.
+ *
+ * Removed clauses only mark their space as wasted; the space is reclaimed
+ * by relocating the live clauses into a fresh arena (see relocate).
+ */
+class ClauseArena
+{
+public:
+  CLASS_NAME(ClauseArena);
+  USE_ALLOCATOR(ClauseArena);
+
+  typedef unsigned Ref;
+
+  ClauseArena(size_t capacity=1024) : _mem(capacity), _wasted(0) {}
+
+  Ref alloc(SATClause* cl);
+
+  unsigned length(Ref r) const { return _mem[r] >> FLAG_BITS; }
+  SATClause* clause(Ref r) const
+  {
+    SATClause* res;
+    memcpy(&res, &_mem[r+1], sizeof(SATClause*));
+    return res;
+  }
+
+  SATLiteral lit(Ref r, unsigned i) const
+  {
+    ASS_L(i, length(r));
+    return SATLiteral(_mem[r+HEADER_WORDS+i]);
+  }
+  void setLit(Ref r, unsigned i, SATLiteral l)
+  {
+    ASS_L(i, length(r));
+    _mem[r+HEADER_WORDS+i] = l.content();
+  }
+  void swapLits(Ref r, unsigned i, unsigned j)
+  {
+    ASS_L(i, length(r)); ASS_L(j, length(r));
+    std::swap(_mem[r+HEADER_WORDS+i], _mem[r+HEADER_WORDS+j]);
+  }
+
+  bool removed(Ref r) const { return _mem[r] & REMOVED_FLAG; }
+  void remove(Ref r);
+
+  Ref relocate(Ref r, ClauseArena& to);
+  void moveTo(ClauseArena& to);
+
+  /** number of words taken by clauses, including the removed ones */
+  size_t size() const { return _mem.size(); }
+  /** number of words taken by removed clauses */
+  size_t wasted() const { return _wasted; }
+
+  static size_t clauseWords(unsigned length) { return HEADER_WORDS+length; }
+
+private:
+  ClauseArena(const ClauseArena&); //private and undefined
+  ClauseArena& operator=(const ClauseArena&); //private and undefined
+
+  bool relocated(Ref r) const { return _mem[r] & RELOCATED_FLAG; }
+
+  static const unsigned FLAG_BITS = 2;
+  static const unsigned REMOVED_FLAG = 1;
+  /** the clause was moved to another arena, its first pointer word contains the new reference */
+  static const unsigned RELOCATED_FLAG = 2;
+  static const unsigned HEADER_WORDS = 1+(sizeof(SATClause*)+sizeof(unsigned)-1)/sizeof(unsigned);
+
+  Stack<unsigned> _mem;
+  size_t _wasted;
+};
+
+}
+
+#endif // __ClauseArena__
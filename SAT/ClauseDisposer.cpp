@@ -100,6 +100,9 @@ void ClauseDisposer::markAllRemovableUnkept()
 /**
  * We assume that all non-learnt clauses have their 'kept' flag
  * set to true.
+ *
+ * The arena copies of removed clauses are marked as removed, and
+ * when they take more than half of the arena, the arena is compacted.
  */
 void ClauseDisposer::removeUnkept()
 {
@@ -107,17 +110,23 @@ void ClauseDisposer::removeUnkept()
 
   unsigned watchCnt = (varCnt()+1)*2;
   DArray<WatchStack>& watches = getWatchedStackArray();
+  ClauseArena& arena = _solver._arena;
 
   for(unsigned i=2; i<watchCnt; i++) {
     WatchStack::Iterator wit(watches[i]);
     while(wit.hasNext()) {
-      SATClause* cl = wit.next().cl;
-      if(!cl->kept()) {
+      ClauseArena::Ref ref = wit.next().ref;
+      if(!arena.clause(ref)->kept()) {
+	arena.remove(ref);
 	wit.del();
       }
     }
   }
 
+  if(arena.wasted()*2 > arena.size()) {
+    _solver.relocateClauses();
+  }
+
   SATClauseStack::StableDelIterator lrnIt(getLearntStack());
   while(lrnIt.hasNext()) {
     SATClause* cl = lrnIt.next();
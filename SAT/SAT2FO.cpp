@@ -21,8 +21,12 @@
  * Implements class SAT2FO.
  */
 
+#include "Lib/Environment.hpp"
+
 #include "Kernel/Term.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "Preprocess.hpp"
 #include "SATClause.hpp"
 #include "SATInference.hpp"
@@ -68,6 +72,30 @@ Literal* SAT2FO::toFO(SATLiteral sl) const
   return res;
 }
 
+/**
+ * Mark the first-order literals that have a SAT variable as live,
+ * see TermSharing::collect.
+ *
+ * The negative literals are created by toFO on demand and the decision
+ * procedures may cache them, so they are marked as well if they exist.
+ */
+void SAT2FO::markSharedTerms() const
+{
+  CALL("SAT2FO::markSharedTerms");
+
+  unsigned maxVar = maxSATVar();
+  for (unsigned var = 1; var <= maxVar; var++) {
+    Literal* posLit;
+    if (_posMap.findObj(var, posLit)) {
+      env.sharing->markLive(posLit);
+      Literal* negLit = env.sharing->tryGetOpposite(posLit);
+      if (negLit) {
+        env.sharing->markLive(negLit);
+      }
+    }
+  }
+}
+
 /**
  * Convert clause @c cl to a SAT clause with an inference
  * object describing the conversion.
@@ -54,6 +54,8 @@ public:
   SATClause* createConflictClause(LiteralStack& unsatCore, Inference::Rule rule=Inference::THEORY);
 
   unsigned maxSATVar() const { return _posMap.getNumberUpperBound(); }
+
+  void markSharedTerms() const;
   
   void reset(){ _posMap.reset(); }
 private:
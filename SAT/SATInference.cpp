@@ -155,25 +155,19 @@ void InferenceFromSatRefutation::minimizePremises() {
 
   UnitList* newFOPrems = SATInference::getFOPremises(newSatRef);
 
-  // cout << "Minimized from " << _premises->length() << " to " << newFOPrems->length() << endl;
+  // cout << "Minimized from " << _premCnt << " to " << newFOPrems->length() << endl;
 
-  // "release" the old list
-  {
-    UnitList* it=_premises;
-    while(it) {
-      it->head()->decRefCnt();
-      it=it->tail();
-    }
+  // "release" the old premises
+  for (unsigned i = 0; i < _premCnt; i++) {
+    _premises[i]->decRefCnt();
   }
 
-  // assign and keep the new one
+  // assign and keep the new ones
   {
-    _premises = newFOPrems;
-    UnitList* it=_premises;
+    UnitList* it=newFOPrems;
     unsigned maxInd = 0;
     while(it) {
       Unit* u = it->head();
-      u->incRefCnt();
 
       Inference* inf = u->inference();
       Inference::Iterator iit = inf->iterator();
@@ -187,6 +181,7 @@ void InferenceFromSatRefutation::minimizePremises() {
 
       it=it->tail();
     }
+    setPremises(newFOPrems);
     env.statistics->maxInductionDepth=maxInd;
   }
 
@@ -546,16 +546,16 @@ void TWLSolver::doSubsumptionResolution(SATLiteralStack& lits, SATClauseList*& p
     SATClause* resolvingClause = 0;
     WatchStack::Iterator wit(getWatchStack(rLitOp));
     while(wit.hasNext()) {
-      SATClause* cl = wit.next().cl;
-      if(cl->size()!=2) {
+      ClauseArena::Ref ref = wit.next().ref;
+      if(_arena.length(ref)!=2) {
 	continue;
       }
-      SATLiteral other = ((*cl)[0]==rLitOp) ? (*cl)[1] : (*cl)[0];
+      SATLiteral other = (_arena.lit(ref,0)==rLitOp) ? _arena.lit(ref,1) : _arena.lit(ref,0);
       ASS(other!=rLit);
       ASS(other!=rLitOp);
-      ASS((*cl)[0]==rLitOp || (*cl)[1]==rLitOp);
+      ASS(_arena.lit(ref,0)==rLitOp || _arena.lit(ref,1)==rLitOp);
       if(litSet.find(other.content())) {
-	resolvingClause = cl;
+	resolvingClause = _arena.clause(ref);
 	resolved = true;
 	break;
       }
@@ -760,17 +760,17 @@ TWLSolver::ClauseVisitResult TWLSolver::visitWatchedClause(Watch watch, unsigned
     return VR_NONE;
   }
 
-  SATClause* cl = watch.cl;
+  ClauseArena::Ref ref = watch.ref;
 
   unsigned curWatchIndex=
-      ((*cl)[0].var()==var) ? 0 : 1;
-  ASS_EQ((*cl)[curWatchIndex].var(), var);
-  ASS(isFalse((*cl)[curWatchIndex]));
+      (_arena.lit(ref,0).var()==var) ? 0 : 1;
+  ASS_EQ(_arena.lit(ref,curWatchIndex).var(), var);
+  ASS(isFalse(_arena.lit(ref,curWatchIndex)));
 
   unsigned otherWatchIndex=1-curWatchIndex;
 
-  const SATLiteral& otherWatched = (*cl)[otherWatchIndex];
-  ASS_NEQ((*cl)[otherWatchIndex].var(), var);
+  SATLiteral otherWatched = _arena.lit(ref,otherWatchIndex);
+  ASS_NEQ(otherWatched.var(), var);
 
   if(watch.blocker!=otherWatched && isTrue(otherWatched)) {
 //  if(isTrue(otherWatched)) {
@@ -778,11 +778,11 @@ TWLSolver::ClauseVisitResult TWLSolver::visitWatchedClause(Watch watch, unsigned
   }
   ASS(!isTrue(otherWatched));
 
-  unsigned clen=cl->length();
+  unsigned clen=_arena.length(ref);
   unsigned undefIndex=clen; //contains the first undefined non-watched literal or clen if there is none
 
   for(unsigned i=2;i<clen;i++) { //we start from the first non-watched literal (which is at position 2)
-    SATLiteral lit=(*cl)[i];
+    SATLiteral lit=_arena.lit(ref,i);
     if(isTrue(lit)) {
       //clause is true
       return VR_NONE;
@@ -802,7 +802,7 @@ TWLSolver::ClauseVisitResult TWLSolver::visitWatchedClause(Watch watch, unsigned
 
   if(!isUndefined(otherWatched)) {
     //there is no undefined literal, so the whole clause is false
-    ASS_REP(isFalse(cl), *cl);
+    ASS_REP(isFalse(_arena.clause(ref)), *_arena.clause(ref));
     return VR_CONFLICT;
   }
 
@@ -828,27 +828,27 @@ SATClause* TWLSolver::propagate(unsigned var)
   WatchStack::StableDelIterator wit(getTriggeredWatchStack(var, _assignment[var]));
   while(wit.hasNext()) {
     Watch watch=wit.next();
-    SATClause* cl = watch.cl;
+    ClauseArena::Ref ref = watch.ref;
 
     unsigned litIndex;
     ClauseVisitResult cvr = visitWatchedClause(watch, var, litIndex);
     switch(cvr) {
     case VR_CHANGE_WATCH:
     {
-      WatchStack& tgtStack = getWatchStack((*cl)[litIndex]);
-      unsigned curWatchIndex = ((*cl)[0].var()==var) ? 0 : 1;
-      swap( (*cl)[curWatchIndex], (*cl)[litIndex] );
+      WatchStack& tgtStack = getWatchStack(_arena.lit(ref,litIndex));
+      unsigned curWatchIndex = (_arena.lit(ref,0).var()==var) ? 0 : 1;
+      _arena.swapLits(ref, curWatchIndex, litIndex);
       wit.del();
-      tgtStack.push(Watch(cl, (*cl)[1-curWatchIndex]));
+      tgtStack.push(Watch(ref, _arena.lit(ref,1-curWatchIndex)));
       break;
     }
     case VR_CONFLICT:
-      return cl;
+      return _arena.clause(ref);
     case VR_PROPAGATE:
     {
       //So let's unit-propagate...
-      SATLiteral undefLit=(*cl)[litIndex];
-      makeForcedAssignment(undefLit, cl);
+      SATLiteral undefLit=_arena.lit(ref,litIndex);
+      makeForcedAssignment(undefLit, _arena.clause(ref));
       break;
     }
     case VR_NONE:
@@ -1132,14 +1132,37 @@ void TWLSolver::recordClauseActivity(SATClause* cl)
 }
 
 /**
- * Make the first two literals of clause @c cl watched.
+ * Copy clause @c cl into the arena and make its first two literals watched.
  */
 void TWLSolver::insertIntoWatchIndex(SATClause* cl)
 {
   CALL("TWLSolver::insertIntoWatchIndex");
 
-  getWatchStack((*cl)[0]).push(Watch(cl, (*cl)[1]));
-  getWatchStack((*cl)[1]).push(Watch(cl, (*cl)[0]));
+  ClauseArena::Ref ref = _arena.alloc(cl);
+  getWatchStack((*cl)[0]).push(Watch(ref, (*cl)[1]));
+  getWatchStack((*cl)[1]).push(Watch(ref, (*cl)[0]));
+}
+
+/**
+ * Move the watched clauses into a fresh arena, reclaiming the space
+ * of the removed ones. All watches of removed clauses must have been
+ * deleted before.
+ */
+void TWLSolver::relocateClauses()
+{
+  CALL("TWLSolver::relocateClauses");
+
+  ClauseArena newArena(_arena.size()-_arena.wasted());
+
+  unsigned watchCnt = (_varCnt+1)*2;
+  for(unsigned i=2; i<watchCnt; i++) {
+    WatchStack::Iterator wit(_windex[i]);
+    while(wit.hasNext()) {
+      Watch& w = wit.next();
+      w.ref = _arena.relocate(w.ref, newArena);
+    }
+  }
+  newArena.moveTo(_arena);
 }
 
 void TWLSolver::assertValid()
@@ -39,22 +39,24 @@
 #include "SATLiteral.hpp"
 #include "SATClause.hpp"
 #include "SATSolver.hpp"
+#include "ClauseArena.hpp"
 
 namespace SAT {
 
 using namespace Lib;
 using namespace Shell;
 
+/**
+ * Watch of a clause stored in the solver's ClauseArena. The blocker is
+ * the other watched literal at the time the watch was created; if it is
+ * true, the clause need not be visited.
+ */
 struct Watch
 {
   Watch() {}
-  Watch(SATClause* cl, SATLiteral blocker) : blocker(blocker), cl(cl)
-  {
-    CALL("Watch::Watch/2");
-    ASS((*cl)[0]==blocker || (*cl)[1]==blocker);
-  }
+  Watch(ClauseArena::Ref ref, SATLiteral blocker) : blocker(blocker), ref(ref) {}
   SATLiteral blocker;
-  SATClause* cl;
+  ClauseArena::Ref ref;
 };
 
 typedef Stack<Watch> WatchStack;
@@ -214,6 +216,7 @@ private:
   SATClause* getLearntClause(SATClause* conflictClause);
 
   void insertIntoWatchIndex(SATClause* cl);
+  void relocateClauses();
 
   void recordClauseActivity(SATClause* cl);
 
@@ -272,6 +275,13 @@ private:
    * or it's two watched literals are undefined.
    */
   DArray<WatchStack> _windex;
+  /**
+   * Literals of the watched clauses. The watched literals of each
+   * clause are at positions 0 and 1 of its arena copy, the order of
+   * literals in the SATClause objects is not changed after the clause
+   * was inserted into the watch index.
+   */
+  ClauseArena _arena;
 
   /**
    * Number of variables the solver is able to handle.
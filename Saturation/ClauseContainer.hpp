@@ -120,6 +120,8 @@ public:
   Clause* pop();
   bool isEmpty() const
   { return _data.isEmpty(); }
+  unsigned size() const
+  { return _data.size(); }
 private:
   Deque<Clause*> _data;
 };
@@ -0,0 +1,164 @@
+/*
+ * File CriticalPairQueue.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CriticalPairQueue.cpp
+ * Implements class CriticalPairQueue.
+ */
+
+#include "Kernel/Clause.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "CriticalPairQueue.hpp"
+
+namespace Saturation
+{
+
+CriticalPairQueue::CriticalPairQueue(const Options& opt)
+: _ageRatio(opt.ageRatio()), _weightRatio(opt.weightRatio()), _balance(0), _size(0), _superposition(0)
+{
+  CALL("CriticalPairQueue::CriticalPairQueue");
+  ASS(_ageRatio > 0 || _weightRatio > 0);
+}
+
+CriticalPairQueue::~CriticalPairQueue()
+{
+  CALL("CriticalPairQueue::~CriticalPairQueue");
+
+  Stack<Slot>::Iterator sit(_slots);
+  while(sit.hasNext()) {
+    Slot& s = sit.next();
+    if(s.queueCnt && !s.selected) {
+      release(s.pair);
+    }
+  }
+}
+
+/**
+ * Add the pair @b cp to the queue. The parent clauses are referenced
+ * until the pair is selected and released.
+ */
+void CriticalPairQueue::add(const CriticalPair& cp)
+{
+  CALL("CriticalPairQueue::add");
+
+  cp.rwClause->incRefCnt();
+  cp.eqClause->incRefCnt();
+
+  unsigned slot;
+  if(_freeSlots.isNonEmpty()) {
+    slot = _freeSlots.pop();
+  }
+  else {
+    slot = _slots.size();
+    _slots.push(Slot());
+  }
+  Slot& s = _slots[slot];
+  s.pair = cp;
+  s.queueCnt = 0;
+  s.selected = 0;
+
+  if(_ageRatio) {
+    _ageQueue.push_back(slot);
+    s.queueCnt++;
+  }
+  if(_weightRatio) {
+    WeightEntry e;
+    e.weight = cp.weight;
+    e.slot = slot;
+    _weightQueue.insert(e);
+    s.queueCnt++;
+  }
+  _size++;
+}
+
+/**
+ * Remove the slot @b slot from one of the queues. If the pair in it was
+ * not selected yet, assign it into @b res and return true.
+ */
+bool CriticalPairQueue::takeSlot(unsigned slot, CriticalPair& res)
+{
+  CALL("CriticalPairQueue::takeSlot");
+
+  Slot& s = _slots[slot];
+  ASS_G(s.queueCnt,0);
+
+  bool fresh = !s.selected;
+  if(fresh) {
+    res = s.pair;
+    s.selected = 1;
+  }
+  s.queueCnt--;
+  if(!s.queueCnt) {
+    _freeSlots.push(slot);
+  }
+  return fresh;
+}
+
+/**
+ * Select the next pair and assign it into @b res. Return false if
+ * there are no pairs left.
+ *
+ * The caller has to call @b release on the pair after it is processed.
+ */
+bool CriticalPairQueue::popSelected(CriticalPair& res)
+{
+  CALL("CriticalPairQueue::popSelected");
+
+  if(!_size) {
+    return false;
+  }
+  _size--;
+
+  bool byWeight;
+  if (! _ageRatio) {
+    byWeight = true;
+  }
+  else if (! _weightRatio) {
+    byWeight = false;
+  }
+  else if (_balance != 0) {
+    byWeight = _balance > 0;
+  }
+  else {
+    byWeight = (_ageRatio <= _weightRatio);
+  }
+
+  if (byWeight) {
+    _balance -= _ageRatio;
+    while(!takeSlot(_weightQueue.pop().slot, res)) {}
+  }
+  else {
+    _balance += _weightRatio;
+    while(!takeSlot(_ageQueue.pop_front(), res)) {}
+  }
+  return true;
+}
+
+/**
+ * Drop the references to the parents of the pair @b cp
+ */
+void CriticalPairQueue::release(const CriticalPair& cp)
+{
+  CALL("CriticalPairQueue::release");
+
+  cp.rwClause->decRefCnt();
+  cp.eqClause->decRefCnt();
+}
+
+}
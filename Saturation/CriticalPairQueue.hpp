@@ -0,0 +1,135 @@
+/*
+ * File CriticalPairQueue.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CriticalPairQueue.hpp
+ * Defines class CriticalPairQueue.
+ */
+
+#ifndef __CriticalPairQueue__
+#define __CriticalPairQueue__
+
+#include "Forwards.hpp"
+
+#include "Lib/BinaryHeap.hpp"
+#include "Lib/Comparison.hpp"
+#include "Lib/Deque.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Term.hpp"
+
+namespace Saturation
+{
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Shell;
+
+/**
+ * A superposition that was not performed yet, together with the
+ * estimated weight and the age of its result
+ */
+struct CriticalPair
+{
+  Clause* rwClause;
+  Literal* rwLit;
+  TermList rwTerm;
+  Clause* eqClause;
+  Literal* eqLit;
+  TermList eqLHS;
+  unsigned weight;
+  unsigned age : 31;
+  unsigned eqIsResult : 1;
+};
+
+/**
+ * Compact passive set of the Discount loop for unit equality problems.
+ *
+ * Instead of building the results of superpositions when the active
+ * clauses are generated, only the parents and the positions are stored
+ * here, and the result is built when the pair is selected. The pairs
+ * whose parents are no longer active are then discarded. The parents
+ * are referenced by the pairs, so their objects stay valid until the
+ * pairs are selected.
+ *
+ * The pairs are selected in the age-weight ratio of the options from
+ * a FIFO and from a heap ordered by the estimated weight.
+ */
+class CriticalPairQueue
+{
+public:
+  CLASS_NAME(CriticalPairQueue);
+  USE_ALLOCATOR(CriticalPairQueue);
+
+  CriticalPairQueue(const Options& opt);
+  ~CriticalPairQueue();
+
+  void add(const CriticalPair& cp);
+  bool popSelected(CriticalPair& res);
+  static void release(const CriticalPair& cp);
+
+  /** Return true iff there are no pairs left to be selected */
+  bool isEmpty() const { return _size==0; }
+  /** Return the number of pairs left to be selected */
+  unsigned size() const { return _size; }
+
+  /** Set the inference that adds the pairs and builds their results */
+  void setSuperposition(Inferences::Superposition* sup) { _superposition = sup; }
+  Inferences::Superposition* superposition() const { return _superposition; }
+
+private:
+  struct Slot
+  {
+    CriticalPair pair;
+    /** number of the queues that still contain the slot */
+    unsigned queueCnt : 2;
+    /** the pair was already selected from one of the queues */
+    unsigned selected : 1;
+  };
+
+  struct WeightEntry
+  {
+    unsigned weight;
+    unsigned slot;
+
+    static Comparison compare(const WeightEntry& e1, const WeightEntry& e2)
+    {
+      if(e1.weight!=e2.weight) {
+	return e1.weight<e2.weight ? LESS : GREATER;
+      }
+      return e1.slot<e2.slot ? LESS : (e1.slot==e2.slot ? EQUAL : GREATER);
+    }
+  };
+
+  bool takeSlot(unsigned slot, CriticalPair& res);
+
+  int _ageRatio;
+  int _weightRatio;
+  int _balance;
+  /** number of pairs left to be selected */
+  unsigned _size;
+  Inferences::Superposition* _superposition;
+
+  Stack<Slot> _slots;
+  Stack<unsigned> _freeSlots;
+  Deque<unsigned> _ageQueue;
+  BinaryHeap<WeightEntry,WeightEntry> _weightQueue;
+};
+
+}
+
+#endif // __CriticalPairQueue__
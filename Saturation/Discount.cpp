@@ -25,9 +25,14 @@
 #include "Lib/VirtualIterator.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/LiteralSelector.hpp"
+#include "Kernel/Problem.hpp"
+#include "Inferences/Superposition.hpp"
 #include "Shell/Options.hpp"
+#include "Shell/Property.hpp"
 #include "Shell/Statistics.hpp"
 
+#include "CriticalPairQueue.hpp"
+
 #include "Discount.hpp"
 
 using namespace Lib;
@@ -36,6 +41,26 @@ using namespace Shell;
 using namespace Saturation;
 
 
+/**
+ * The compact passive set is only used for unit equality problems,
+ * where all the generated clauses come from superposition
+ */
+Discount::Discount(Problem& prb, const Options& opt)
+: SaturationAlgorithm(prb, opt)
+{
+  CALL("Discount::Discount");
+
+  if(opt.compactPassive() && prb.getProperty()->category()==Property::UEQ &&
+      opt.unificationWithAbstraction()==Options::UnificationWithAbstraction::OFF) {
+    _criticalPairs = new CriticalPairQueue(opt);
+  }
+}
+
+Discount::~Discount()
+{
+  CALL("Discount::~Discount");
+}
+
 ClauseContainer* Discount::getSimplifyingClauseContainer()
 {
   return _active;
@@ -54,3 +79,26 @@ bool Discount::handleClauseBeforeActivation(Clause* cl)
   return true;
 }
 
+/**
+ * Build the results of the selected critical pairs until a clause
+ * makes it into the passive container or there are no pairs left.
+ */
+void Discount::refillPassive()
+{
+  CALL("Discount::refillPassive");
+
+  if(!_criticalPairs) {
+    return;
+  }
+  Inferences::Superposition* sup = _criticalPairs->superposition();
+
+  CriticalPair cp;
+  while(_passive->isEmpty() && _criticalPairs->popSelected(cp)) {
+    Clause* cl = sup->performDeferredSuperposition(cp);
+    CriticalPairQueue::release(cp);
+    if(cl) {
+      addNewClause(cl);
+      doUnprocessedLoop();
+    }
+  }
+}
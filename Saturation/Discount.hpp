@@ -27,6 +27,8 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/ScopedPtr.hpp"
+
 #include "SaturationAlgorithm.hpp"
 
 namespace Saturation {
@@ -40,16 +42,21 @@ public:
   CLASS_NAME(Discount);
   USE_ALLOCATOR(Discount);
 
-  Discount(Problem& prb, const Options& opt)
-    : SaturationAlgorithm(prb, opt) {}
+  Discount(Problem& prb, const Options& opt);
+  ~Discount();
 
   ClauseContainer* getSimplifyingClauseContainer();
+  CriticalPairQueue* getCriticalPairQueue() { return _criticalPairs.ptr(); }
 
 protected:
 
   //overrides SaturationAlgorithm::handleClauseBeforeActivation
   bool handleClauseBeforeActivation(Clause* cl);
+  //overrides SaturationAlgorithm::refillPassive
+  void refillPassive();
 
+private:
+  ScopedPtr<CriticalPairQueue> _criticalPairs;
 };
 
 };
@@ -0,0 +1,120 @@
+/*
+ * File MetricsStream.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file MetricsStream.cpp
+ * Implements class MetricsStream.
+ */
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "Limits.hpp"
+#include "SaturationAlgorithm.hpp"
+#include "Splitter.hpp"
+
+#include "MetricsStream.hpp"
+
+namespace Saturation
+{
+
+MetricsStream::MetricsStream(SaturationAlgorithm& salg, const Options& opt)
+: _salg(salg), _format(opt.metricsFormat()), _activations(opt.metricsActivations()),
+  _interval(opt.metricsInterval()), _out(opt.metricsOutput().c_str()), _steps(0), _lastSteps(0),
+  _lastTime(env.timer->elapsedMilliseconds()), _lastActivations(env.statistics->activeClauses),
+  _simplified(0), _deleted(0)
+{
+  CALL("MetricsStream::MetricsStream");
+
+  if(!_out) {
+    USER_ERROR("Cannot open metrics output file: "+opt.metricsOutput());
+  }
+  if(_format==Options::MetricsFormat::CSV) {
+    _out << "time_ms,steps,active,passive,unprocessed,activations,activations_per_s,"
+	"generated,simplified,deleted,memory,split_levels,age_limit,weight_limit" << std::endl;
+  }
+}
+
+MetricsStream::~MetricsStream()
+{
+  CALL("MetricsStream::~MetricsStream");
+
+  _out.close();
+}
+
+/**
+ * Called after each step of the main loop, writes a record if one is due.
+ */
+void MetricsStream::onStep()
+{
+  CALL("MetricsStream::onStep");
+
+  _steps++;
+  if(_activations && _steps-_lastSteps>=_activations) {
+    writeRecord();
+  }
+  else if(_interval && env.timer->elapsedMilliseconds()-_lastTime>=static_cast<int>(_interval)) {
+    writeRecord();
+  }
+}
+
+void MetricsStream::writeRecord()
+{
+  CALL("MetricsStream::writeRecord");
+
+  int time = env.timer->elapsedMilliseconds();
+  unsigned activations = env.statistics->activeClauses;
+  // activations per second since the previous record
+  unsigned rate = 0;
+  if(time>_lastTime) {
+    rate = static_cast<unsigned>((activations-_lastActivations)*1000ull/(time-_lastTime));
+  }
+  Limits* limits = _salg.getLimits();
+  int ageLimit = limits->ageLimited() ? static_cast<int>(limits->ageLimit()) : -1;
+  int weightLimit = limits->weightLimited() ? static_cast<int>(limits->weightLimit()) : -1;
+  unsigned splitLevels = _salg.getSplitter() ? _salg.getSplitter()->splitLevelCnt() : 0;
+
+  if(_format==Options::MetricsFormat::CSV) {
+    _out << time << ',' << _steps << ',' << _salg.activeClauseCount() << ','
+	<< _salg.passiveClauseCount() << ',' << _salg.unprocessedClauseCount() << ','
+	<< activations << ',' << rate << ',' << env.statistics->generatedClauses << ','
+	<< _simplified << ',' << _deleted << ',' << Allocator::getUsedMemory() << ','
+	<< splitLevels << ',' << ageLimit << ',' << weightLimit << std::endl;
+  }
+  else {
+    _out << "{\"time_ms\":" << time << ",\"steps\":" << _steps
+	<< ",\"active\":" << _salg.activeClauseCount()
+	<< ",\"passive\":" << _salg.passiveClauseCount()
+	<< ",\"unprocessed\":" << _salg.unprocessedClauseCount()
+	<< ",\"activations\":" << activations << ",\"activations_per_s\":" << rate
+	<< ",\"generated\":" << env.statistics->generatedClauses
+	<< ",\"simplified\":" << _simplified << ",\"deleted\":" << _deleted
+	<< ",\"memory\":" << Allocator::getUsedMemory()
+	<< ",\"split_levels\":" << splitLevels
+	<< ",\"age_limit\":" << ageLimit << ",\"weight_limit\":" << weightLimit << "}" << std::endl;
+  }
+
+  _lastSteps = _steps;
+  _lastTime = time;
+  _lastActivations = activations;
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+ * File MetricsStream.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file MetricsStream.hpp
+ * Defines class MetricsStream.
+ */
+
+#ifndef __MetricsStream__
+#define __MetricsStream__
+
+#include <fstream>
+
+#include "Forwards.hpp"
+
+#include "Shell/Options.hpp"
+
+namespace Saturation
+{
+
+using namespace Lib;
+using namespace Shell;
+
+/**
+ * Writes a record of the state of a saturation algorithm into the file
+ * given by the metrics_output option, every metrics_activations steps of
+ * the main loop and every metrics_interval milliseconds.
+ *
+ * Each record contains the sizes of the clause containers, the number of
+ * activations per second since the previous record, the numbers of
+ * generated, simplified and deleted clauses, the allocated memory, the
+ * number of split levels and the current limits.
+ */
+class MetricsStream
+{
+public:
+  CLASS_NAME(MetricsStream);
+  USE_ALLOCATOR(MetricsStream);
+
+  MetricsStream(SaturationAlgorithm& salg, const Options& opt);
+  ~MetricsStream();
+
+  void onStep();
+  void writeRecord();
+
+  /** Count a clause simplified (if @b replaced) or deleted by a reduction */
+  void onClauseReduction(bool replaced)
+  {
+    if(replaced) {
+      _simplified++;
+    }
+    else {
+      _deleted++;
+    }
+  }
+
+private:
+  SaturationAlgorithm& _salg;
+  Options::MetricsFormat _format;
+  unsigned _activations;
+  unsigned _interval;
+
+  std::ofstream _out;
+
+  unsigned _steps;
+  /** number of steps when the last record was written */
+  unsigned _lastSteps;
+  /** time in milliseconds when the last record was written */
+  int _lastTime;
+  /** number of activations when the last record was written */
+  unsigned _lastActivations;
+
+  unsigned _simplified;
+  unsigned _deleted;
+};
+
+}
+
+#endif // __MetricsStream__
@@ -33,6 +33,7 @@
 #include "Lib/System.hpp"
 
 #include "Indexing/LiteralIndexingStructure.hpp"
+#include "Indexing/TermSharing.hpp"
 
 #include "Kernel/Clause.hpp"
 #include "Kernel/ColorHelper.hpp"
@@ -82,6 +83,7 @@
 
 #include "ConsequenceFinder.hpp"
 #include "LabelFinder.hpp"
+#include "MetricsStream.hpp"
 #include "Splitter.hpp"
 #include "SymElOutput.hpp"
 #include "SaturationAlgorithm.hpp"
@@ -122,7 +124,8 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
     _theoryInstSimp(0),
 #endif
     _generatedClauseCount(0),
-    _activationLimit(0)
+    _activationLimit(0),
+    _termSharingGc(false)
 {
   CALL("SaturationAlgorithm::SaturationAlgorithm");
   ASS_EQ(s_instance, 0);  //there can be only one saturation algorithm at a time
@@ -260,6 +263,11 @@ size_t SaturationAlgorithm::passiveClauseCount()
   return _passive->size();
 }
 
+size_t SaturationAlgorithm::unprocessedClauseCount()
+{
+  return _unprocessed->size();
+}
+
 
 /**
  * A function that is called when a clause is added to the active clause container.
@@ -470,6 +478,10 @@ void SaturationAlgorithm::onClauseReduction(Clause* cl, Clause* replacement,
     _splitter->onClauseReduction(cl, pvi( ClauseStack::Iterator(premStack) ), replacement);
   }
 
+  if (_metrics) {
+    _metrics->onClauseReduction(replacement);
+  }
+
   if (replacement) {
     onParenthood(replacement, cl);
     while (premStack.isNonEmpty()) {
@@ -1160,6 +1172,10 @@ void SaturationAlgorithm::doOneAlgorithmStep()
 
   doUnprocessedLoop();
 
+  if (_passive->isEmpty()) {
+    refillPassive();
+  }
+
   if (_passive->isEmpty()) {
     MainLoopResult::TerminationReason termReason =
 	isComplete() ? Statistics::SATISFIABLE : Statistics::REFUTATION_NOT_FOUND;
@@ -1202,6 +1218,19 @@ MainLoopResult SaturationAlgorithm::runImpl()
 {
   CALL("SaturationAlgorithm::runImpl");
 
+  _termSharingGc = _opt.termSharingGc() && termSharingGcSupported();
+  if (_termSharingGc) {
+    // the terms created so far (including those in the problem and in the
+    // preprocessing inferences) are kept, only the clauses created from
+    // now on have to be enumerated when looking for used terms
+    Clause::trackLiveClauses();
+    env.sharing->makePersistent();
+  }
+
+  if (_opt.metricsOutput() != "off") {
+    _metrics = new MetricsStream(*this, _opt);
+  }
+
   unsigned l = 0;
   try
   {
@@ -1212,7 +1241,14 @@ MainLoopResult SaturationAlgorithm::runImpl()
 
       doOneAlgorithmStep();
 
+      if (_termSharingGc && env.sharing->collectionDue()) {
+        collectUnusedTerms();
+      }
+
       Timer::syncClock();
+      if (_metrics) {
+        _metrics->onStep();
+      }
       if (env.timeLimitReached()) {
         throw TimeLimitExceededException();
       }
@@ -1221,11 +1257,91 @@ MainLoopResult SaturationAlgorithm::runImpl()
   catch(ThrowableBase&)
   {
     tryUpdateFinalClauseCount();
+    if (_metrics) {
+      _metrics->writeRecord();
+    }
     throw;
   }
 
 }
 
+/**
+ * Return true if all the shared terms used by this saturation algorithm
+ * can be enumerated, which is needed for collecting the unused ones.
+ *
+ * The inferences checked here keep terms in their own caches.
+ */
+bool SaturationAlgorithm::termSharingGcSupported() const
+{
+  CALL("SaturationAlgorithm::termSharingGcSupported");
+
+  if (_consFinder || _labelFinder || _symEl || _answerLiteralManager || _instantiation) {
+    return false;
+  }
+#if VZ3
+  if (_theoryInstSimp || _opt.satSolver()==Options::SatSolver::Z3) {
+    return false;
+  }
+#endif
+  // the congruence closure keeps its term names between the calls
+  return !_opt.equationalTautologyRemoval();
+}
+
+/**
+ * Free the shared terms and literals that are not used by any existing
+ * clause or index (see the term_sharing_gc option).
+ *
+ * Called between two steps of the main loop, when no inference is
+ * in progress.
+ */
+void SaturationAlgorithm::collectUnusedTerms()
+{
+  CALL("SaturationAlgorithm::collectUnusedTerms");
+  ASS(_termSharingGc);
+
+  if (!_imgr->markSharedTerms()) {
+    // one of the indexes cannot enumerate its terms
+    env.sharing->clearMarks();
+    _termSharingGc = false;
+    return;
+  }
+  if (_splitter) {
+    _splitter->markSharedTerms();
+  }
+  InferenceStore::instance()->markSharedTerms();
+
+  // the formulas introduced during saturation (e.g. the AVATAR
+  // definitions) are only reachable from the clauses they justify
+  static DHSet<Unit*> seen;
+  static Stack<Unit*> toDo;
+  seen.reset();
+  DHSet<Clause*>::Iterator cit(*Clause::liveClauses());
+  while (cit.hasNext()) {
+    Clause* cl = cit.next();
+    unsigned clen = cl->length();
+    for (unsigned i = 0; i < clen; i++) {
+      env.sharing->markLive((*cl)[i]);
+    }
+    toDo.push(cl);
+    while (toDo.isNonEmpty()) {
+      Unit* u = toDo.pop();
+      if (!u->isClause()) {
+        env.sharing->markLive(static_cast<FormulaUnit*>(u)->formula());
+      }
+      Inference* inf = u->inference();
+      Inference::Iterator iit = inf->iterator();
+      while (inf->hasNext(iit)) {
+        Unit* par = inf->next(iit);
+        if (!par->isClause() && seen.insert(par)) {
+          toDo.push(par);
+        }
+      }
+    }
+  }
+
+  env.sharing->collect();
+}
+
 #if VZ3
 void SaturationAlgorithm::setTheoryInstAndSimp(TheoryInstAndSimp* t)
 {
@@ -74,6 +74,9 @@ public:
   void initAlgorithmRun();
   void doOneAlgorithmStep();
 
+  bool termSharingGcSupported() const;
+  void collectUnusedTerms();
+
   UnitList* collectSaturatedSet();
 
   void setGeneratingInferenceEngine(GeneratingInferenceEngine* generator);
@@ -104,11 +107,17 @@ public:
   ExtensionalityClauseContainer* getExtensionalityClauseContainer() {
     return _extensionality;
   }
+  /**
+   * Return the queue in which generating inferences may store their
+   * conclusions unbuilt, or zero if they should be built right away
+   */
+  virtual CriticalPairQueue* getCriticalPairQueue() { return 0; }
 
   ClauseIterator activeClauses();
   ClauseIterator passiveClauses();
   size_t activeClauseCount();
   size_t passiveClauseCount();
+  size_t unprocessedClauseCount();
 
   Limits* getLimits() { return &_limits; }
   IndexManager* getIndexManager() { return _imgr.ptr(); }
@@ -138,6 +147,8 @@ protected:
   virtual void init();
   virtual MainLoopResult runImpl();
   void doUnprocessedLoop();
+  /** Called when the passive container runs empty, may add new passive clauses */
+  virtual void refillPassive() {}
   virtual void handleUnsuccessfulActivation(Clause* c);
   virtual bool handleClauseBeforeActivation(Clause* c);
   void addInputSOSClause(Clause* cl);
@@ -236,6 +247,12 @@ protected:
   unsigned _generatedClauseCount;
 
   unsigned _activationLimit;
+
+  /** true if unused shared terms are being collected, see collectUnusedTerms() */
+  bool _termSharingGc;
+
+  /** non-zero if the metrics_output option is set */
+  ScopedPtr<MetricsStream> _metrics;
 };
 
 
@@ -41,6 +41,8 @@
 #include "Kernel/FormulaUnit.hpp"
 #include "Kernel/MainLoop.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "Shell/Options.hpp"
 #include "Shell/Refutation.hpp"
 #include "Shell/Statistics.hpp"
@@ -52,8 +54,11 @@
 #include "SAT/BufferedSolver.hpp"
 #include "SAT/FallbackSolverWrapper.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/CDCLSolver.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
+#include "Test/RecordingSatSolver.hpp"
+
 #include "DP/ShortConflictMetaDP.hpp"
 
 #include "SaturationAlgorithm.hpp"
@@ -83,6 +88,9 @@ void SplittingBranchSelector::init()
     case Options::SatSolver::MINISAT:
       _solver = new MinisatInterfacing(_parent.getOptions(),true);
       break;      
+    case Options::SatSolver::CDCL:
+      _solver = new CDCLSolver(_parent.getOptions(),true);
+      break;
 #if VZ3
     case Options::SatSolver::Z3:
       { BYPASSING_ALLOCATOR
@@ -116,6 +124,10 @@ void SplittingBranchSelector::init()
   }
   _minSCO = _parent.getOptions().splittingMinimizeModel() == Options::SplittingMinimizeModel::SCO;
 
+  if(_parent.getOptions().satTrace()!="off") {
+    _solver = new Test::RecordingSatSolver(_solver.release(), _parent.getOptions(), "avatar");
+  }
+
   if(_parent.getOptions().splittingCongruenceClosure() != Options::SplittingCongruenceClosure::OFF) {
     _dp = new DP::SimpleCongruenceClosure(&_parent.getOrdering());
     if (_parent.getOptions().ccUnsatCores() == Options::CCUnsatCores::SMALL_ONES) {
@@ -778,6 +790,23 @@ void Splitter::collectDependenceLits(SplitSet* splits, SATLiteralStack& acc) con
   }
 }
 
+/**
+ * Mark the shared terms used by the splitter outside of clauses
+ * as live, see TermSharing::collect.
+ */
+void Splitter::markSharedTerms()
+{
+  CALL("Splitter::markSharedTerms");
+
+  _sat2fo.markSharedTerms();
+  _componentIdx->markSharedTerms();
+
+  DHMap<SplitLevel,Unit*>::Iterator dit(_defs);
+  while (dit.hasNext()) {
+    env.sharing->markLive(static_cast<FormulaUnit*>(dit.next())->formula());
+  }
+}
+
 Clause* Splitter::getComponentClause(SplitLevel name) const
 {
   CALL("Splitter::getComponentClause");
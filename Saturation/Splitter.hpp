@@ -216,6 +216,8 @@ public:
 
   SAT2FO& satNaming() { return _sat2fo; }
 
+  void markSharedTerms();
+
   UnitList* explicateAssertionsForSaturatedClauseSet(UnitList* clauses);
   static bool getComponents(Clause* cl, Stack<LiteralStack>& acc);
 private:
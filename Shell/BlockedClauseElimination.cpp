@@ -38,6 +38,8 @@
 #include "Kernel/RobSubstitution.hpp"
 #include "Kernel/EqHelper.hpp"
 
+#include "Indexing/LiteralSubstitutionTree.hpp"
+
 #include "Lib/SmartPtr.hpp"
 #include "Lib/DHSet.hpp"
 #include "Lib/DHMap.hpp"
@@ -70,6 +72,12 @@ void BlockedClauseElimination::apply(Problem& prb)
 
   Stack<ClWrapper*> wrappers; // just to delete easily in the end
 
+  // Without equality, a literal only resolves with the unifiable complementary literals,
+  // so these are looked up in an index. The equational check works modulo congruence
+  // and all the complementary literals of the same predicate need to be tested.
+  LiteralSubstitutionTree index;
+  DHMap<Clause*,ClWrapper*> clauseWrappers;
+
   // put the clauses into the index
   UnitList::Iterator uit(prb.units());
   while(uit.hasNext()) {
@@ -78,6 +86,9 @@ void BlockedClauseElimination::apply(Problem& prb)
 
     ClWrapper* clw = new ClWrapper(cl);
     wrappers.push(clw);
+    if (!equationally) {
+      clauseWrappers.insert(cl,clw);
+    }
 
     for(unsigned i=0; i<cl->length(); i++) {
       Literal* lit = (*cl)[i];
@@ -85,7 +96,12 @@ void BlockedClauseElimination::apply(Problem& prb)
       if (!env.signature->getPredicate(pred)->protectedSymbol()) { // don't index on interpreted or otherwise protected predicates (=> the cannot be ``flipped'')
         ASS(pred); // equality predicate is protected
 
-        (lit->isPositive() ? positive : negative)[pred].push(new Candidate {clw,i,0,0});
+        Candidate* cand = new Candidate {clw,i,0,0,0};
+        (lit->isPositive() ? positive : negative)[pred].push(cand);
+        clw->candidates.push(cand);
+        if (!equationally) {
+          index.insert(lit,cl);
+        }
       }
     }
   }
@@ -95,23 +111,32 @@ void BlockedClauseElimination::apply(Problem& prb)
   typedef BinaryHeap<Candidate*, CandidateComparator> BlockClauseCheckPriorityQueue;
   BlockClauseCheckPriorityQueue queue;
 
+  size_t candidateCnt = 0;
   for (bool pos : {false, true}) {
     DArray<Stack<Candidate*>>& one   = pos ? positive : negative;
     DArray<Stack<Candidate*>>& other = pos ? negative : positive;
 
     for (unsigned pred = 1; pred < one.size(); pred++) { // skipping 0; the empty slot for equality
       Stack<Candidate*>& predsCandidates = one[pred];
-      unsigned predsRemaining = other[pred].size();
+      unsigned predsRemaining = other[pred].size(); // without equality only an upper bound, refined on the first visit
       for (unsigned i = 0; i < predsCandidates.size(); i++) {
         Candidate* cand = predsCandidates[i];
         cand->weight = predsRemaining;
+        if (equationally) {
+          cand->partners = &other[pred];
+        }
         queue.insert(cand);
       }
+      candidateCnt += predsCandidates.size();
     }
   }
 
   // cout << "Queue initialized" << endl;
 
+  // the work is the number of partners tested plus the number of partners stored
+  size_t budget = env.options->blockedClauseEliminationBudget()*candidateCnt;
+  size_t work = 0;
+
   while (!queue.isEmpty()) {
     Candidate* cand = queue.pop();
     ClWrapper* clw = cand->clw;
@@ -123,30 +148,78 @@ void BlockedClauseElimination::apply(Problem& prb)
     // clause still undecided
     Clause* cl = clw->cl;
     Literal* lit = (*cl)[cand->litIdx];
-    unsigned pred = lit->functor();
-    Stack<Candidate*>& partners = (lit->isPositive() ? negative : positive)[pred];
-
-    for (unsigned i = cand->contFrom; i < partners.size(); i++) {
-      Candidate* partner = partners[i];
-      ClWrapper* pclw = partner->clw;
 
-      // don't need to check blockedness with itself
-      if (pclw == clw) {
-        continue;
+    if (!cand->partners && !cand->contFrom) {
+      ASS(!equationally);
+      // first visit: test the partners as they are retrieved, as most candidates fail early
+      SLQueryResultIterator pit = index.getUnifications(lit,true,false);
+      unsigned retrieved = 0;
+      while (pit.hasNext()) {
+        SLQueryResult qr = pit.next();
+        retrieved++;
+        ClWrapper* pclw = clauseWrappers.get(qr.clause);
+
+        if (pclw == clw || pclw->blocked) {
+          continue;
+        }
+
+        if (budget && ++work > budget) {
+          goto search_finished;
+        }
+
+        if (!resolvesToTautology(false,cl,lit,pclw->cl,qr.literal)) {
+          // the unifiable partners are retrieved in the same order when cand gets resurrected
+          cand->contFrom = retrieved;
+          cand->weight = cand->weight > retrieved ? cand->weight - retrieved : 0;
+          pclw->toResurrect.push(cand);
+          goto next_candidate;
+        }
+      }
+    }
+    else {
+      if (!cand->partners) {
+        ASS(!equationally);
+        // resurrected: keep the partners, so that further resurrections can continue cheaply
+        Stack<Candidate*>* partners = new Stack<Candidate*>();
+        cand->partners = partners;
+        SLQueryResultIterator pit = index.getUnifications(lit,true,false);
+        while (pit.hasNext()) {
+          if (budget && ++work > budget) {
+            goto search_finished;
+          }
+          SLQueryResult qr = pit.next();
+          partners->push(findCandidate(clauseWrappers.get(qr.clause),qr.literal));
+        }
       }
 
-      Clause* pcl = pclw->cl;
+      Stack<Candidate*>& partners = *cand->partners;
 
-      if (pclw->blocked) {
-        continue;
-      }
+      for (unsigned i = cand->contFrom; i < partners.size(); i++) {
+        Candidate* partner = partners[i];
+        ClWrapper* pclw = partner->clw;
+
+        // don't need to check blockedness with itself
+        if (pclw == clw) {
+          continue;
+        }
+
+        Clause* pcl = pclw->cl;
+
+        if (pclw->blocked) {
+          continue;
+        }
 
-      if (!resolvesToTautology(equationally,cl,lit,pcl,(*pcl)[partner->litIdx])) {
-        // cand does not work, because of partner; need to wait for the partner to die
-        cand->contFrom = i+1;
-        cand->weight = partners.size() - cand->contFrom;
-        pclw->toResurrect.push(cand);
-        goto next_candidate;
+        if (budget && ++work > budget) {
+          goto search_finished;
+        }
+
+        if (!resolvesToTautology(equationally,cl,lit,pcl,(*pcl)[partner->litIdx])) {
+          // cand does not work, because of partner; need to wait for the partner to die
+          cand->contFrom = i+1;
+          cand->weight = partners.size() - cand->contFrom;
+          pclw->toResurrect.push(cand);
+          goto next_candidate;
+        }
       }
     }
 
@@ -167,6 +240,12 @@ void BlockedClauseElimination::apply(Problem& prb)
     next_candidate: ;
   }
 
+  search_finished:
+  if (budget && work > budget && env.options->showPreprocessing()) {
+    // the remaining candidates are simply left unblocked
+    cout << "[PP] Blocked clause elimination ran out of budget" << endl;
+  }
+
   // delete candidates:
   for (bool pos : {false, true}) {
     DArray<Stack<Candidate*>> & one   = pos ? positive : negative;
@@ -174,6 +253,9 @@ void BlockedClauseElimination::apply(Problem& prb)
     for (unsigned pred = 0; pred < one.size(); pred++) {
       Stack<Candidate*>& predsCandidates = one[pred];
       for (unsigned i = 0; i < predsCandidates.size(); i++) {
+        if (!equationally && predsCandidates[i]->partners) {
+          delete predsCandidates[i]->partners;
+        }
         delete predsCandidates[i];
       }
     }
@@ -197,6 +279,24 @@ void BlockedClauseElimination::apply(Problem& prb)
   }
 }
 
+/**
+ * Return the candidate of the literal @b lit of the clause wrapped by @b clw.
+ */
+BlockedClauseElimination::Candidate* BlockedClauseElimination::findCandidate(ClWrapper* clw, Literal* lit)
+{
+  CALL("BlockedClauseElimination::findCandidate");
+
+  Stack<Candidate*>::Iterator cit(clw->candidates);
+  while (cit.hasNext()) {
+    Candidate* cand = cit.next();
+    if ((*clw->cl)[cand->litIdx] == lit) {
+      return cand;
+    }
+  }
+  ASSERTION_VIOLATION;
+  return 0;
+}
+
 bool BlockedClauseElimination::resolvesToTautology(bool equationally, Clause* cl, Literal* lit, Clause* pcl, Literal* plit)
 {
   CALL("BlockedClauseElimination::resolvesToTautology");
@@ -54,8 +54,9 @@ private:
 
     ClWrapper* clw;
     unsigned litIdx;    // index of the potentially blocking literal L
-    unsigned contFrom;  // index of the next resolution partner to try in op(L)'s list
+    unsigned contFrom;  // index of the next resolution partner to try in partners
     unsigned weight;    // how many resolution partners still need to be tested -- used to order the priority queue on
+    Stack<Candidate*>* partners; // the potential resolution partners, shared per predicate or computed on the first resurrection
   };
 
   struct CandidateComparator {
@@ -71,10 +72,13 @@ private:
     Clause* cl;            // the actual clause
     bool blocked;          // if already blocked, don't need to try again
     Stack<Candidate*> toResurrect; // when getting block (effectively deleted, all these have a chance again)
+    Stack<Candidate*> candidates;  // the candidates of cl's literals
 
     ClWrapper(Clause* cl) : cl(cl), blocked(false) {}
   };
 
+  Candidate* findCandidate(ClWrapper* clw, Literal* lit);
+
   bool resolvesToTautology(bool equationally, Clause* cl, Literal* lit, Clause* pcl, Literal* plit);
 
   bool resolvesToTautologyUn(Clause* cl, Literal* lit, Clause* pcl, Literal* plit);
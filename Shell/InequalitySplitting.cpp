@@ -143,10 +143,10 @@ Clause* InequalitySplitting::trySplitClause(Clause* cl)
   cout<<"---------"<<endl;
   cout<<"IEQ split from: "<<(*cl)<<endl;
   cout<<"IEQ split to: "<<(*res)<<endl;
-  UnitList::Iterator pit(premises);
-  ALWAYS(pit.hasNext()); pit.next();
-  while(pit.hasNext()) {
-    cout<<"IEQ name: "<<pit.next()->toString()<<endl;
+  Inference::Iterator pit = inf->iterator();
+  ALWAYS(inf->hasNext(pit)); inf->next(pit);
+  while(inf->hasNext(pit)) {
+    cout<<"IEQ name: "<<inf->next(pit)->toString()<<endl;
   }
 #endif
 
@@ -124,13 +124,13 @@ void NewCNF::clausify(FormulaUnit* unit,Stack<Clause*>& output)
   _maxVar = 0;
   _freeVars.reset();
 
-  { // destroy the cached substitution entries
-    DHMap<BindingList*,Substitution*>::DelIterator dIt(_substitutionsByBindings);
-    while (dIt.hasNext()) {
-      delete dIt.next();
-      dIt.del();
-    }
+  // destroy the cached substitution entries
+  // (iterating over the map would take time proportional to its capacity,
+  // which is given by the largest formula clausified so far)
+  while (_cachedSubstitutions.isNonEmpty()) {
+    delete _cachedSubstitutions.pop();
   }
+  _substitutionsByBindings.reset();
 
   ASS(_queue.isEmpty());
   ASS(_occurrences.isEmpty());
@@ -1393,6 +1393,7 @@ Clause* NewCNF::toClause(SPGenClause gc)
       subst->bind(b.first, b.second);
     }
     _substitutionsByBindings.insert(gc->bindings, subst);
+    _cachedSubstitutions.push(subst);
   }
 
   static Stack<Literal*> properLiterals;
@@ -601,6 +601,7 @@ private:
   // caching binding substitutions for the final phase of GenClause -> Clause transformation
   // this saves time, because bindings are potentially shared
   DHMap<BindingList*,Substitution*> _substitutionsByBindings;
+  Stack<Substitution*> _cachedSubstitutions;
 
   void skolemise(QuantifiedFormula* g, BindingList* &bindings, BindingList*& foolBindings);
 
@@ -121,6 +121,7 @@ void Options::Options::init()
                                         "profile",
                                         "random_strategy",
                                         "sat_solver",
+                                        "server",
                                         "smtcomp",
                                         "spider",
                                         "tclausify",
@@ -135,6 +136,7 @@ void Options::Options::init()
     "  -tpreprocess,tclausify: output modes for theory input"
     "  -output,profile: output information about the problem\n"
     "  -sat_solver: accepts problems in DIMACS and uses the internal sat solver\n   directly\n"
+    "  -server: solves a stream of problems read from the standard input or a socket\n   (see server_socket)\n"
     "Some modes are not currently maintained:\n"
     "  -bpa: perform bound propagation\n"
     "  -consequence_elimination: perform consequence elimination\n"
@@ -192,6 +194,15 @@ void Options::Options::init()
         Or(_mode.is(equal(Mode::SMTCOMP)))->
         Or(_mode.is(equal(Mode::PORTFOLIO)))));
 
+    _portfolioPreprocessingSharing = BoolOptionValue("portfolio_preprocessing_sharing","pps",true);
+    _portfolioPreprocessingSharing.description = "When running in portfolio mode, preprocess the problem only once for all strategies with the same preprocessing options and start these strategies from the preprocessed problem";
+    _lookup.insert(&_portfolioPreprocessingSharing);
+    _portfolioPreprocessingSharing.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))));
+    _portfolioPreprocessingSharing.setExperimental();
+
     _ltbLearning = ChoiceOptionValue<LTBLearning>("ltb_learning","ltbl",LTBLearning::OFF,{"on","off","biased"});
     _ltbLearning.description = "Perform learning in LTB mode";
     _lookup.insert(&_ltbLearning);
@@ -201,6 +212,12 @@ void Options::Options::init()
     _ltbDirectory.description = "Directory for output from LTB mode. Default is to put output next to problem.";
     _lookup.insert(&_ltbDirectory);
 
+    _serverSocket = StringOptionValue("server_socket","","");
+    _serverSocket.description = "Path of a UNIX socket on which the server mode accepts connections."
+                                " Default is to read the problems from the standard input.";
+    _lookup.insert(&_serverSocket);
+    _serverSocket.reliesOn(_mode.is(equal(Mode::SERVER)));
+
     _decode = DecodeOptionValue("decode","",this);
     _decode.description="Decodes an encoded strategy. Can be used to replay a strategy. To make Vampire output an encoded version of the strategy use the encode option.";
     _lookup.insert(&_decode);
@@ -301,6 +318,14 @@ void Options::Options::init()
       "of extra information may change between minor releases";
     _lookup.insert(&_proofExtra);
 
+    _pruneDeletedInferences = BoolOptionValue("prune_deleted_inferences","pdi",false);
+    _pruneDeletedInferences.description="Clauses removed from the search forget their premises, so that their "
+      "ancestors are freed unless other clauses still derive from them. This saves memory on long runs, "
+      "but no proof can be output.";
+    _lookup.insert(&_pruneDeletedInferences);
+    _pruneDeletedInferences.tag(OptionTag::OUTPUT);
+    _pruneDeletedInferences.addHardConstraint(If(equal(true)).then(_proof.is(equal(Proof::OFF))));
+
     _proofChecking = BoolOptionValue("proof_checking","",false);
     _proofChecking.description="";
     _lookup.insert(&_proofChecking);
@@ -497,6 +522,12 @@ void Options::Options::init()
     _blockedClauseElimination.addProblemConstraint(notWithCat(Property::UEQ));
     _blockedClauseElimination.setRandomChoices({"on","off"});
 
+    _blockedClauseEliminationBudget = UnsignedOptionValue("blocked_clause_elimination_budget","bceb",100);
+    _blockedClauseEliminationBudget.description="The number of resolution partners blocked clause elimination may retrieve and test per literal of the problem, on average. When the budget is exhausted, the remaining clauses are kept. 0 means no limit.";
+    _lookup.insert(&_blockedClauseEliminationBudget);
+    _blockedClauseEliminationBudget.tag(OptionTag::PREPROCESSING);
+    _blockedClauseEliminationBudget.reliesOn(_blockedClauseElimination.is(equal(true)));
+
     _theoryAxioms = ChoiceOptionValue<TheoryAxiomLevel>("theory_axioms","tha",TheoryAxiomLevel::ON,{"on","off","some"});
     _theoryAxioms.description="Include theory axioms for detected interpreted symbols";
     _lookup.insert(&_theoryAxioms);
@@ -601,6 +632,42 @@ void Options::Options::init()
     _lookup.insert(&_outputAxiomNames);
     _outputAxiomNames.tag(OptionTag::OUTPUT);
 
+    _metricsOutput = StringOptionValue("metrics_output","","off");
+    _metricsOutput.description="File to which a record of the state of the saturation algorithm is written"
+                               " periodically during the run (see metrics_activations and metrics_interval).";
+    _lookup.insert(&_metricsOutput);
+    _metricsOutput.tag(OptionTag::OUTPUT);
+
+    _metricsFormat = ChoiceOptionValue<MetricsFormat>("metrics_format","",MetricsFormat::JSON,{"csv","json"});
+    _metricsFormat.description="Format of the records written to metrics_output: csv with a header line,"
+                               " or json with one object per line.";
+    _lookup.insert(&_metricsFormat);
+    _metricsFormat.tag(OptionTag::OUTPUT);
+
+    _metricsActivations = UnsignedOptionValue("metrics_activations","",0);
+    _metricsActivations.description="Write a metrics record after every this many steps of the main loop."
+                                    " 0 means no records are written based on the number of steps.";
+    _lookup.insert(&_metricsActivations);
+    _metricsActivations.tag(OptionTag::OUTPUT);
+
+    _metricsInterval = UnsignedOptionValue("metrics_interval","",1000);
+    _metricsInterval.description="Write a metrics record when this many milliseconds passed since the last one."
+                                 " 0 means no records are written based on time.";
+    _lookup.insert(&_metricsInterval);
+    _metricsInterval.tag(OptionTag::OUTPUT);
+
+    _indexTrace = StringOptionValue("index_trace","","off");
+    _indexTrace.description="File to which the insertions, removals and queries of the term and literal"
+                            " indexing structures are written. The trace can be replayed by the ir module of vutil.";
+    _lookup.insert(&_indexTrace);
+    _indexTrace.tag(OptionTag::DEVELOPMENT);
+
+    _satTrace = StringOptionValue("sat_trace","","off");
+    _satTrace.description="File to which the calls to the SAT solvers of AVATAR and the finite model builder"
+                          " are written. The trace can be replayed by the sr module of vutil.";
+    _lookup.insert(&_satTrace);
+    _satTrace.tag(OptionTag::DEVELOPMENT);
+
 
     _printClausifierPremises = BoolOptionValue("print_clausifier_premises","",false);
     _printClausifierPremises.description="Output how the clausified problem was derived.";
@@ -726,6 +793,28 @@ void Options::Options::init()
     _saturationAlgorithm.setRandomChoices(Or(hasCat(Property::UEQ),atomsLessThan(4000)),{"lrs","discount","otter","inst_gen"});
     _saturationAlgorithm.setRandomChoices({"discount","inst_gen","lrs","otter"});
 
+    _compactPassive = BoolOptionValue("compact_passive","cpa",false);
+    _compactPassive.description = "For unit equality problems, keep the passive superpositions of the discount"
+                                  " loop only as references to their parents and build their results when they"
+                                  " are selected. This uses much less memory than the passive clauses.";
+    _compactPassive.tag(OptionTag::SATURATION);
+    _lookup.insert(&_compactPassive);
+    _compactPassive.reliesOn(_saturationAlgorithm.is(equal(SaturationAlgorithm::DISCOUNT)));
+
+    _lazyIndexes = BoolOptionValue("lazy_indexes","lzi",false);
+    _lazyIndexes.description = "Insert clauses into the simplifying and generating indexes only when the index"
+                               " is first queried. Until then the index only keeps the set of its clauses.";
+    _lazyIndexes.tag(OptionTag::SATURATION);
+    _lookup.insert(&_lazyIndexes);
+
+    _lazyIndexDrop = UnsignedOptionValue("lazy_index_drop","lzid",0);
+    _lazyIndexDrop.description = "Empty a lazy index again after this many clauses were inserted into it"
+                                 " without a query. 0 means lazy indexes are never emptied.";
+    _lazyIndexDrop.tag(OptionTag::SATURATION);
+    _lookup.insert(&_lazyIndexDrop);
+    _lazyIndexDrop.reliesOn(_lazyIndexes.is(equal(true)));
+    _lazyIndexDrop.setExperimental();
+
 #if VZ3
     _smtForGround = BoolOptionValue("smt_for_ground","smtfg",true);
     _smtForGround.description = "When a (theory) problem is ground after preprocessing pass it to Z3. In this case we can return sat if Z3 does.";
@@ -798,6 +887,11 @@ void Options::Options::init()
     _fmbEnumerationStrategy.setExperimental();
     _lookup.insert(&_fmbEnumerationStrategy);
 
+    _fmbCubeProcesses = UnsignedOptionValue("fmb_cube_processes","fmbcp",0);
+    _fmbCubeProcesses.description = "Solve the SAT instances of finite model building by cube-and-conquer in this many worker processes. The instance is split on the most constraining symbol literals and the cubes are distributed among the workers. 0 or 1 means a single SAT call in the main process.";
+    _fmbCubeProcesses.setExperimental();
+    _lookup.insert(&_fmbCubeProcesses);
+
     _selection = SelectionOptionValue("selection","s",10);
     _selection.description=
     "Selection methods 2,3,4,10,11 are complete by virtue of extending Maximal i.e. they select the best among maximal. Methods 1002,1003,1004,1010,1011 relax this restriction and are therefore not complete.\n"
@@ -828,6 +922,14 @@ void Options::Options::init()
     _lookaheadDelay.tag(OptionTag::SATURATION);
     _lookup.insert(&_lookaheadDelay);
     _lookaheadDelay.reliesOn(_selection.isLookAheadSelection());
+
+    _lookaheadExact = BoolOptionValue("lookahead_exact","lsx",false);
+    _lookaheadExact.description = "Make lookahead selection count the inferences of each literal by querying"
+                                  " the generating indexes. Otherwise the counts are estimated from sketches"
+                                  " maintained by the indexes, which is much cheaper for long clauses";
+    _lookaheadExact.tag(OptionTag::SATURATION);
+    _lookup.insert(&_lookaheadExact);
+    _lookaheadExact.reliesOn(_selection.isLookAheadSelection());
     
     _ageWeightRatio = RatioOptionValue("age_weight_ratio","awr",1,1,':');
     _ageWeightRatio.description=
@@ -843,6 +945,14 @@ void Options::Options::init()
 	    _literalMaximalityAftercheck.tag(OptionTag::SATURATION);
 	    _literalMaximalityAftercheck.setExperimental();
 
+	    _termSharingGc = BoolOptionValue("term_sharing_gc","tsgc",false);
+	    _termSharingGc.description=
+	    "Free the shared terms and literals not used by any clause or index during saturation. "
+	    "A collection is done whenever the number of shared terms and literals doubled since the last one. "
+	    "No collection is done if some of the used indexes or inferences cannot enumerate the terms they keep.";
+	    _lookup.insert(&_termSharingGc);
+	    _termSharingGc.tag(OptionTag::SATURATION);
+
 	    _lrsFirstTimeCheck = IntOptionValue("lrs_first_time_check","",5);
 	    _lrsFirstTimeCheck.description=
 	    "Percentage of time limit at which the LRS algorithm will for the first time estimate the number of reachable clauses.";
@@ -1528,12 +1638,13 @@ void Options::Options::init()
 
     _satSolver = ChoiceOptionValue<SatSolver>("sat_solver","sas",SatSolver::MINISAT,
 #if VZ3
-            {"minisat","vampire","z3"});
+            {"minisat","vampire","cdcl","z3"});
 #else
-    {"minisat","vampire"});
+    {"minisat","vampire","cdcl"});
 #endif
     _satSolver.description=
-    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption.";
+    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption."
+    " The cdcl solver (with LBD based clause deletion, chronological backtracking and vivification) is also used by fmb.";
     _lookup.insert(&_satSolver);
     _satSolver.tag(OptionTag::SAT);
     _satSolver.setRandomChoices(
@@ -2892,6 +3003,68 @@ vstring Options::generateEncodedOptions() const
 }
 
 
+/**
+ * Return a string which is the same for two sets of options derived from
+ * the same base options (such as the strategies of a schedule) if
+ * preprocessing a problem with either of them gives the same result.
+ *
+ * All options contribute to the key except for those that only concern
+ * the saturation and a few that differ for every strategy (the time
+ * limit etc.). The saturation options that are read already during
+ * preprocessing contribute as well.
+ */
+vstring Options::generatePreprocessingKey() const
+{
+  CALL("Options::generatePreprocessingKey");
+
+  BYPASSING_ALLOCATOR;
+
+  Set<const AbstractOptionValue*> ignored;
+  ignored.insert(&_timeLimitInDeciseconds);
+  ignored.insert(&_activationLimit);
+  ignored.insert(&_testId);
+  ignored.insert(&_decode);
+  // not tagged as saturation options, but only used there
+  ignored.insert(&_sos);
+  ignored.insert(&_useHashingVariantIndex);
+
+  Set<const AbstractOptionValue*> preprocessing;
+  preprocessing.insert(&_bfnt); // DistinctGroupExpansion
+  preprocessing.insert(&_symbolPrecedence); // Property
+  preprocessing.insert(&_FOOLParamodulation); // TheoryAxioms
+  preprocessing.insert(&_termAlgebraCyclicityCheck);
+  preprocessing.insert(&_induction); // Clause
+
+  vostringstream res;
+  VirtualIterator<AbstractOptionValue*> options = _lookup.values();
+  while(options.hasNext()){
+    AbstractOptionValue* option = options.next();
+    if(option->isDefault() || ignored.contains(option)){
+      continue;
+    }
+    switch(option->getTag()){
+    case OptionTag::SATURATION:
+    case OptionTag::INFERENCES:
+    case OptionTag::AVATAR:
+    case OptionTag::LRS:
+    case OptionTag::SAT:
+    case OptionTag::INST_GEN:
+      if(!preprocessing.contains(option)){
+        continue;
+      }
+      break;
+    default:
+      break;
+    }
+    res << option->longName << "=" << option->getStringOfActual() << ":";
+  }
+  // DistinctGroupExpansion only distinguishes finite model building
+  if(_saturationAlgorithm.actualValue == SaturationAlgorithm::FINITE_MODEL_BUILDING){
+    res << "fmb";
+  }
+  return res.str();
+}
+
 /**
  * True if the options are complete.
  * @since 23/07/2011 Manchester
@@ -139,6 +139,7 @@ public:
     void readFromEncodedOptions (vstring testId);
     void readOptionsString (vstring testId,bool assign=true);
     vstring generateEncodedOptions() const;
+    vstring generatePreprocessingKey() const;
 
     // deal with completeness
     bool complete(const Problem&) const;
@@ -417,6 +418,7 @@ public:
     PROFILE,
     RANDOM_STRATEGY,
     SAT,
+    SERVER,
     SMTCOMP,
     SPIDER,
     TCLAUSIFY,
@@ -506,9 +508,10 @@ public:
   /** Possible values for sat_solver */
   enum class SatSolver : unsigned int {
      MINISAT = 0,
-     VAMPIRE = 1
+     VAMPIRE = 1,
+     CDCL = 2
 #if VZ3
-     ,Z3 = 2
+     ,Z3 = 3
 #endif
   };
 
@@ -610,6 +613,12 @@ public:
     PROPERTY = 4
   };
 
+  /** Values for --metrics_format */
+  enum class MetricsFormat : unsigned int {
+    CSV = 0,
+    JSON = 1
+  };
+
   /** Values for --equality_proxy */
   enum class EqualityProxy : unsigned int {
     R = 0,
@@ -1823,6 +1832,7 @@ public:
   void setStatistics(Statistics newVal) { _statistics.actualValue=newVal; }
   Proof proof() const { return _proof.actualValue; }
   ProofExtra proofExtra() const { return _proofExtra.actualValue; }
+  bool pruneDeletedInferences() const { return _pruneDeletedInferences.actualValue; }
   bool proofChecking() const { return _proofChecking.actualValue; }
   int naming() const { return _naming.actualValue; }
 
@@ -1836,15 +1846,18 @@ public:
   unsigned fmbDetectSortBoundsTimeLimit() const { return _fmbDetectSortBoundsTimeLimit.actualValue; }
   unsigned fmbSizeWeightRatio() const { return _fmbSizeWeightRatio.actualValue; }
   FMBEnumerationStrategy fmbEnumerationStrategy() const { return _fmbEnumerationStrategy.actualValue; }
+  unsigned fmbCubeProcesses() const { return _fmbCubeProcesses.actualValue; }
 
   bool flattenTopLevelConjunctions() const { return _flattenTopLevelConjunctions.actualValue; }
   LTBLearning ltbLearning() const { return _ltbLearning.actualValue; }
   vstring ltbDirectory() const { return _ltbDirectory.actualValue; }
+  vstring serverSocket() const { return _serverSocket.actualValue; }
   Mode mode() const { return _mode.actualValue; }
   Schedule schedule() const { return _schedule.actualValue; }
   vstring scheduleName() const { return _schedule.getStringOfValue(_schedule.actualValue); }
   void setSchedule(Schedule newVal) {  _schedule.actualValue = newVal; }
   unsigned multicore() const { return _multicore.actualValue; }
+  bool portfolioPreprocessingSharing() const { return _portfolioPreprocessingSharing.actualValue; }
   void setMulticore(unsigned newVal) { _multicore.actualValue = newVal; }
   InputSyntax inputSyntax() const { return _inputSyntax.actualValue; }
   void setInputSyntax(InputSyntax newVal) { _inputSyntax.actualValue = newVal; }
@@ -1906,12 +1919,14 @@ public:
   bool fixUWA() const { return _fixUWA.actualValue; }
   bool unusedPredicateDefinitionRemoval() const { return _unusedPredicateDefinitionRemoval.actualValue; }
   bool blockedClauseElimination() const { return _blockedClauseElimination.actualValue; }
+  unsigned blockedClauseEliminationBudget() const { return _blockedClauseEliminationBudget.actualValue; }
   void setUnusedPredicateDefinitionRemoval(bool newVal) { _unusedPredicateDefinitionRemoval.actualValue = newVal; }
   bool weightIncrement() const { return _weightIncrement.actualValue; }
   // bool useDM() const { return _use_dm.actualValue; }
   SatSolver satSolver() const { return _satSolver.actualValue; }
   //void setSatSolver(SatSolver newVal) { _satSolver = newVal; }
   SaturationAlgorithm saturationAlgorithm() const { return _saturationAlgorithm.actualValue; }
+  bool termSharingGc() const { return _termSharingGc.actualValue; }
   void setSaturationAlgorithm(SaturationAlgorithm newVal) { _saturationAlgorithm.actualValue = newVal; }
   int selection() const { return _selection.actualValue; }
   void setSelection(int v) { _selection.actualValue=v;}
@@ -1941,6 +1956,10 @@ public:
   int lrsFirstTimeCheck() const { return _lrsFirstTimeCheck.actualValue; }
   int lrsWeightLimitOnly() const { return _lrsWeightLimitOnly.actualValue; }
   int lookaheadDelay() const { return _lookaheadDelay.actualValue; }
+  bool lookaheadExact() const { return _lookaheadExact.actualValue; }
+  bool compactPassive() const { return _compactPassive.actualValue; }
+  bool lazyIndexes() const { return _lazyIndexes.actualValue; }
+  unsigned lazyIndexDrop() const { return _lazyIndexDrop.actualValue; }
   int simulatedTimeLimit() const { return _simulatedTimeLimit.actualValue; }
   void setSimulatedTimeLimit(int newVal) { _simulatedTimeLimit.actualValue = newVal; }
   int maxInferenceDepth() const { return _maxInferenceDepth.actualValue; }
@@ -1983,6 +2002,12 @@ public:
   FunctionDefinitionElimination functionDefinitionElimination() const { return _functionDefinitionElimination.actualValue; }
   bool outputAxiomNames() const { return _outputAxiomNames.actualValue; }
   void setOutputAxiomNames(bool newVal) { _outputAxiomNames.actualValue = newVal; }
+  vstring metricsOutput() const { return _metricsOutput.actualValue; }
+  MetricsFormat metricsFormat() const { return _metricsFormat.actualValue; }
+  unsigned metricsActivations() const { return _metricsActivations.actualValue; }
+  unsigned metricsInterval() const { return _metricsInterval.actualValue; }
+  vstring indexTrace() const { return _indexTrace.actualValue; }
+  vstring satTrace() const { return _satTrace.actualValue; }
   QuestionAnsweringMode questionAnswering() const { return _questionAnswering.actualValue; }
   vstring xmlOutput() const { return _xmlOutput.actualValue; }
   Output outputMode() const { return _outputMode.actualValue; }
@@ -2259,6 +2284,7 @@ private:
   UnsignedOptionValue _fmbDetectSortBoundsTimeLimit;
   UnsignedOptionValue _fmbSizeWeightRatio;
   ChoiceOptionValue<FMBEnumerationStrategy> _fmbEnumerationStrategy;
+  UnsignedOptionValue _fmbCubeProcesses;
 
   BoolOptionValue _flattenTopLevelConjunctions;
   StringOptionValue _forbiddenOptions;
@@ -2323,10 +2349,15 @@ private:
   ChoiceOptionValue<LiteralComparisonMode> _literalComparisonMode;
   StringOptionValue _logFile;
   IntOptionValue _lookaheadDelay;
+  BoolOptionValue _lookaheadExact;
+  BoolOptionValue _compactPassive;
+  BoolOptionValue _lazyIndexes;
+  UnsignedOptionValue _lazyIndexDrop;
   IntOptionValue _lrsFirstTimeCheck;
   BoolOptionValue _lrsWeightLimitOnly;
   ChoiceOptionValue<LTBLearning> _ltbLearning;
   StringOptionValue _ltbDirectory;
+  StringOptionValue _serverSocket;
 
   LongOptionValue _maxActive;
   IntOptionValue _maxAnswers;
@@ -2338,6 +2369,7 @@ private:
   ChoiceOptionValue<Mode> _mode;
   ChoiceOptionValue<Schedule> _schedule;
   UnsignedOptionValue _multicore;
+  BoolOptionValue _portfolioPreprocessingSharing;
 
   StringOptionValue _namePrefix;
   IntOptionValue _naming;
@@ -2346,11 +2378,18 @@ private:
   BoolOptionValue _normalize;
 
   BoolOptionValue _outputAxiomNames;
+  StringOptionValue _metricsOutput;
+  ChoiceOptionValue<MetricsFormat> _metricsFormat;
+  UnsignedOptionValue _metricsActivations;
+  UnsignedOptionValue _metricsInterval;
+  StringOptionValue _indexTrace;
+  StringOptionValue _satTrace;
 
   BoolOptionValue _printClausifierPremises;
   StringOptionValue _problemName;
   ChoiceOptionValue<Proof> _proof;
   ChoiceOptionValue<ProofExtra> _proofExtra;
+  BoolOptionValue _pruneDeletedInferences;
   BoolOptionValue _proofChecking;
   
   StringOptionValue _protectedPrefix;
@@ -2377,6 +2416,7 @@ private:
   ChoiceOptionValue<SatVarSelector> _satVarSelector;
   ChoiceOptionValue<SatSolver> _satSolver;
   ChoiceOptionValue<SaturationAlgorithm> _saturationAlgorithm;
+  BoolOptionValue _termSharingGc;
   BoolOptionValue _selectUnusedVariablesFirst;
   BoolOptionValue _showAll;
   BoolOptionValue _showActive;
@@ -2454,6 +2494,7 @@ private:
   ChoiceOptionValue<URResolution> _unitResultingResolution;
   BoolOptionValue _unusedPredicateDefinitionRemoval;
   BoolOptionValue _blockedClauseElimination;
+  UnsignedOptionValue _blockedClauseEliminationBudget;
   UnsignedOptionValue _updatesByOneConstraint;
   // BoolOptionValue _use_dm;
   BoolOptionValue _weightIncrement;
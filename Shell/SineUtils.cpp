@@ -533,31 +533,52 @@ SineTheorySelector::SineTheorySelector(const Options& opt)
   CALL("SineTheorySelector::SineTheorySelector");
 }
 
-void SineTheorySelector::handlePossibleSignatureChange()
+/**
+ * Return true if the selection with the values of the SInE options in
+ * @b opt can be done by this selector
+ *
+ * Tolerances above the limit implied by @b maxTolerance, a generality
+ * threshold different from the one the structure was built with, and
+ * the priority selection (which records the depth at which each unit
+ * was selected) require the single problem SineSelector.
+ */
+bool SineTheorySelector::canPerform(const Options& opt) const
 {
-  CALL("SineTheorySelector::handlePossibleSignatureChange");
-
-  size_t symIdBound=_symExtr.getSymIdBound();
-  size_t oldSize=_def.size();
-  ASS_EQ(_gen.size(), oldSize);
+  CALL("SineTheorySelector::canPerform");
+
+  return opt.sineSelection()!=Options::SineSelection::OFF &&
+    opt.sineGeneralityThreshold()==_genThreshold &&
+    opt.sineSelection()!=Options::SineSelection::PRIORITY &&
+    !env.clausePriorities &&
+    opt.sineTolerance()!=-1.0f &&
+    ceil(opt.sineTolerance()*10)<=maxTolerance;
+}
 
-  if (symIdBound==oldSize) {
-    return;
-  }
-  ASS_G(symIdBound, oldSize);
+/**
+ * Return the generality of symbol @b sym in the theory axioms and
+ * (if @b problemGen is non-zero) in the units of the current problem
+ */
+unsigned SineTheorySelector::generality(SymId sym, const SymCountMap* problemGen) const
+{
+  CALL("SineTheorySelector::generality");
 
-  _gen.expand(symIdBound);
-  _def.expand(symIdBound);
-  for (size_t i=oldSize;i<symIdBound;i++) {
-    _gen[i]=0;
-    _def[i]=0;
+  unsigned res = sym<_gen.size() ? _gen[sym] : 0;
+  if (problemGen) {
+    res += problemGen->get(sym, 0);
   }
+  return res;
 }
 
 /**
  * Connect unit @b u with symbols it defines
+ *
+ * If @b problemDef is non-zero, @b u is a unit of the current problem
+ * and the connection is stored in @b problemDef rather than in the
+ * shared D-relation. If @b u contains no symbols, it is added to
+ * @b unitsWithoutSymbols.
  */
-void SineTheorySelector::updateDefRelation(Unit* u)
+void SineTheorySelector::updateDefRelation(Unit* u, const SymCountMap* problemGen, SymDefMap* problemDef,
+    Stack<Unit*>& unitsWithoutSymbols)
 {
   CALL("SineTheorySelector::updateDefRelation");
 
@@ -569,7 +590,7 @@ void SineTheorySelector::updateDefRelation(Unit* u)
       env.clausePriorities->insert(u,1);
     }
 
-    _unitsWithoutSymbols.push(u);
+    unitsWithoutSymbols.push(u);
     return;
   }
 
@@ -580,11 +601,11 @@ void SineTheorySelector::updateDefRelation(Unit* u)
   Stack<SymId>::Iterator sit(symIds);
 
   ALWAYS(sit.hasNext());
-  unsigned leastGenVal=_gen[sit.next()];
+  unsigned leastGenVal=generality(sit.next(), problemGen);
 
   while (sit.hasNext()) {
     SymId sym=sit.next();
-    unsigned val=_gen[sym];
+    unsigned val=generality(sym, problemGen);
     ASS_G(val,0);
 
     if (val<leastGenVal) {
@@ -597,15 +618,25 @@ void SineTheorySelector::updateDefRelation(Unit* u)
   Stack<SymId>::Iterator sit2(symIds);
   while (sit2.hasNext()) {
     SymId sym=sit2.next();
-    unsigned val=_gen[sym];
+    unsigned val=generality(sym, problemGen);
 
+    unsigned short minTolerance;
     if (val<=_genThreshold) {
       //if a symbol fits under _genThreshold, add it into the relation
-      DEntryList::push(DEntry(strictTolerance,u),_def[sym]);
+      minTolerance=strictTolerance;
     }
     else if (val<=generalityLimit) {
-      unsigned short minTolerance=(val*strictTolerance)/leastGenVal;
-      //only if the symbol is over _genThreshold; otherwise it is already added
+      minTolerance=(val*strictTolerance)/leastGenVal;
+    }
+    else {
+      continue;
+    }
+    if (problemDef) {
+      DEntryList** pdef;
+      problemDef->getValuePtr(sym, pdef, 0);
+      DEntryList::push(DEntry(minTolerance,u),*pdef);
+    }
+    else {
       DEntryList::push(DEntry(minTolerance,u),_def[sym]);
     }
   }
@@ -636,18 +667,26 @@ void SineTheorySelector::initSelectionStructure(UnitList* units)
   UnitList::Iterator uit(units);
   while (uit.hasNext()) {
     Unit* u=uit.next();
-    updateDefRelation(u);
+    updateDefRelation(u, 0, 0, _unitsWithoutSymbols);
   }
 }
 
-
+/**
+ * Replace @b units (the units of a particular problem) by them together
+ * with the theory axioms selected for them
+ *
+ * The work is proportional to the size of the problem and of the
+ * selected axioms rather than to the size of the theory, and the
+ * structure built by @b initSelectionStructure() is left unchanged.
+ */
 void SineTheorySelector::perform(UnitList*& units)
 {
   CALL("SineTheorySelector::perform");
 
   TimeCounter tc(TC_SINE_SELECTION);
 
-  handlePossibleSignatureChange();
+  SymCountMap problemGen;
+  SymDefMap problemDef;
 
   UnitList::Iterator uit(units);
   while (uit.hasNext()) {
@@ -655,11 +694,14 @@ void SineTheorySelector::perform(UnitList*& units)
     SymIdIterator sit=_symExtr.extractSymIds(u);
     while (sit.hasNext()) {
       SymId sid=sit.next();
-      _gen[sid]++;
+      unsigned* pcnt;
+      problemGen.getValuePtr(sid, pcnt, 0);
+      (*pcnt)++;
     }
   }
 
   UnitList* res=0;
+  Stack<Unit*> problemUnitsWithoutSymbols;
   DHSet<SymId> addedSymIds;
   DHSet<Unit*> selected;
   Deque<Unit*> newlySelected;
@@ -674,7 +716,7 @@ void SineTheorySelector::perform(UnitList*& units)
                    || (env.options->guessTheGoal() != Options::GoalGuess::OFF && u->inputType()==Unit::ASSUMPTION));
 
     if (performSelection) {
-      updateDefRelation(u);
+      updateDefRelation(u, &problemGen, &problemDef, problemUnitsWithoutSymbols);
     }
     else {
       selected.insert(u);
@@ -716,27 +758,36 @@ void SineTheorySelector::perform(UnitList*& units)
 	//we already added units belonging to this symbol
 	continue;
       }
-      DEntryList::Iterator defUnits(_def[sym]);
-      while (defUnits.hasNext()) {
-	DEntry de=defUnits.next();
-
-	if (de.minTolerance>intTolerance || !selected.insert(de.unit)) {
-	  continue;
-	}
-	UnitList::push(de.unit,res);
-	newlySelected.push_back(de.unit);
+      DEntryList* defs[2] = { problemDef.get(sym, 0), sym<_def.size() ? _def[sym] : 0 };
+      for (unsigned i=0; i<2; i++) {
+        DEntryList::Iterator defUnits(defs[i]);
+        while (defUnits.hasNext()) {
+          DEntry de=defUnits.next();
+
+          if (de.minTolerance>intTolerance || !selected.insert(de.unit)) {
+            continue;
+          }
+          UnitList::push(de.unit,res);
+          newlySelected.push_back(de.unit);
+        }
       }
     }
   }
 
+  SymDefMap::Iterator pdit(problemDef);
+  while (pdit.hasNext()) {
+    DEntryList::destroy(pdit.next());
+  }
+
   UnitList::pushFromIterator(Stack<Unit*>::Iterator(_unitsWithoutSymbols), res);
+  UnitList::pushFromIterator(Stack<Unit*>::Iterator(problemUnitsWithoutSymbols), res);
 
   UnitList::destroy(units);
 //  units=res->reverse(); //we want to resemble the original SInE as much as possible
   units=res;
 
   env.statistics->sineIterations=depth;
-  env.statistics->selectedBySine=_unitsWithoutSymbols.size() + selected.size();
+  env.statistics->selectedBySine=_unitsWithoutSymbols.size() + problemUnitsWithoutSymbols.size() + selected.size();
 
 #if SINE_PRINT_SELECTED
   UnitList::Iterator selIt(units);
@@ -27,6 +27,7 @@
 #include "Forwards.hpp"
 
 #include "Lib/DArray.hpp"
+#include "Lib/DHMap.hpp"
 #include "Lib/Stack.hpp"
 
 namespace Shell {
@@ -117,6 +118,8 @@ public:
 
   void initSelectionStructure(UnitList* units);
   void perform(UnitList*& units);
+
+  bool canPerform(const Options& opt) const;
 private:
 
   /** The integer tolerance value is the float option value multiplied by 10 and
@@ -127,10 +130,6 @@ private:
   static const unsigned short maxTolerance=50;
   static const unsigned short strictTolerance=10;
 
-  void handlePossibleSignatureChange();
-
-  void updateDefRelation(Unit* u);
-
   unsigned _genThreshold;
 
   struct DEntry
@@ -142,7 +141,23 @@ private:
   };
   typedef List<DEntry> DEntryList;
 
-  /** Stored the D-relation */
+  /** Generality of symbols occurring in the units of a particular problem */
+  typedef DHMap<SymId,unsigned> SymCountMap;
+  /** The D-relation restricted to the units of a particular problem */
+  typedef DHMap<SymId,DEntryList*> SymDefMap;
+
+  unsigned generality(SymId sym, const SymCountMap* problemGen) const;
+  void updateDefRelation(Unit* u, const SymCountMap* problemGen, SymDefMap* problemDef,
+      Stack<Unit*>& unitsWithoutSymbols);
+
+  /**
+   * Stored the D-relation of the theory axioms
+   *
+   * Like @b _gen, this is not modified after @b initSelectionStructure()
+   * (the selection for a particular problem keeps its own symbols and
+   * D-relation aside), so the structure can be built once and shared by
+   * all the problems, including those solved in forked processes.
+   */
   DArray<DEntryList*> _def;
 
   /**
@@ -108,6 +108,8 @@ Statistics::Statistics()
     equationalTautologies(0),
     forwardSubsumed(0),
     backwardSubsumed(0),
+    forwardSubsumptionSignatureRejections(0),
+    backwardSubsumptionSignatureRejections(0),
     taDistinctnessSimplifications(0),
     taDistinctnessTautologyDeletions(0),
     taInjectivitySimplifications(0),
@@ -118,12 +120,22 @@ Statistics::Statistics()
     activeClauses(0),
     extensionalityClauses(0),
     discardedNonRedundantClauses(0),
+    deferredSuperpositions(0),
+    deadCriticalPairs(0),
+    deferredIndexUpdates(0),
+    lazyIndexBuilds(0),
+    lazyIndexBuildUpdates(0),
+    lazyIndexDrops(0),
     inferencesBlockedForOrderingAftercheck(0),
     smtReturnedUnknown(false),
     inferencesSkippedDueToColors(0),
     finalPassiveClauses(0),
     finalActiveClauses(0),
     finalExtensionalityClauses(0),
+    termSharingCollections(0),
+    reclaimedTerms(0),
+    reclaimedLiterals(0),
+    reclaimedTermMemory(0),
     splitClauses(0),
     splitComponents(0),
     uniqueComponents(0),
@@ -252,7 +264,8 @@ void Statistics::print(ostream& out)
 
   HEADING("Saturation",activeClauses+passiveClauses+extensionalityClauses+
       generatedClauses+finalActiveClauses+finalPassiveClauses+finalExtensionalityClauses+
-      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
+      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck+
+      deferredSuperpositions);
   COND_OUT("Initial clauses", initialClauses);
   COND_OUT("Generated clauses", generatedClauses);
   COND_OUT("Active clauses", activeClauses);
@@ -263,10 +276,26 @@ void Statistics::print(ostream& out)
   COND_OUT("Final passive clauses", finalPassiveClauses);
   COND_OUT("Final extensionality clauses", finalExtensionalityClauses);
   COND_OUT("Discarded non-redundant clauses", discardedNonRedundantClauses);
+  COND_OUT("Deferred superpositions", deferredSuperpositions);
+  COND_OUT("Deferred superpositions with dead parents", deadCriticalPairs);
   COND_OUT("Inferences skipped due to colors", inferencesSkippedDueToColors);
   COND_OUT("Inferences blocked due to ordering aftercheck", inferencesBlockedForOrderingAftercheck);
   SEPARATOR;
 
+  HEADING("Term Sharing",termSharingCollections);
+  COND_OUT("Collections", termSharingCollections);
+  COND_OUT("Reclaimed terms", reclaimedTerms);
+  COND_OUT("Reclaimed literals", reclaimedLiterals);
+  COND_OUT("Reclaimed memory [KB]", reclaimedTermMemory/1024);
+  SEPARATOR;
+
+  HEADING("Lazy Indexes",deferredIndexUpdates+lazyIndexBuilds);
+  COND_OUT("Deferred index updates", deferredIndexUpdates);
+  COND_OUT("Lazy index builds", lazyIndexBuilds);
+  COND_OUT("Clauses inserted by lazy index builds", lazyIndexBuildUpdates);
+  COND_OUT("Lazy index drops", lazyIndexDrops);
+  SEPARATOR;
+
 
   HEADING("Simplifying Inferences",duplicateLiterals+trivialInequalities+
       forwardSubsumptionResolution+backwardSubsumptionResolution+
@@ -288,7 +317,8 @@ void Statistics::print(ostream& out)
 
   HEADING("Deletion Inferences",simpleTautologies+equationalTautologies+
       forwardSubsumed+backwardSubsumed+forwardDemodulationsToEqTaut+
-      backwardDemodulationsToEqTaut+innerRewritesToEqTaut);
+      backwardDemodulationsToEqTaut+innerRewritesToEqTaut+
+      forwardSubsumptionSignatureRejections+backwardSubsumptionSignatureRejections);
   COND_OUT("Simple tautologies", simpleTautologies);
   COND_OUT("Equational tautologies", equationalTautologies);
   COND_OUT("Deep equational tautologies", deepEquationalTautologies);
@@ -297,6 +327,8 @@ void Statistics::print(ostream& out)
   COND_OUT("Fw demodulations to eq. taut.", forwardDemodulationsToEqTaut);
   COND_OUT("Bw demodulations to eq. taut.", backwardDemodulationsToEqTaut);
   COND_OUT("Inner rewrites to eq. taut.", innerRewritesToEqTaut);
+  COND_OUT("Fw subsumption signature rejections", forwardSubsumptionSignatureRejections);
+  COND_OUT("Bw subsumption signature rejections", backwardSubsumptionSignatureRejections);
   SEPARATOR;
 
   HEADING("Generating Inferences",resolution+urResolution+cResolution+factoring+
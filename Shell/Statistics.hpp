@@ -181,6 +181,10 @@ public:
   unsigned forwardSubsumed;
   /** number of backward subsumed clauses */
   unsigned backwardSubsumed;
+  /** number of forward subsumption candidates rejected by clause signatures */
+  unsigned forwardSubsumptionSignatureRejections;
+  /** number of backward subsumption candidates rejected by clause signatures */
+  unsigned backwardSubsumptionSignatureRejections;
 
   /** statistics of term algebra rules */
   unsigned taDistinctnessSimplifications;
@@ -201,6 +205,18 @@ public:
 
   unsigned discardedNonRedundantClauses;
 
+  /** superpositions whose results were deferred to the compact passive set */
+  unsigned deferredSuperpositions;
+  /** deferred superpositions dropped at selection because a parent was no longer active */
+  unsigned deadCriticalPairs;
+
+  /** clause insertions and removals received by lazy indexes while not built */
+  unsigned deferredIndexUpdates;
+  unsigned lazyIndexBuilds;
+  /** clauses inserted into lazy indexes when they were built */
+  unsigned lazyIndexBuildUpdates;
+  unsigned lazyIndexDrops;
+
   unsigned inferencesBlockedForOrderingAftercheck;
 
   bool smtReturnedUnknown;
@@ -214,6 +230,15 @@ public:
   /** extensionality clauses at the end of the saturation algorithm run */
   unsigned finalExtensionalityClauses;
 
+  /** number of collections of unused shared terms */
+  unsigned termSharingCollections;
+  /** number of shared terms freed by the collections */
+  unsigned reclaimedTerms;
+  /** number of shared literals freed by the collections */
+  unsigned reclaimedLiterals;
+  /** memory freed by the collections of shared terms, in bytes */
+  size_t reclaimedTermMemory;
+
   unsigned splitClauses;
   unsigned splitComponents;
   //TODO currently not set, set it?
@@ -203,11 +203,6 @@ UnitList* parsedUnits;
 Problem* UIHelper::getInputProblem(const Options& opts)
 {
   CALL("UIHelper::getInputProblem");
-    
-  TimeCounter tc1(TC_PARSING);
-  env.statistics->phase = Statistics::PARSING;
-
-  SMTLIBLogic smtLibLogic = SMT_UNDEFINED;
 
   vstring inputFile = opts.inputFile();
 
@@ -224,6 +219,35 @@ Problem* UIHelper::getInputProblem(const Options& opts)
     }
   }
 
+  Problem* res = getInputProblem(opts, *input);
+
+  if (inputFile!="") {
+    BYPASSING_ALLOCATOR;
+    
+    delete static_cast<ifstream*>(input);
+    input=0;
+  }
+
+  return res;
+}
+
+/**
+ * Return problem object with units read from @b input in the syntax
+ * given by @b opts
+ *
+ * No preprocessing is performed on the units.
+ */
+Problem* UIHelper::getInputProblem(const Options& opts, istream& inputStream)
+{
+  CALL("UIHelper::getInputProblem(const Options&,istream&)");
+
+  TimeCounter tc1(TC_PARSING);
+  env.statistics->phase = Statistics::PARSING;
+
+  SMTLIBLogic smtLibLogic = SMT_UNDEFINED;
+
+  istream* input = &inputStream;
+
   UnitList* units;
   switch (opts.inputSyntax()) {
   case Options::InputSyntax::SIMPLIFY:
@@ -287,13 +311,6 @@ Problem* UIHelper::getInputProblem(const Options& opts)
    break;
   }
 
-  if (inputFile!="") {
-    BYPASSING_ALLOCATOR;
-    
-    delete static_cast<ifstream*>(input);
-    input=0;
-  }
-
   // parsedUnits = units->copy();
 
   Problem* res = new Problem(units);
@@ -21,222 +21,411 @@
  * Implements class RecordingSatSolver.
  */
 
+#include <fstream>
 #include <sstream>
+#include <time.h>
 
-#include "Lib/Int.hpp"
-#include "Lib/List.hpp"
-#include "Lib/StringUtils.hpp"
+#include "Lib/Exception.hpp"
 
 #include "SAT/SATClause.hpp"
 
+#include "Shell/Options.hpp"
+
 #include "RecordingSatSolver.hpp"
 
 namespace Test
 {
 
+static char statusChar(SATSolver::Status st)
+{
+  switch(st) {
+  case SATSolver::SATISFIABLE:
+    return 's';
+  case SATSolver::UNSATISFIABLE:
+    return 'u';
+  default:
+    return 'k';
+  }
+}
+
+static int dimacsLit(SATLiteral lit)
+{
+  return lit.polarity() ? static_cast<int>(lit.var()) : -static_cast<int>(lit.var());
+}
+
 ///////////////////////
 // RecordingSatSolver
 //
 
-#define REC(x) 
+RecordingSatSolver::RecordingSatSolver(SATSolver* inner, const Options& opt, const char* origin)
+: _inner(inner), _withAssumptions(dynamic_cast<SATSolverWithAssumptions*>(inner)),
+  _out(trace(opt))
+{
+  CALL("RecordingSatSolver::RecordingSatSolver");
+
+  static unsigned nextId = 0;
+  _id = nextId++;
+  _out << "sat " << _id << ' ' << origin << '\n';
+}
 
 /**
- * Return header to be used for log outputs of this solver
+ * Return the stream shared by all the recording solvers,
+ * it is opened by the first call
  */
-vstring RecordingSatSolver::getHdr() const
+std::ostream& RecordingSatSolver::trace(const Options& opt)
 {
-  CALL("RecordingSatSolver::getHdr");
-
-  return "sat_"+Int::toHexString(reinterpret_cast<size_t>(this))+" ";
+  CALL("RecordingSatSolver::trace");
+
+  static std::ofstream* out = 0;
+  if(!out) {
+    BYPASSING_ALLOCATOR;
+    out = new std::ofstream(opt.satTrace().c_str());
+    if(!*out) {
+      USER_ERROR("Cannot open the SAT trace file "+opt.satTrace());
+    }
+  }
+  return *out;
 }
 
-void RecordingSatSolver::addClauses(SATClauseIterator cit0, bool onlyPropagate,bool useInPartialModel)
+void RecordingSatSolver::writeClause(char action, SATClause* cl)
 {
-  CALL("RecordingSatSolver::addClauses");
-
-  SATClauseList* clauses = 0;
-  SATClauseList::pushFromIterator(cit0, clauses);
-  clauses = clauses->reverse();
+  CALL("RecordingSatSolver::writeClause");
 
-  vostringstream clausesStm;
-  SATClauseList::Iterator cit(clauses);
-  while(cit.hasNext()) {
-    SATClause* cl = cit.next();
-    clausesStm << cl->toDIMACSString();
-    if(cit.hasNext()) {
-      clausesStm << "|";
-    }
+  _out << _id << ' ' << action;
+  unsigned len = cl->length();
+  for(unsigned i=0;i<len;i++) {
+    _out << ' ' << dimacsLit((*cl)[i]);
   }
+  _out << " 0\n";
+}
 
-  ASSERTION_VIOLATION_REP("Does not record useInPartialModel");
-
-  REC("act=ac:op="<<onlyPropagate<<":clauses="<<clausesStm.str());
+void RecordingSatSolver::addClause(SATClause* cl)
+{
+  CALL("RecordingSatSolver::addClause");
 
-  _inner->addClauses(pvi(SATClauseList::DestructiveIterator(clauses)), onlyPropagate);
+  writeClause('c', cl);
+  _inner->addClause(cl);
 }
 
-void RecordingSatSolver::randomizeAssignment()
+void RecordingSatSolver::addClauseIgnoredInPartialModel(SATClause* cl)
 {
-  CALL("RecordingSatSolver::randomizeAssignment");
+  CALL("RecordingSatSolver::addClauseIgnoredInPartialModel");
 
-  REC("act=ra");
-
-  _inner->randomizeAssignment();
+  writeClause('g', cl);
+  _inner->addClauseIgnoredInPartialModel(cl);
 }
 
-void RecordingSatSolver::ensureVarCnt(unsigned newVarCnt)
+void RecordingSatSolver::simplify()
 {
-  CALL("RecordingSatSolver::ensureVarCnt");
-
-  REC("act=evc:nwc="<<newVarCnt);
+  CALL("RecordingSatSolver::simplify");
 
-  _inner->ensureVarCnt(newVarCnt);
+  _out << _id << " y\n";
+  _inner->simplify();
 }
 
-void RecordingSatSolver::addAssumption(SATLiteral lit, unsigned conflictCountLimit)
+SATSolver::Status RecordingSatSolver::solve(unsigned conflictCountLimit)
 {
-  CALL("RecordingSatSolver::addAssumption");
-
-  REC("act=aa:litVar="<<lit.var()<<":litPol="<<lit.polarity()<<":ccl="<<conflictCountLimit);
+  CALL("RecordingSatSolver::solve");
 
-  _inner->addAssumption(lit, conflictCountLimit);
+  Status res = _inner->solve(conflictCountLimit);
+  _out << _id << " s " << conflictCountLimit << ' ' << statusChar(res) << '\n';
+  // the trace is flushed after each solve so that the buffered lines
+  // are not duplicated in the processes forked between the solver calls
+  _out.flush();
+  return res;
 }
 
-void RecordingSatSolver::retractAllAssumptions()
+void RecordingSatSolver::ensureVarCount(unsigned newVarCnt)
 {
-  CALL("RecordingSatSolver::retractAllAssumptions");
+  CALL("RecordingSatSolver::ensureVarCount");
 
-  REC("act=raa");
+  _out << _id << " n " << newVarCnt << '\n';
+  _inner->ensureVarCount(newVarCnt);
+}
 
-  _inner->retractAllAssumptions();
+unsigned RecordingSatSolver::newVar()
+{
+  CALL("RecordingSatSolver::newVar");
+
+  _out << _id << " v\n";
+  return _inner->newVar();
 }
 
+void RecordingSatSolver::suggestPolarity(unsigned var, unsigned pol)
+{
+  CALL("RecordingSatSolver::suggestPolarity");
 
-///////////////////////
-// SolverReplayer
-//
+  _out << _id << " p " << var << ' ' << pol << '\n';
+  _inner->suggestPolarity(var, pol);
+}
 
-SolverReplayer::ActionSpec::ActionSpec()
+void RecordingSatSolver::randomizeForNextAssignment(unsigned maxVar)
 {
-  CALL("SolverReplayer::ActionSpec::ActionSpec");
+  CALL("RecordingSatSolver::randomizeForNextAssignment");
 
-  rdr.registerEnumOption(&action, getReplayActionReader(), "act");
-  rdr.registerUnsignedOption(&acOnlyPropagate, "op");
-  rdr.registerStringOption(&acClausesStr, "clauses");
-  rdr.registerUnsignedOption(&evcVarCnt, "nwc");
-  rdr.registerUnsignedOption(&aaLitVar, "litVar");
-  rdr.registerUnsignedOption(&aaLitPolarity, "litPol");
-  rdr.registerUnsignedOption(&aaConflictCountLimit, "ccl");
+  _out << _id << " r " << maxVar << '\n';
+  _inner->randomizeForNextAssignment(maxVar);
 }
 
-SATClause* SolverReplayer::ActionSpec::readClause(vstring str)
+void RecordingSatSolver::addAssumption(SATLiteral lit)
 {
-  CALL("SolverReplayer::ActionSpec::readClause");
+  CALL("RecordingSatSolver::addAssumption");
+  ASS(_withAssumptions);
 
-  static StringStack varStrings;
-  varStrings.reset();
-  StringUtils::splitStr(str.c_str(), ' ', varStrings);
-  ASS_EQ(varStrings.top(), "0");
-  varStrings.pop();
+  _out << _id << " a " << dimacsLit(lit) << '\n';
+  _withAssumptions->addAssumption(lit);
+}
 
-  static SATLiteralStack clauseLits;
-  clauseLits.reset();
+void RecordingSatSolver::retractAllAssumptions()
+{
+  CALL("RecordingSatSolver::retractAllAssumptions");
+  ASS(_withAssumptions);
 
-  StringStack::BottomFirstIterator vsit(varStrings);
-  while(vsit.hasNext()) {
-    vstring varSpec = vsit.next();
-    int val;
-    ALWAYS(Int::stringToInt(varSpec, val));
-    clauseLits.push(SATLiteral(abs(val), val>0));
-  }
+  _out << _id << " x\n";
+  _withAssumptions->retractAllAssumptions();
+}
 
-  SATClause* res = SATClause::fromStack(clauseLits);
+SATSolver::Status RecordingSatSolver::solveUnderAssumptions(const SATLiteralStack& assumps,
+    unsigned conflictCountLimit, bool onlyProperSubusets)
+{
+  CALL("RecordingSatSolver::solveUnderAssumptions");
+  ASS(_withAssumptions);
+
+  Status res = _withAssumptions->solveUnderAssumptions(assumps, conflictCountLimit, onlyProperSubusets);
+  _out << _id << " u " << conflictCountLimit << ' ' << onlyProperSubusets << ' ' << statusChar(res);
+  SATLiteralStack::ConstIterator ait(assumps);
+  while(ait.hasNext()) {
+    _out << ' ' << dimacsLit(ait.next());
+  }
+  _out << " 0\n";
+  _out.flush();
   return res;
 }
 
-void SolverReplayer::ActionSpec::readCommand(vstring str)
+const SATLiteralStack& RecordingSatSolver::failedAssumptions()
 {
-  CALL("SolverReplayer::ActionSpec::readCommand");
+  CALL("RecordingSatSolver::failedAssumptions");
+  ASS(_withAssumptions);
 
-  if(!rdr.readOptions(str)) {
-    ASSERTION_VIOLATION;
-  }
+  return _withAssumptions->failedAssumptions();
+}
 
-  if(action==RA_ADD_CLAUSES) {
-    static StringStack clauseStrings;
-    clauseStrings.reset();
-    StringUtils::splitStr(acClausesStr.c_str(), '|', clauseStrings);
-    StringStack::BottomFirstIterator csit(clauseStrings);
 
-    acClauses.reset();
-    while(csit.hasNext()) {
-      vstring clauseString = csit.next();
-      acClauses.push(readClause(clauseString));
-    }
-  }
-  else if(action==RA_ADD_ASSUMPTION) {
-    aaLit = SATLiteral(aaLitVar, aaLitPolarity==1);
+///////////////////////
+// SolverReplayer
+//
+
+SolverReplayer::~SolverReplayer()
+{
+  CALL("SolverReplayer::~SolverReplayer");
+
+  destroyClauses();
+  while(_solvers.isNonEmpty()) {
+    delete _solvers.pop();
   }
 }
 
-const EnumReader<SolverReplayer::ReplayAction>& SolverReplayer::getReplayActionReader()
+/**
+ * Return a monotonic wall clock time in nanoseconds
+ */
+long long SolverReplayer::nanoTime()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<long long>(ts.tv_sec)*1000000000ll + ts.tv_nsec;
+}
+
+/**
+ * Read the trace from @b stm. An unterminated last line, left
+ * when the recording run was killed, is ignored.
+ */
+void SolverReplayer::load(istream& stm)
 {
-  CALL("SolverReplayer::getReplayActionReader");
+  CALL("SolverReplayer::load");
 
-  static bool initialized = false;
-  static EnumReader<ReplayAction> rdr;
-  if(!initialized) {
-    initialized = true;
-    rdr.addVal("ac", RA_ADD_CLAUSES);
-    rdr.addVal("aa", RA_ADD_ASSUMPTION);
-    rdr.addVal("ra", RA_RANDOMIZE_ASSIGNMENT);
-    rdr.addVal("evc", RA_ENSURE_VAR_CNT);
-    rdr.addVal("raa", RA_RETRACT_ALL_ASSUMPTIONS);
+  vstring line;
+  while(getline(stm, line)) {
+    if(stm.eof() || line.empty()) {
+      break;
+    }
+    if(line.substr(0,4)=="sat ") {
+      vistringstream ls(line.substr(4));
+      unsigned id;
+      vstring origin;
+      ls >> id >> origin;
+      if(id!=_solvers.size()) {
+        USER_ERROR("Unexpected solver number in the SAT trace: "+line);
+      }
+      _solvers.push(new SolverTrace(origin));
+      continue;
+    }
+    readStep(line);
   }
-  return rdr;
 }
 
-void SolverReplayer::performStep(vstring cmd)
+void SolverReplayer::readStep(vstring line)
 {
-  CALL("SolverReplayer::performStep");
+  CALL("SolverReplayer::readStep");
+
+  vistringstream ls(line);
+  unsigned id;
+  Step st;
+  st.arg1 = 0;
+  st.arg2 = 0;
+  st.status = SATSolver::UNKNOWN;
+  ls >> id >> st.action;
+  if(ls.fail() || id>=_solvers.size()) {
+    USER_ERROR("Invalid line in the SAT trace: "+line);
+  }
+  SolverTrace& tr = *_solvers[id];
 
-  static ActionSpec aspec;
-  aspec.readCommand(cmd);
-  switch(aspec.action) {
-  case RA_ADD_ASSUMPTION:
-    _solver.addAssumption(aspec.aaLit, aspec.aaConflictCountLimit);
+  bool readsClause = false;
+  char status = 0;
+  switch(st.action) {
+  case 'v':
+  case 'y':
     break;
-  case RA_ADD_CLAUSES:
-    _solver.addClauses(aspec.getClauses(), aspec.acOnlyPropagate!=0);
+  case 'x':
+    tr.assumptions = true;
     break;
-  case RA_ENSURE_VAR_CNT:
-    _solver.ensureVarCnt(aspec.evcVarCnt);
+  case 'n':
+  case 'r':
+    ls >> st.arg1;
     break;
-  case RA_RANDOMIZE_ASSIGNMENT:
-    _solver.randomizeAssignment();
+  case 'p':
+    ls >> st.arg1 >> st.arg2;
     break;
-  case RA_RETRACT_ALL_ASSUMPTIONS:
-    _solver.retractAllAssumptions();
+  case 'a':
+  {
+    int lit;
+    ls >> lit;
+    _lits.push(SATLiteral(abs(lit), lit>0));
+    tr.assumptions = true;
+    break;
+  }
+  case 'c':
+  case 'g':
+    readsClause = true;
+    break;
+  case 's':
+    ls >> st.arg1 >> status;
+    break;
+  case 'u':
+    ls >> st.arg1 >> st.arg2 >> status;
+    readsClause = true;
+    tr.assumptions = true;
     break;
   default:
-    ASSERTION_VIOLATION;
+    USER_ERROR("Invalid line in the SAT trace: "+line);
   }
+  if(status) {
+    st.status = status=='s' ? SATSolver::SATISFIABLE :
+	status=='u' ? SATSolver::UNSATISFIABLE : SATSolver::UNKNOWN;
+  }
+
+  st.litsStart = st.action=='a' ? _lits.size()-1 : _lits.size();
+  if(readsClause) {
+    int lit;
+    while(ls >> lit && lit!=0) {
+      _lits.push(SATLiteral(abs(lit), lit>0));
+    }
+  }
+  st.litsEnd = _lits.size();
+  if(ls.fail()) {
+    USER_ERROR("Invalid line in the SAT trace: "+line);
+  }
+  tr.steps.push(st);
 }
 
-void SolverReplayer::runFromStream(istream& stm, vstring prefix)
+/**
+ * Perform the calls of the recorded solver number @b solver on @b target,
+ * and for each call to solve or solveUnderAssumptions add its outcome
+ * to @b calls.
+ *
+ * The recorded assumption calls may only be replayed if @b target
+ * is a SATSolverWithAssumptions. The clauses created for @b target are
+ * kept until destroyClauses() is called after @b target was deleted.
+ */
+void SolverReplayer::replay(unsigned solver, SATSolver& target, Stack<SolveCall>& calls)
 {
-  CALL("SolverReplayer::runFromStream");
+  CALL("SolverReplayer::replay");
+
+  SATSolverWithAssumptions* withAssumptions = dynamic_cast<SATSolverWithAssumptions*>(&target);
+  ASS(withAssumptions || !usesAssumptions(solver));
+
+  static SATLiteralStack lits;
+  Stack<Step>::BottomFirstIterator sit(_solvers[solver]->steps);
+  while(sit.hasNext()) {
+    const Step& st = sit.next();
+    lits.reset();
+    for(unsigned i=st.litsStart;i<st.litsEnd;i++) {
+      lits.push(_lits[i]);
+    }
 
-  size_t prefLen = prefix.length();
-  do {
-    vstring line;
-    getline(stm, line);
-    if(line.substr(0,prefLen)!=prefix) {
-      continue;
+    switch(st.action) {
+    case 'v':
+      target.newVar();
+      break;
+    case 'n':
+      target.ensureVarCount(st.arg1);
+      break;
+    case 'c':
+    case 'g':
+    {
+      SATClause* cl = SATClause::fromStack(lits);
+      _clauses.push(cl);
+      if(st.action=='c') {
+        target.addClause(cl);
+      }
+      else {
+        target.addClauseIgnoredInPartialModel(cl);
+      }
+      break;
+    }
+    case 'p':
+      target.suggestPolarity(st.arg1, st.arg2);
+      break;
+    case 'r':
+      target.randomizeForNextAssignment(st.arg1);
+      break;
+    case 'y':
+      target.simplify();
+      break;
+    case 'a':
+      withAssumptions->addAssumption(lits[0]);
+      break;
+    case 'x':
+      withAssumptions->retractAllAssumptions();
+      break;
+    case 's':
+    case 'u':
+    {
+      SolveCall call;
+      call.recorded = st.status;
+      long long start = nanoTime();
+      if(st.action=='s') {
+        call.replayed = target.solve(st.arg1);
+      }
+      else {
+        call.replayed = withAssumptions->solveUnderAssumptions(lits, st.arg1, st.arg2);
+      }
+      call.nanos = nanoTime()-start;
+      calls.push(call);
+      break;
     }
-    vstring cmd = line.substr(prefLen);
-    performStep(cmd);
-  } while(!stm.eof());
+    default:
+      ASSERTION_VIOLATION;
+    }
+  }
+}
+
+void SolverReplayer::destroyClauses()
+{
+  CALL("SolverReplayer::destroyClauses");
+
+  while(_clauses.isNonEmpty()) {
+    _clauses.pop()->destroy();
+  }
 }
 
 }
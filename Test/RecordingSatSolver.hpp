@@ -27,90 +27,143 @@
 #include "Forwards.hpp"
 
 #include "Lib/ScopedPtr.hpp"
-#include "Lib/OptionsReader.hpp"
+#include "Lib/Stack.hpp"
 
 #include "SAT/SATSolver.hpp"
 
-
-
 namespace Test {
 
+using namespace Lib;
 using namespace SAT;
+using namespace Shell;
 
-class RecordingSatSolver : public SATSolver {
+/**
+ * SAT solver that writes the calls made to the inner solver into the
+ * file given by the sat_trace option, so that they can be replayed by
+ * SolverReplayer (the "sr" module of vutil).
+ *
+ * All recording solvers of a run share one trace, which has one call
+ * per line:
+ *   sat <id> <origin>                       a new solver
+ *   <id> v                                  newVar()
+ *   <id> n <var count>                      ensureVarCount()
+ *   <id> c <literals> 0                     addClause()
+ *   <id> g <literals> 0                     addClauseIgnoredInPartialModel()
+ *   <id> p <var> <polarity>                 suggestPolarity()
+ *   <id> r <max var>                        randomizeForNextAssignment()
+ *   <id> y                                  simplify()
+ *   <id> a <literal>                        addAssumption()
+ *   <id> x                                  retractAllAssumptions()
+ *   <id> s <conflict limit> <status>        solve()
+ *   <id> u <conflict limit> <only proper subsets> <status> <literals> 0
+ *                                           solveUnderAssumptions()
+ * Literals are in the DIMACS notation and the status is one of
+ * s (satisfiable), u (unsatisfiable) and k (unknown).
+ *
+ * The assumption calls are only allowed when the inner solver
+ * is a SATSolverWithAssumptions.
+ */
+class RecordingSatSolver : public SATSolverWithAssumptions {
 public:
-  RecordingSatSolver(SATSolver* inner) : _inner(inner) {}
-
-  virtual void addClauses(SATClauseIterator cit, bool onlyPropagate,bool useInPartialModel);
-  virtual void randomizeAssignment();
-  virtual void ensureVarCnt(unsigned newVarCnt);
-  virtual void addAssumption(SATLiteral lit, unsigned conflictCountLimit);
-  virtual void retractAllAssumptions();
-
-  virtual Status getStatus() { return _inner->getStatus(); }
-  virtual VarAssignment getAssignment(unsigned var) { return _inner->getAssignment(var); }
-  virtual bool isZeroImplied(unsigned var) { return _inner->isZeroImplied(var); }
-  virtual void collectZeroImplied(SATLiteralStack& acc) { return _inner->collectZeroImplied(acc); }
-  virtual SATClause* getZeroImpliedCertificate(unsigned var) { return _inner->getZeroImpliedCertificate(var); }
-  virtual bool hasAssumptions() const { return _inner->hasAssumptions(); }
-  virtual SATClause* getRefutation() { return _inner->getRefutation(); }
-
-  virtual void recordSource(unsigned var, Literal* lit){
-    _inner->recordSource(var,lit);
-  }
+  CLASS_NAME(RecordingSatSolver);
+  USE_ALLOCATOR(RecordingSatSolver);
+
+  RecordingSatSolver(SATSolver* inner, const Options& opt, const char* origin);
+
+  virtual void addClause(SATClause* cl) override;
+  virtual void addClauseIgnoredInPartialModel(SATClause* cl) override;
+  virtual void simplify() override;
+  virtual Status solve(unsigned conflictCountLimit) override;
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+  virtual unsigned newVar() override;
+  virtual void suggestPolarity(unsigned var, unsigned pol) override;
+  virtual void randomizeForNextAssignment(unsigned maxVar) override;
+
+  virtual VarAssignment getAssignment(unsigned var) override { return _inner->getAssignment(var); }
+  virtual bool isZeroImplied(unsigned var) override { return _inner->isZeroImplied(var); }
+  virtual void collectZeroImplied(SATLiteralStack& acc) override { _inner->collectZeroImplied(acc); }
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override { return _inner->getZeroImpliedCertificate(var); }
+  virtual SATClause* getRefutation() override { return _inner->getRefutation(); }
+  virtual SATClauseList* getRefutationPremiseList() override { return _inner->getRefutationPremiseList(); }
+  virtual void recordSource(unsigned var, Literal* lit) override { _inner->recordSource(var,lit); }
+
+  virtual void addAssumption(SATLiteral lit) override;
+  virtual void retractAllAssumptions() override;
+  virtual bool hasAssumptions() const override { return _withAssumptions && _withAssumptions->hasAssumptions(); }
+  virtual Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit,
+      bool onlyProperSubusets) override;
+  virtual const SATLiteralStack& failedAssumptions() override;
 
 private:
+  static std::ostream& trace(const Options& opt);
 
-  vstring getHdr() const;
+  void writeClause(char action, SATClause* cl);
 
   SATSolverSCP _inner;
+  /** _inner if it supports assumptions, zero otherwise */
+  SATSolverWithAssumptions* _withAssumptions;
+  std::ostream& _out;
+  unsigned _id;
 };
 
-
+/**
+ * Reads a trace written by RecordingSatSolver and replays the calls
+ * of its solvers on other solvers, measuring the time of each call
+ * to solve.
+ */
 class SolverReplayer {
 public:
-  SolverReplayer(SATSolver& solver) : _solver(solver) {}
-
-  enum ReplayAction {
-    RA_ADD_CLAUSES,
-    RA_ADD_ASSUMPTION,
-    RA_RANDOMIZE_ASSIGNMENT,
-    RA_ENSURE_VAR_CNT,
-    RA_RETRACT_ALL_ASSUMPTIONS
+  CLASS_NAME(SolverReplayer);
+  USE_ALLOCATOR(SolverReplayer);
+
+  ~SolverReplayer();
+
+  /** Outcome of one replayed call to solve or solveUnderAssumptions */
+  struct SolveCall {
+    SATSolver::Status recorded;
+    SATSolver::Status replayed;
+    /** wall clock time of the call in nanoseconds */
+    long long nanos;
   };
 
-  static const EnumReader<ReplayAction>& getReplayActionReader();
-  struct ActionSpec {
-    ActionSpec();
+  void load(istream& stm);
 
-    ReplayAction action;
-    unsigned acOnlyPropagate;
-    vstring acClausesStr;
-    SATClauseStack acClauses;
-    unsigned evcVarCnt;
-    unsigned aaLitVar;
-    unsigned aaLitPolarity;
-    SATLiteral aaLit;
-    unsigned aaConflictCountLimit;
+  unsigned solverCount() const { return _solvers.size(); }
+  const vstring& origin(unsigned solver) const { return _solvers[solver]->origin; }
+  bool usesAssumptions(unsigned solver) const { return _solvers[solver]->assumptions; }
 
-    OptionsReader rdr;
+  void replay(unsigned solver, SATSolver& target, Stack<SolveCall>& calls);
+  void destroyClauses();
 
+  static long long nanoTime();
 
-    void readCommand(vstring str);
+private:
+  struct Step {
+    char action;
+    unsigned arg1;
+    unsigned arg2;
+    SATSolver::Status status;
+    /** range of the step's literals in _lits */
+    unsigned litsStart;
+    unsigned litsEnd;
+  };
+  struct SolverTrace {
+    CLASS_NAME(SolverReplayer::SolverTrace);
+    USE_ALLOCATOR(SolverReplayer::SolverTrace);
+
+    SolverTrace(vstring origin) : origin(origin), assumptions(false) {}
 
-    SATClauseIterator getClauses() {
-      ASS_EQ(action, RA_ADD_CLAUSES);
-      return pvi(SATClauseStack::BottomFirstIterator(acClauses));
-    }
-  private:
-    SATClause* readClause(vstring str);
+    vstring origin;
+    bool assumptions;
+    Stack<Step> steps;
   };
 
-  void performStep(vstring cmd);
-  void runFromStream(istream& stm, vstring prefix);
+  void readStep(vstring line);
 
-private:
-  SATSolver& _solver;
+  Stack<SolverTrace*> _solvers;
+  SATLiteralStack _lits;
+  /** clauses added during replays; they must outlive the solvers they were added to */
+  SATClauseStack _clauses;
 };
 
 }
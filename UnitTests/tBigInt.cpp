@@ -0,0 +1,68 @@
+
+/*
+ * File tBigInt.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+
+
+#include "Test/UnitTesting.hpp"
+#include "Kernel/Theory.hpp"
+
+#define UNIT_ID bigInt
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+TEST_FUN(bigIntArithmetic)
+{
+  IntegerConstantType max(LLONG_MAX);
+  IntegerConstantType min(LLONG_MIN);
+  IntegerConstantType big("123456789012345678901234567890");
+
+  ASS(!big.fitsInner());
+  ASS_EQ(big.toString(), "123456789012345678901234567890");
+  ASS_EQ((max+1).toString(), "9223372036854775808");
+  ASS_EQ((-min).toString(), "9223372036854775808");
+  ASS_EQ(max+1-1, max);
+  ASS((max+1-1).fitsInner());
+
+  IntegerConstantType sq = big*big;
+  ASS_EQ(sq.toString(), "15241578753238836750495351562536198787501905199875019052100");
+  ASS_EQ(sq/big, big);
+  ASS((sq%big).isZero());
+  ASS_EQ(((sq+7)%big).toString(), "7");
+  ASS_EQ(((-sq-7)%big).toString(), "-7");
+  ASS_EQ((-sq-7).quotientE(big), -big-1);
+  ASS_EQ((-sq-7).quotientF(-big), big);
+
+  ASS(big>max);
+  ASS(-big<min);
+  ASS_EQ(IntegerConstantType::gcd(sq, big*3), big*3);
+  ASS_EQ(IntegerConstantType::gcd(sq+1, big), 1);
+  ASS_EQ(IntegerConstantType::comparePrecedence(-big, big), GREATER);
+  ASS_EQ(IntegerConstantType::comparePrecedence(max, -big), LESS);
+}
+
+TEST_FUN(bigRational)
+{
+  RationalConstantType r(IntegerConstantType("100000000000000000000"), IntegerConstantType("300000000000000000000"));
+  ASS_EQ(r.toString(), "1/3");
+  RationalConstantType s = r*RationalConstantType(IntegerConstantType(LLONG_MAX), 5);
+  ASS_EQ(s.toString(), "9223372036854775807/15");
+  ASS_EQ((s+s+s).toString(), "9223372036854775807/5");
+}
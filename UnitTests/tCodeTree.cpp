@@ -0,0 +1,101 @@
+
+/*
+ * File tCodeTree.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+#include "Forwards.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/TermCodeTree.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID codeTree
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+
+/**
+ * Return true iff the term @b t is stored in @b tree
+ */
+static bool isStored(TermCodeTree& tree, TermList t)
+{
+  static TermCodeTree::TermMatcher tm;
+  tm.init(&tree, t);
+  bool res=false;
+  while(TermCodeTree::TermInfo* ti=tm.next()) {
+    if(ti->t==t) {
+      res=true;
+    }
+  }
+  tm.deinit();
+  return res;
+}
+
+/**
+ * Insert enough alternatives for the tree to build search structures,
+ * then remove most of them so that the code blocks get compacted and
+ * the search structures rebuilt, and check that retrieval is not affected
+ */
+TEST_FUN(removalCompaction)
+{
+  static const unsigned cnt=12;
+
+  unsigned g=env.signature->addFunction("ct_g",2);
+  TermList consts[cnt];
+  for(unsigned i=0;i<cnt;i++) {
+    unsigned c=env.signature->addFunction("ct_c"+Int::toString(i),0);
+    consts[i]=TermList(Term::createConstant(c));
+  }
+  TermList x(0,false);
+
+  Stack<TermList> terms;
+  for(unsigned i=0;i<cnt;i++) {
+    terms.push(TermList(Term::create2(g, consts[i], x)));
+    for(unsigned j=0;j<cnt;j++) {
+      terms.push(TermList(Term::create2(g, consts[i], consts[j])));
+    }
+  }
+
+  TermCodeTree tree;
+  for(unsigned i=0;i<terms.size();i++) {
+    tree.insert(new TermCodeTree::TermInfo(terms[i], 0, 0));
+  }
+
+  Stack<bool> removed;
+  for(unsigned i=0;i<terms.size();i++) {
+    removed.push(false);
+  }
+  for(unsigned i=0;i<terms.size();i++) {
+    if(i%5==0) {
+      continue;
+    }
+    tree.remove(TermCodeTree::TermInfo(terms[i], 0, 0));
+    removed[i]=true;
+
+    for(unsigned j=0;j<terms.size();j++) {
+      ASS_EQ(isStored(tree, terms[j]), !removed[j]);
+    }
+  }
+}
@@ -20,6 +20,7 @@
 #include "Lib/List.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/Environment.hpp"
+#include "Lib/Random.hpp"
 
 #include "SAT/SATClause.hpp"
 #include "SAT/SATLiteral.hpp"
@@ -27,6 +28,7 @@
 #include "SAT/SATSolver.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/CDCLSolver.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "Test/UnitTesting.hpp"
@@ -244,6 +246,10 @@ TEST_FUN(testSATSolverInterface)
   TWLSolver sTWL(*env.options,true);
   testInterface(sTWL);  
 
+  cout << endl << "CDCL" << endl;
+  CDCLSolver sCDCL(*env.options,true);
+  testInterface(sCDCL);
+
   /* Not fully conforming - does not support zeroImplied and resource-limited solving
   cout << endl << "Z3" << endl;
   {
@@ -308,6 +314,10 @@ TEST_FUN(testSolvingUnderAssumptions)
   TWLSolver sTWL(*env.options,true);
   testAssumptions(sTWL);
 
+  cout << endl << "CDCL" << endl;
+  CDCLSolver sCDCL(*env.options,true);
+  testAssumptions(sCDCL);
+
   /*cout << endl << "Z3" << endl;
   {
     SAT2FO sat2fo;
@@ -315,3 +325,70 @@ TEST_FUN(testSolvingUnderAssumptions)
     testAssumptions(sZ3);
   }*/
 }
+
+/**
+ * Random 3-SAT instances around the phase transition, solved incrementally
+ * under random assumptions, must get the same answers as from Minisat.
+ */
+TEST_FUN(testCDCLAgainstMinisat)
+{
+  const unsigned varCnt = 120;
+
+  for (unsigned round = 0; round < 20; round++) {
+    MinisatInterfacing mini(*env.options,true);
+    CDCLSolver cdcl(*env.options,true);
+    SATSolverWithAssumptions& sMini = mini;
+    SATSolverWithAssumptions& sCDCL = cdcl;
+    sMini.ensureVarCount(varCnt);
+    sCDCL.ensureVarCount(varCnt);
+    SATClauseStack clauses;
+
+    for (unsigned batch = 0; batch < 10; batch++) {
+      for (unsigned i = 0; i < 50; i++) {
+        SATLiteralStack lits;
+        while (lits.size() < 3) {
+          SATLiteral lit(Random::getInteger(varCnt)+1,Random::getBit());
+          bool clash = false;
+          for (unsigned j = 0; j < lits.size(); j++) {
+            clash |= lits[j].var() == lit.var();
+          }
+          if (!clash) {
+            lits.push(lit);
+          }
+        }
+        clauses.push(SATClause::fromStack(lits));
+        sMini.addClause(clauses.top());
+        sCDCL.addClause(clauses.top());
+      }
+
+      SATLiteralStack assumps;
+      for (unsigned i = 0; i < 5; i++) {
+        assumps.push(SATLiteral(Random::getInteger(varCnt)+1,Random::getBit()));
+      }
+      SATSolver::Status resMini = sMini.solveUnderAssumptions(assumps);
+      SATSolver::Status resCDCL = sCDCL.solveUnderAssumptions(assumps);
+      ASS_EQ(resMini,resCDCL);
+
+      if (resCDCL == SATSolver::SATISFIABLE) {
+        for (unsigned i = 0; i < assumps.size(); i++) {
+          ASS(sCDCL.trueInAssignment(assumps[i]));
+        }
+        SATClauseStack::Iterator cit(clauses);
+        while (cit.hasNext()) {
+          SATClause* cl = cit.next();
+          bool satisfied = false;
+          for (unsigned i = 0; i < cl->length(); i++) {
+            satisfied |= sCDCL.trueInAssignment((*cl)[i]);
+          }
+          ASS(satisfied);
+        }
+      }
+      if (resCDCL == SATSolver::UNSATISFIABLE) {
+        // the failed assumptions alone must already be unsatisfiable
+        SATLiteralStack failed = sCDCL.failedAssumptions();
+        ASS_EQ(sMini.solveUnderAssumptions(failed),SATSolver::UNSATISFIABLE);
+      }
+      ASS_EQ(sMini.solve(),sCDCL.solve());
+    }
+  }
+}
@@ -0,0 +1,135 @@
+/*
+ * File tSubstitutionTree.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+#include <algorithm>
+
+#include "Forwards.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID substTree
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+
+struct TermContentLess
+{
+  bool operator()(TermList t1, TermList t2) const
+  { return t1.content() < t2.content(); }
+};
+
+/**
+ * Return the sorted terms retrieved by @b it
+ */
+static Stack<TermList> retrieved(TermQueryResultIterator it)
+{
+  Stack<TermList> res;
+  while(it.hasNext()) {
+    res.push(it.next().term);
+  }
+  std::sort(res.begin(), res.end(), TermContentLess());
+  return res;
+}
+
+static void checkSameRetrieval(TermSubstitutionTree& t1, TermSubstitutionTree& t2, Stack<TermList>& queries)
+{
+  Stack<TermList>::Iterator qit(queries);
+  while(qit.hasNext()) {
+    TermList q=qit.next();
+    ASS(retrieved(t1.getUnifications(q, false))==retrieved(t2.getUnifications(q, false)));
+    ASS(retrieved(t1.getGeneralizations(q, false))==retrieved(t2.getGeneralizations(q, false)));
+    ASS(retrieved(t1.getInstances(q, false))==retrieved(t2.getInstances(q, false)));
+  }
+}
+
+/**
+ * Build one tree by bulk insertion and another one term by term,
+ * and check that they retrieve the same terms, also after more terms
+ * are bulk inserted into the non-empty trees and after removals
+ */
+TEST_FUN(bulkInsertion)
+{
+  static const unsigned cnt=8;
+
+  unsigned f=env.signature->addFunction("st_f",2);
+  unsigned g=env.signature->addFunction("st_g",1);
+  TermList consts[cnt];
+  for(unsigned i=0;i<cnt;i++) {
+    unsigned c=env.signature->addFunction("st_c"+Int::toString(i),0);
+    consts[i]=TermList(Term::createConstant(c));
+  }
+  TermList x(0,false);
+  TermList y(1,false);
+
+  Stack<TermList> terms;
+  terms.push(x);
+  terms.push(TermList(Term::create2(f, x, x)));
+  terms.push(TermList(Term::create2(f, x, y)));
+  terms.push(TermList(Term::create2(f, y, x)));
+  for(unsigned i=0;i<cnt;i++) {
+    TermList gc(Term::create1(g, consts[i]));
+    terms.push(consts[i]);
+    terms.push(gc);
+    terms.push(TermList(Term::create2(f, consts[i], x)));
+    terms.push(TermList(Term::create2(f, gc, y)));
+    terms.push(TermList(Term::create1(g, TermList(Term::create2(f, x, consts[i])))));
+    for(unsigned j=0;j<cnt;j++) {
+      terms.push(TermList(Term::create2(f, consts[i], TermList(Term::create1(g, consts[j])))));
+    }
+  }
+
+  Stack<TermList> queries(terms);
+  queries.push(TermList(Term::create2(f, consts[0], consts[1])));
+  queries.push(TermList(Term::create1(g, x)));
+
+  unsigned half=terms.size()/2;
+
+  TermSubstitutionTree incremental;
+  TermSubstitutionTree bulk;
+  TermIndexingStructure::EntryStack batch;
+  for(unsigned i=0;i<half;i++) {
+    incremental.insert(terms[i], 0, 0);
+    batch.push(TermIndexingStructure::Entry(terms[i], 0, 0));
+  }
+  bulk.bulkInsert(batch);
+  checkSameRetrieval(incremental, bulk, queries);
+
+  batch.reset();
+  for(unsigned i=half;i<terms.size();i++) {
+    incremental.insert(terms[i], 0, 0);
+    batch.push(TermIndexingStructure::Entry(terms[i], 0, 0));
+  }
+  bulk.bulkInsert(batch);
+  checkSameRetrieval(incremental, bulk, queries);
+
+  for(unsigned i=0;i<terms.size();i+=2) {
+    incremental.remove(terms[i], 0, 0);
+    bulk.remove(terms[i], 0, 0);
+  }
+  checkSameRetrieval(incremental, bulk, queries);
+}
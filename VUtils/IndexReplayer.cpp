@@ -0,0 +1,387 @@
+/*
+ * File IndexReplayer.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file IndexReplayer.cpp
+ * Implements class IndexReplayer.
+ */
+
+#include <fstream>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Metaiterators.hpp"
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "Indexing/CodeTreeInterfaces.hpp"
+#include "Indexing/LiteralSubstitutionTree.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "IndexReplayer.hpp"
+
+namespace VUtils
+{
+
+using namespace Indexing;
+
+int IndexReplayer::perform(int argc, char** argv)
+{
+  CALL("IndexReplayer::perform");
+
+  if(argc!=3 && argc!=4) {
+    cerr << "invalid command line"<<endl<<
+	    "Usage:"<<endl<<
+	    argv[0]<<" "<<argv[1]<<" <trace file> [subst|subst_c|code]"<<endl<<
+	    "The structures are replayed with the recorded implementation, unless one is given."<<endl;
+    exit(1);
+  }
+
+  {
+    std::ifstream in(argv[2]);
+    if(!in) {
+      USER_ERROR(vstring("Cannot open index trace file: ")+argv[2]);
+    }
+    readTrace(in);
+  }
+
+  bool allAgree = true;
+  Stack<Structure*>::BottomFirstIterator sit(_structures);
+  while(sit.hasNext()) {
+    Structure* s = sit.next();
+    vstring implementation = argc==4 ? vstring(argv[3]) : s->implementation;
+    if(!replay(*s, implementation)) {
+      allAgree = false;
+    }
+  }
+  return allAgree ? 0 : 1;
+}
+
+/**
+ * Read the whole trace, creating the terms, literals and the clauses
+ * standing for the recorded clause numbers
+ *
+ * A last line without the end of line character is ignored, as the trace
+ * of a run terminated by the time limit can end in the middle of a line.
+ */
+void IndexReplayer::readTrace(std::istream& inp)
+{
+  CALL("IndexReplayer::readTrace");
+
+  vstring line;
+  while(getline(inp, line)) {
+    if(inp.eof()) {
+      break;
+    }
+    vistringstream in(line);
+    vstring tok;
+    if(!(in >> tok)) {
+      continue;
+    }
+    if(tok=="index") {
+      Structure* s = new Structure;
+      vstring kind;
+      in >> s->id >> s->indexType >> kind >> s->implementation;
+      s->literals = kind=="lit";
+      _structures.push(s);
+      _structuresById.set(s->id, s);
+      continue;
+    }
+    unsigned id;
+    if(!Int::stringToUnsignedInt(tok, id) || !_structuresById.find(id)) {
+      USER_ERROR("Invalid index trace, unknown structure: "+tok);
+    }
+    Structure* s = _structuresById.get(id);
+
+    Operation op;
+    op.kind = 0;
+    op.complementary = false;
+    op.retrieveSubstitutions = false;
+    op.resultCnt = 0;
+    op.clause = 0;
+    op.literal = 0;
+    in >> op.type;
+    if(op.type=='i' || op.type=='r') {
+      unsigned clauseNumber;
+      in >> clauseNumber;
+      op.clause = getClause(clauseNumber);
+      if(!s->literals) {
+	op.term = readTerm(in);
+      }
+      op.literal = readLiteral(in);
+    }
+    else if(op.type=='q') {
+      in >> op.kind >> op.complementary >> op.retrieveSubstitutions >> op.resultCnt;
+      if(s->literals) {
+	op.literal = readLiteral(in);
+      }
+      else {
+	op.term = readTerm(in);
+      }
+    }
+    else {
+      USER_ERROR(vstring("Invalid index trace, unknown operation: ")+op.type);
+    }
+    if(!in) {
+      USER_ERROR("Invalid index trace, unexpected end of the trace");
+    }
+    s->operations.push(op);
+  }
+}
+
+/**
+ * Return the symbol standing for the recorded symbol @b token of the
+ * form <letter><number>/<arity> and assign its arity to @b arity
+ */
+unsigned IndexReplayer::getSymbol(const vstring& token, bool predicate, unsigned& arity)
+{
+  CALL("IndexReplayer::getSymbol");
+
+  size_t slash = token.find('/');
+  unsigned number;
+  if(slash==vstring::npos || !Int::stringToUnsignedInt(token.substr(1, slash-1), number) ||
+      !Int::stringToUnsignedInt(token.substr(slash+1), arity)) {
+    USER_ERROR("Invalid index trace, bad symbol: "+token);
+  }
+  DHMap<unsigned,unsigned>& symbols = predicate ? _predicates : _functions;
+  unsigned* res;
+  if(symbols.getValuePtr(number, res)) {
+    vstring name = token.substr(0, slash);
+    *res = predicate ? env.signature->addPredicate(name, arity) : env.signature->addFunction(name, arity);
+  }
+  return *res;
+}
+
+TermList IndexReplayer::readTerm(std::istream& in)
+{
+  CALL("IndexReplayer::readTerm");
+
+  vstring tok;
+  in >> tok;
+  if(tok.empty()) {
+    USER_ERROR("Invalid index trace, unexpected end of a term");
+  }
+  if(tok[0]=='X') {
+    unsigned var;
+    if(!Int::stringToUnsignedInt(tok.substr(1), var)) {
+      USER_ERROR("Invalid index trace, bad variable: "+tok);
+    }
+    return TermList(var, false);
+  }
+  unsigned arity;
+  unsigned fn = getSymbol(tok, false, arity);
+  Stack<TermList> args(arity);
+  for(unsigned i=0; i<arity; i++) {
+    args.push(readTerm(in));
+  }
+  return TermList(Term::create(fn, arity, args.begin()));
+}
+
+Literal* IndexReplayer::readLiteral(std::istream& in)
+{
+  CALL("IndexReplayer::readLiteral");
+
+  vstring tok;
+  in >> tok;
+  if(tok.size()<2 || (tok[0]!='+' && tok[0]!='-')) {
+    USER_ERROR("Invalid index trace, bad literal: "+tok);
+  }
+  bool polarity = tok[0]=='+';
+  if(tok[1]=='e') {
+    unsigned recordedSort;
+    if(!Int::stringToUnsignedInt(tok.substr(2), recordedSort)) {
+      USER_ERROR("Invalid index trace, bad equality: "+tok);
+    }
+    unsigned sort = recordedSort;
+    if(recordedSort>=Sorts::FIRST_USER_SORT) {
+      unsigned* pSort;
+      if(_sorts.getValuePtr(recordedSort, pSort)) {
+	*pSort = env.sorts->addSort("s"+Int::toString(recordedSort), false);
+      }
+      sort = *pSort;
+    }
+    TermList lhs = readTerm(in);
+    TermList rhs = readTerm(in);
+    return Literal::createEquality(polarity, lhs, rhs, sort);
+  }
+  unsigned arity;
+  unsigned pred = getSymbol(tok.substr(1), true, arity);
+  Stack<TermList> args(arity);
+  for(unsigned i=0; i<arity; i++) {
+    args.push(readTerm(in));
+  }
+  return Literal::create(pred, arity, polarity, false, args.begin());
+}
+
+/**
+ * Return the clause standing for the recorded clause number @b number
+ */
+Clause* IndexReplayer::getClause(unsigned number)
+{
+  CALL("IndexReplayer::getClause");
+
+  Clause** res;
+  if(_clauses.getValuePtr(number, res)) {
+    *res = new(0) Clause(0, Unit::AXIOM, new Inference(Inference::INPUT));
+  }
+  return *res;
+}
+
+/**
+ * Replay the operations of @b s on a new structure of the implementation
+ * @b implementation, print the results and return true iff the numbers
+ * of query results agree with the recorded ones.
+ */
+bool IndexReplayer::replay(Structure& s, vstring implementation)
+{
+  CALL("IndexReplayer::replay");
+
+  ScopedPtr<LiteralIndexingStructure> lis;
+  ScopedPtr<TermIndexingStructure> tis;
+  bool onlyGeneralizations = false;
+  if(s.literals) {
+    if(implementation=="subst") {
+      lis = new LiteralSubstitutionTree();
+    }
+    else if(implementation=="subst_c") {
+      lis = new LiteralSubstitutionTree(true);
+    }
+  }
+  else {
+    if(implementation=="subst") {
+      tis = new TermSubstitutionTree();
+    }
+    else if(implementation=="subst_c") {
+      tis = new TermSubstitutionTree(true);
+    }
+    else if(implementation=="code") {
+      tis = new CodeTreeTIS();
+      onlyGeneralizations = true;
+    }
+  }
+
+  env.beginOutput();
+  env.out() << "index " << s.id << " (type " << s.indexType << ", recorded " << s.implementation
+      << ", replayed " << implementation << "): ";
+  env.endOutput();
+
+  if(!lis && !tis) {
+    env.beginOutput();
+    env.out() << "skipped, implementation not available" << endl;
+    env.endOutput();
+    return true;
+  }
+  if(onlyGeneralizations) {
+    Stack<Operation>::BottomFirstIterator oit(s.operations);
+    while(oit.hasNext()) {
+      const Operation& op = oit.next();
+      if(op.type=='q' && op.kind!='g' && op.kind!='e') {
+	env.beginOutput();
+	env.out() << "skipped, the implementation supports only generalization queries" << endl;
+	env.endOutput();
+	return true;
+      }
+    }
+  }
+
+  unsigned queries = 0;
+  unsigned mismatches = 0;
+  int startTime = env.timer->elapsedMilliseconds();
+
+  Stack<Operation>::BottomFirstIterator oit(s.operations);
+  while(oit.hasNext()) {
+    const Operation& op = oit.next();
+    if(op.type=='i') {
+      if(lis) { lis->insert(op.literal, op.clause); }
+      else { tis->insert(op.term, op.literal, op.clause); }
+      continue;
+    }
+    if(op.type=='r') {
+      if(lis) { lis->remove(op.literal, op.clause); }
+      else { tis->remove(op.term, op.literal, op.clause); }
+      continue;
+    }
+    ASS_EQ(op.type,'q');
+    queries++;
+    size_t cnt = 0;
+    if(lis) {
+      switch(op.kind) {
+      case 'u':
+	cnt = countIteratorElements(lis->getUnifications(op.literal, op.complementary, op.retrieveSubstitutions));
+	break;
+      case 'w':
+	cnt = countIteratorElements(lis->getUnificationsWithConstraints(op.literal, op.complementary, op.retrieveSubstitutions));
+	break;
+      case 'g':
+	cnt = countIteratorElements(lis->getGeneralizations(op.literal, op.complementary, op.retrieveSubstitutions));
+	break;
+      case 'n':
+	cnt = countIteratorElements(lis->getInstances(op.literal, op.complementary, op.retrieveSubstitutions));
+	break;
+      case 'v':
+	cnt = countIteratorElements(lis->getVariants(op.literal, op.complementary, op.retrieveSubstitutions));
+	break;
+      default:
+	USER_ERROR(vstring("Invalid index trace, unknown literal query: ")+op.kind);
+      }
+    }
+    else {
+      switch(op.kind) {
+      case 'u':
+	cnt = countIteratorElements(tis->getUnifications(op.term, op.retrieveSubstitutions));
+	break;
+      case 'w':
+	cnt = countIteratorElements(tis->getUnificationsWithConstraints(op.term, op.retrieveSubstitutions));
+	break;
+      case 'g':
+	cnt = countIteratorElements(tis->getGeneralizations(op.term, op.retrieveSubstitutions));
+	break;
+      case 'n':
+	cnt = countIteratorElements(tis->getInstances(op.term, op.retrieveSubstitutions));
+	break;
+      case 'e':
+	cnt = tis->generalizationExists(op.term) ? 1 : 0;
+	break;
+      default:
+	USER_ERROR(vstring("Invalid index trace, unknown term query: ")+op.kind);
+      }
+    }
+    if(cnt!=op.resultCnt) {
+      mismatches++;
+    }
+  }
+
+  int time = env.timer->elapsedMilliseconds()-startTime;
+
+  env.beginOutput();
+  env.out() << s.operations.size() << " operations (" << queries << " queries) in " << time << " ms";
+  if(time>0) {
+    env.out() << ", " << static_cast<unsigned long long>(s.operations.size())*1000/time << " operations/s";
+  }
+  env.out() << ", " << mismatches << " result count mismatches" << endl;
+  env.endOutput();
+
+  return mismatches==0;
+}
+
+}
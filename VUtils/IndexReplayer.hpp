@@ -0,0 +1,101 @@
+/*
+ * File IndexReplayer.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file IndexReplayer.hpp
+ * Defines class IndexReplayer.
+ */
+
+#ifndef __IndexReplayer__
+#define __IndexReplayer__
+
+#include <istream>
+
+#include "Forwards.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+#include "Kernel/Term.hpp"
+
+namespace VUtils {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Replays a trace written with the index_trace option (see
+ * Indexing::IndexTrace) against the indexing structure of each recorded
+ * index, or against an alternative implementation, and reports the
+ * number of operations per second and whether the numbers of query
+ * results agree with the recorded ones.
+ *
+ * The operations of each structure are replayed separately, after the
+ * whole trace was read, so that the parsing is not measured.
+ */
+class IndexReplayer {
+public:
+  int perform(int argc, char** argv);
+
+private:
+  struct Operation
+  {
+    /** 'i' for insertion, 'r' for removal, 'q' for query */
+    char type;
+    /** kind of the query, see Indexing::IndexTrace */
+    char kind;
+    bool complementary;
+    bool retrieveSubstitutions;
+    size_t resultCnt;
+    Clause* clause;
+    Literal* literal;
+    TermList term;
+  };
+
+  struct Structure
+  {
+    CLASS_NAME(IndexReplayer::Structure);
+    USE_ALLOCATOR(IndexReplayer::Structure);
+
+    unsigned id;
+    unsigned indexType;
+    bool literals;
+    vstring implementation;
+    Stack<Operation> operations;
+  };
+
+  void readTrace(std::istream& inp);
+  TermList readTerm(std::istream& in);
+  Literal* readLiteral(std::istream& in);
+  Clause* getClause(unsigned number);
+  unsigned getSymbol(const vstring& token, bool predicate, unsigned& arity);
+
+  bool replay(Structure& s, vstring implementation);
+
+  Stack<Structure*> _structures;
+  DHMap<unsigned,Structure*> _structuresById;
+  /** the clauses standing for the recorded clause numbers */
+  DHMap<unsigned,Clause*> _clauses;
+  DHMap<unsigned,unsigned> _functions;
+  DHMap<unsigned,unsigned> _predicates;
+  DHMap<unsigned,unsigned> _sorts;
+};
+
+}
+
+#endif // __IndexReplayer__
@@ -21,13 +21,20 @@
  * Implements class SATReplayer.
  */
 
+#include <algorithm>
 #include <fstream>
 
 #include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Random.hpp"
 
+#include "SAT/BufferedSolver.hpp"
+#include "SAT/CDCLSolver.hpp"
+#include "SAT/MinisatInterfacing.hpp"
+#include "SAT/MinisatInterfacingNewSimp.hpp"
 #include "SAT/TWLSolver.hpp"
 
-#include "Test/RecordingSatSolver.hpp"
+#include "Shell/Options.hpp"
 
 #include "SATReplayer.hpp"
 
@@ -37,25 +44,157 @@ namespace VUtils
 using namespace Lib;
 using namespace SAT;
 
+static const char* backends[] = {"twl", "minisat", "minisat_simp", "cdcl", "buffered", 0};
+
 int SATReplayer::perform(int argc, char** argv)
 {
   CALL("SATReplayer::perform");
 
-  if(argc!=4) {
+  if(argc<3) {
     cerr << "invalid command line"<<endl<<
 	    "Usage:"<<endl<<
-	    argv[0]<<" "<<argv[1]<<" <prefix> <file name>"<<endl;
+	    argv[0]<<" "<<argv[1]<<" <trace file> [<backend> ...]"<<endl<<
+	    "The backends are twl, minisat, minisat_simp, cdcl and buffered (minisat behind"<<endl<<
+	    "a BufferedSolver); all of them are used unless some are given."<<endl;
     exit(1);
   }
 
-  vstring prefix = vstring(argv[2])+" ";
-  ifstream inp(argv[3]);
+  Test::SolverReplayer replayer;
+  {
+    std::ifstream in(argv[2]);
+    if(!in) {
+      USER_ERROR(vstring("Cannot open SAT trace file: ")+argv[2]);
+    }
+    replayer.load(in);
+  }
+
+  Stack<vstring> origins;
+  for(unsigned i=0;i<replayer.solverCount();i++) {
+    if(!origins.find(replayer.origin(i))) {
+      origins.push(replayer.origin(i));
+    }
+  }
+
+  Stack<vstring> selected;
+  for(int i=3;i<argc;i++) {
+    selected.push(argv[i]);
+  }
+  if(selected.isEmpty()) {
+    for(unsigned i=0;backends[i];i++) {
+      selected.push(backends[i]);
+    }
+  }
+
+  bool allAgree = true;
+  Stack<vstring>::BottomFirstIterator bit(selected);
+  while(bit.hasNext()) {
+    vstring backend = bit.next();
+    Stack<vstring>::BottomFirstIterator oit(origins);
+    while(oit.hasNext()) {
+      if(!benchmark(replayer, backend, oit.next())) {
+	allAgree = false;
+      }
+    }
+  }
+  return allAgree ? 0 : 1;
+}
+
+SATSolver* SATReplayer::createSolver(const vstring& backend)
+{
+  CALL("SATReplayer::createSolver");
+
+  if(backend=="twl") {
+    return new TWLSolver(*env.options, true);
+  }
+  if(backend=="minisat") {
+    return new MinisatInterfacing(*env.options, true);
+  }
+  if(backend=="minisat_simp") {
+    return new MinisatInterfacingNewSimp(*env.options, true);
+  }
+  if(backend=="cdcl") {
+    return new CDCLSolver(*env.options, true);
+  }
+  if(backend=="buffered") {
+    return new BufferedSolver(new MinisatInterfacing(*env.options, true));
+  }
+  USER_ERROR("Unknown SAT solver backend: "+backend);
+}
+
+/**
+ * Replay the recorded solvers of origin @b origin with the solver
+ * @b backend and print the report. Return false if some results
+ * disagree with the recorded ones.
+ */
+bool SATReplayer::benchmark(Test::SolverReplayer& replayer, const vstring& backend, const vstring& origin)
+{
+  CALL("SATReplayer::benchmark");
 
-  TWLSolver solver(*env.options, true);
-  Test::SolverReplayer replayer(solver);
-  replayer.runFromStream(inp, prefix);
+  // the randomized polarities are the same for each backend
+  Random::setSeed(1);
+
+  Stack<Test::SolverReplayer::SolveCall> calls;
+  unsigned solvers = 0;
+  unsigned skipped = 0;
+  long long total = 0;
+  for(unsigned i=0;i<replayer.solverCount();i++) {
+    if(replayer.origin(i)!=origin) {
+      continue;
+    }
+    long long start = Test::SolverReplayer::nanoTime();
+    SATSolver* solver = createSolver(backend);
+    if(replayer.usesAssumptions(i) && !dynamic_cast<SATSolverWithAssumptions*>(solver)) {
+      delete solver;
+      skipped++;
+      continue;
+    }
+    replayer.replay(i, *solver, calls);
+    delete solver;
+    total += Test::SolverReplayer::nanoTime()-start;
+    replayer.destroyClauses();
+    solvers++;
+  }
+
+  unsigned agree = 0;
+  unsigned disagree = 0;
+  unsigned inconclusive = 0;
+  long long solveTotal = 0;
+  static Stack<long long> latencies;
+  latencies.reset();
+  Stack<Test::SolverReplayer::SolveCall>::BottomFirstIterator cit(calls);
+  while(cit.hasNext()) {
+    const Test::SolverReplayer::SolveCall& call = cit.next();
+    latencies.push(call.nanos);
+    solveTotal += call.nanos;
+    if(call.recorded==SATSolver::UNKNOWN || call.replayed==SATSolver::UNKNOWN) {
+      inconclusive++;
+    }
+    else if(call.recorded==call.replayed) {
+      agree++;
+    }
+    else {
+      disagree++;
+    }
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  env.beginOutput();
+  env.out() << backend << " on " << origin << ": " << solvers << " solvers";
+  if(skipped) {
+    env.out() << " (" << skipped << " skipped, assumptions not supported)";
+  }
+  env.out() << ", " << calls.size() << " solve calls, total " << total/1000000 << " ms, solving "
+      << solveTotal/1000000 << " ms";
+  if(latencies.isNonEmpty()) {
+    size_t n = latencies.size();
+    env.out() << ", latency [us] p50 " << latencies[(n-1)/2]/1000 << " p90 " << latencies[(n-1)*9/10]/1000
+	<< " p99 " << latencies[(n-1)*99/100]/1000 << " max " << latencies.top()/1000;
+  }
+  env.out() << ", results " << agree << " agree, " << disagree << " disagree, "
+      << inconclusive << " inconclusive" << endl;
+  env.endOutput();
 
-  return 0;
+  return disagree==0;
 }
 
 }
@@ -26,11 +26,34 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+#include "Test/RecordingSatSolver.hpp"
+
 namespace VUtils {
 
+using namespace Lib;
+using namespace SAT;
+
+/**
+ * Benchmark of the SAT solvers on a trace written with the sat_trace
+ * option (see Test::RecordingSatSolver).
+ *
+ * The calls of each recorded solver are replayed on each of the requested
+ * solver backends. For every backend and origin of the recorded solvers
+ * (avatar or fmb) the total time, the percentiles of the latency of the
+ * calls to solve and the agreement of their results with the recorded
+ * ones are reported. Results are only compared when neither of them is
+ * UNKNOWN.
+ */
 class SATReplayer {
 public:
   int perform(int argc, char** argv);
+
+private:
+  SATSolver* createSolver(const vstring& backend);
+  bool benchmark(Test::SolverReplayer& replayer, const vstring& backend, const vstring& origin);
 };
 
 }
@@ -0,0 +1,6 @@
+% params: -sa discount -al 1500
+
+fof(assoc, axiom, ![X,Y,Z]: mult(mult(X,Y),Z) = mult(X,mult(Y,Z))).
+fof(left_id, axiom, ![X]: mult(e,X) = X).
+fof(left_inv, axiom, ![X]: mult(inv(X),X) = e).
+fof(nonab, axiom, mult(a,b) != mult(b,a)).
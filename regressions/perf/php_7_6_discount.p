@@ -0,0 +1,139 @@
+% params: -sa discount -av off -al 5000
+
+fof(a0,axiom,in(p0,h0)|in(p0,h1)|in(p0,h2)|in(p0,h3)|in(p0,h4)|in(p0,h5)).
+fof(a1,axiom,in(p1,h0)|in(p1,h1)|in(p1,h2)|in(p1,h3)|in(p1,h4)|in(p1,h5)).
+fof(a2,axiom,in(p2,h0)|in(p2,h1)|in(p2,h2)|in(p2,h3)|in(p2,h4)|in(p2,h5)).
+fof(a3,axiom,in(p3,h0)|in(p3,h1)|in(p3,h2)|in(p3,h3)|in(p3,h4)|in(p3,h5)).
+fof(a4,axiom,in(p4,h0)|in(p4,h1)|in(p4,h2)|in(p4,h3)|in(p4,h4)|in(p4,h5)).
+fof(a5,axiom,in(p5,h0)|in(p5,h1)|in(p5,h2)|in(p5,h3)|in(p5,h4)|in(p5,h5)).
+fof(a6,axiom,in(p6,h0)|in(p6,h1)|in(p6,h2)|in(p6,h3)|in(p6,h4)|in(p6,h5)).
+fof(a7,axiom,~in(p0,h0)|~in(p1,h0)).
+fof(a8,axiom,~in(p0,h0)|~in(p2,h0)).
+fof(a9,axiom,~in(p0,h0)|~in(p3,h0)).
+fof(a10,axiom,~in(p0,h0)|~in(p4,h0)).
+fof(a11,axiom,~in(p0,h0)|~in(p5,h0)).
+fof(a12,axiom,~in(p0,h0)|~in(p6,h0)).
+fof(a13,axiom,~in(p1,h0)|~in(p2,h0)).
+fof(a14,axiom,~in(p1,h0)|~in(p3,h0)).
+fof(a15,axiom,~in(p1,h0)|~in(p4,h0)).
+fof(a16,axiom,~in(p1,h0)|~in(p5,h0)).
+fof(a17,axiom,~in(p1,h0)|~in(p6,h0)).
+fof(a18,axiom,~in(p2,h0)|~in(p3,h0)).
+fof(a19,axiom,~in(p2,h0)|~in(p4,h0)).
+fof(a20,axiom,~in(p2,h0)|~in(p5,h0)).
+fof(a21,axiom,~in(p2,h0)|~in(p6,h0)).
+fof(a22,axiom,~in(p3,h0)|~in(p4,h0)).
+fof(a23,axiom,~in(p3,h0)|~in(p5,h0)).
+fof(a24,axiom,~in(p3,h0)|~in(p6,h0)).
+fof(a25,axiom,~in(p4,h0)|~in(p5,h0)).
+fof(a26,axiom,~in(p4,h0)|~in(p6,h0)).
+fof(a27,axiom,~in(p5,h0)|~in(p6,h0)).
+fof(a28,axiom,~in(p0,h1)|~in(p1,h1)).
+fof(a29,axiom,~in(p0,h1)|~in(p2,h1)).
+fof(a30,axiom,~in(p0,h1)|~in(p3,h1)).
+fof(a31,axiom,~in(p0,h1)|~in(p4,h1)).
+fof(a32,axiom,~in(p0,h1)|~in(p5,h1)).
+fof(a33,axiom,~in(p0,h1)|~in(p6,h1)).
+fof(a34,axiom,~in(p1,h1)|~in(p2,h1)).
+fof(a35,axiom,~in(p1,h1)|~in(p3,h1)).
+fof(a36,axiom,~in(p1,h1)|~in(p4,h1)).
+fof(a37,axiom,~in(p1,h1)|~in(p5,h1)).
+fof(a38,axiom,~in(p1,h1)|~in(p6,h1)).
+fof(a39,axiom,~in(p2,h1)|~in(p3,h1)).
+fof(a40,axiom,~in(p2,h1)|~in(p4,h1)).
+fof(a41,axiom,~in(p2,h1)|~in(p5,h1)).
+fof(a42,axiom,~in(p2,h1)|~in(p6,h1)).
+fof(a43,axiom,~in(p3,h1)|~in(p4,h1)).
+fof(a44,axiom,~in(p3,h1)|~in(p5,h1)).
+fof(a45,axiom,~in(p3,h1)|~in(p6,h1)).
+fof(a46,axiom,~in(p4,h1)|~in(p5,h1)).
+fof(a47,axiom,~in(p4,h1)|~in(p6,h1)).
+fof(a48,axiom,~in(p5,h1)|~in(p6,h1)).
+fof(a49,axiom,~in(p0,h2)|~in(p1,h2)).
+fof(a50,axiom,~in(p0,h2)|~in(p2,h2)).
+fof(a51,axiom,~in(p0,h2)|~in(p3,h2)).
+fof(a52,axiom,~in(p0,h2)|~in(p4,h2)).
+fof(a53,axiom,~in(p0,h2)|~in(p5,h2)).
+fof(a54,axiom,~in(p0,h2)|~in(p6,h2)).
+fof(a55,axiom,~in(p1,h2)|~in(p2,h2)).
+fof(a56,axiom,~in(p1,h2)|~in(p3,h2)).
+fof(a57,axiom,~in(p1,h2)|~in(p4,h2)).
+fof(a58,axiom,~in(p1,h2)|~in(p5,h2)).
+fof(a59,axiom,~in(p1,h2)|~in(p6,h2)).
+fof(a60,axiom,~in(p2,h2)|~in(p3,h2)).
+fof(a61,axiom,~in(p2,h2)|~in(p4,h2)).
+fof(a62,axiom,~in(p2,h2)|~in(p5,h2)).
+fof(a63,axiom,~in(p2,h2)|~in(p6,h2)).
+fof(a64,axiom,~in(p3,h2)|~in(p4,h2)).
+fof(a65,axiom,~in(p3,h2)|~in(p5,h2)).
+fof(a66,axiom,~in(p3,h2)|~in(p6,h2)).
+fof(a67,axiom,~in(p4,h2)|~in(p5,h2)).
+fof(a68,axiom,~in(p4,h2)|~in(p6,h2)).
+fof(a69,axiom,~in(p5,h2)|~in(p6,h2)).
+fof(a70,axiom,~in(p0,h3)|~in(p1,h3)).
+fof(a71,axiom,~in(p0,h3)|~in(p2,h3)).
+fof(a72,axiom,~in(p0,h3)|~in(p3,h3)).
+fof(a73,axiom,~in(p0,h3)|~in(p4,h3)).
+fof(a74,axiom,~in(p0,h3)|~in(p5,h3)).
+fof(a75,axiom,~in(p0,h3)|~in(p6,h3)).
+fof(a76,axiom,~in(p1,h3)|~in(p2,h3)).
+fof(a77,axiom,~in(p1,h3)|~in(p3,h3)).
+fof(a78,axiom,~in(p1,h3)|~in(p4,h3)).
+fof(a79,axiom,~in(p1,h3)|~in(p5,h3)).
+fof(a80,axiom,~in(p1,h3)|~in(p6,h3)).
+fof(a81,axiom,~in(p2,h3)|~in(p3,h3)).
+fof(a82,axiom,~in(p2,h3)|~in(p4,h3)).
+fof(a83,axiom,~in(p2,h3)|~in(p5,h3)).
+fof(a84,axiom,~in(p2,h3)|~in(p6,h3)).
+fof(a85,axiom,~in(p3,h3)|~in(p4,h3)).
+fof(a86,axiom,~in(p3,h3)|~in(p5,h3)).
+fof(a87,axiom,~in(p3,h3)|~in(p6,h3)).
+fof(a88,axiom,~in(p4,h3)|~in(p5,h3)).
+fof(a89,axiom,~in(p4,h3)|~in(p6,h3)).
+fof(a90,axiom,~in(p5,h3)|~in(p6,h3)).
+fof(a91,axiom,~in(p0,h4)|~in(p1,h4)).
+fof(a92,axiom,~in(p0,h4)|~in(p2,h4)).
+fof(a93,axiom,~in(p0,h4)|~in(p3,h4)).
+fof(a94,axiom,~in(p0,h4)|~in(p4,h4)).
+fof(a95,axiom,~in(p0,h4)|~in(p5,h4)).
+fof(a96,axiom,~in(p0,h4)|~in(p6,h4)).
+fof(a97,axiom,~in(p1,h4)|~in(p2,h4)).
+fof(a98,axiom,~in(p1,h4)|~in(p3,h4)).
+fof(a99,axiom,~in(p1,h4)|~in(p4,h4)).
+fof(a100,axiom,~in(p1,h4)|~in(p5,h4)).
+fof(a101,axiom,~in(p1,h4)|~in(p6,h4)).
+fof(a102,axiom,~in(p2,h4)|~in(p3,h4)).
+fof(a103,axiom,~in(p2,h4)|~in(p4,h4)).
+fof(a104,axiom,~in(p2,h4)|~in(p5,h4)).
+fof(a105,axiom,~in(p2,h4)|~in(p6,h4)).
+fof(a106,axiom,~in(p3,h4)|~in(p4,h4)).
+fof(a107,axiom,~in(p3,h4)|~in(p5,h4)).
+fof(a108,axiom,~in(p3,h4)|~in(p6,h4)).
+fof(a109,axiom,~in(p4,h4)|~in(p5,h4)).
+fof(a110,axiom,~in(p4,h4)|~in(p6,h4)).
+fof(a111,axiom,~in(p5,h4)|~in(p6,h4)).
+fof(a112,axiom,~in(p0,h5)|~in(p1,h5)).
+fof(a113,axiom,~in(p0,h5)|~in(p2,h5)).
+fof(a114,axiom,~in(p0,h5)|~in(p3,h5)).
+fof(a115,axiom,~in(p0,h5)|~in(p4,h5)).
+fof(a116,axiom,~in(p0,h5)|~in(p5,h5)).
+fof(a117,axiom,~in(p0,h5)|~in(p6,h5)).
+fof(a118,axiom,~in(p1,h5)|~in(p2,h5)).
+fof(a119,axiom,~in(p1,h5)|~in(p3,h5)).
+fof(a120,axiom,~in(p1,h5)|~in(p4,h5)).
+fof(a121,axiom,~in(p1,h5)|~in(p5,h5)).
+fof(a122,axiom,~in(p1,h5)|~in(p6,h5)).
+fof(a123,axiom,~in(p2,h5)|~in(p3,h5)).
+fof(a124,axiom,~in(p2,h5)|~in(p4,h5)).
+fof(a125,axiom,~in(p2,h5)|~in(p5,h5)).
+fof(a126,axiom,~in(p2,h5)|~in(p6,h5)).
+fof(a127,axiom,~in(p3,h5)|~in(p4,h5)).
+fof(a128,axiom,~in(p3,h5)|~in(p5,h5)).
+fof(a129,axiom,~in(p3,h5)|~in(p6,h5)).
+fof(a130,axiom,~in(p4,h5)|~in(p5,h5)).
+fof(a131,axiom,~in(p4,h5)|~in(p6,h5)).
+fof(a132,axiom,~in(p5,h5)|~in(p6,h5)).
+fof(a133,axiom,! [X,Y] : (~in(X,Y) | occ(Y))).
+fof(a134,axiom,! [X,Y,Z] : (~r(X,Y) | ~r(Y,Z) | r(X,Z))).
+fof(a135,axiom,! [X] : (~occ(X) | r(X,f(X)))).
+fof(a136,axiom,! [X,Y] : (~r(X,Y) | ~r(Y,X) | in(g(X),Y) | occ(g(Y)))).
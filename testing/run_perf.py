@@ -0,0 +1,197 @@
+#! /usr/bin/python
+
+# Performance regression testing.
+#
+# Runs the problems in regressions/perf with the strategy pinned by their
+# "% params:" tag and compares the measurements against a stored baseline:
+#
+#   python testing/run_perf.py <vampire executable> [options]
+#
+#   --baseline FILE    baseline to compare with (testing/perf_baseline.json)
+#   --tolerance X      allowed relative deviation, overrides the baseline's
+#   --repeat N         run each problem N times and keep the fastest run
+#   --update           write the measurements as the new baseline
+#
+# Measured are the activations per second, the generated clauses, the
+# memory used and the time of each time counter unit (-tstat on).
+# Units taking less than the baseline's min_unit_time seconds are not
+# compared, as the timer resolution makes them noisy.
+#
+# The exit status is 1 if some measurement is worse than the baseline
+# by more than the tolerance, 2 if a run did not terminate as expected.
+
+from __future__ import print_function
+
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+
+PERF_DIR = "regressions/perf"
+DEFAULT_BASELINE = "testing/perf_baseline.json"
+DEFAULT_TOLERANCE = 0.1
+DEFAULT_MIN_UNIT_TIME = 0.05
+
+
+def read_params(path):
+    with open(path, "r") as f:
+        for line in f:
+            m = re.match(r"^% params: (.*)$", line)
+            if m:
+                return m.group(1).split()
+    return []
+
+
+def run_problem(vampire, path):
+    args = [vampire, "-p", "off", "-stat", "full", "-tstat", "on"] + read_params(path) + [path]
+    start = time.time()
+    p = subprocess.Popen(args, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    output = p.communicate()[0].decode("utf-8", "replace")
+    wall = time.time() - start
+
+    res = {"wall_time": wall, "time_units": {}, "activations": 0, "generated_clauses": 0, "memory_kb": 0}
+    in_units = False
+    for line in output.splitlines():
+        if line.startswith("% Time measurement results:"):
+            in_units = True
+            continue
+        m = re.match(r"^% (.+): ([0-9.]+) s", line)
+        if in_units and m:
+            res["time_units"][m.group(1)] = float(m.group(2))
+            continue
+        m = re.match(r"^% Termination reason: (.*)$", line)
+        if m:
+            res["termination"] = m.group(1)
+        m = re.match(r"^% Active clauses: ([0-9]+)$", line)
+        if m:
+            res["activations"] = int(m.group(1))
+        m = re.match(r"^% Generated clauses: ([0-9]+)$", line)
+        if m:
+            res["generated_clauses"] = int(m.group(1))
+        m = re.match(r"^% Memory used \[KB\]: ([0-9]+)$", line)
+        if m:
+            res["memory_kb"] = int(m.group(1))
+        m = re.match(r"^% Time elapsed: ([0-9.]+) s$", line)
+        if m:
+            res["time"] = float(m.group(1))
+
+    if "termination" not in res or "time" not in res:
+        print(output)
+        print("Vampire did not report its statistics on " + path)
+        return None
+    res["activations_per_second"] = res["activations"] / max(res["time"], 0.001)
+    return res
+
+
+def compare(name, base, cur, tolerance, min_unit_time):
+    """Return the list of regressions of cur with respect to base."""
+    problems = []
+
+    def worse(what, b, c, higher_is_better):
+        if higher_is_better:
+            bad = c < b * (1 - tolerance)
+        else:
+            bad = c > b * (1 + tolerance)
+        if bad:
+            problems.append("%s: %s %s -> %s" % (name, what, b, c))
+
+    if base.get("termination") != cur.get("termination"):
+        problems.append("%s: termination reason %s -> %s" %
+                        (name, base.get("termination"), cur.get("termination")))
+    worse("activations/s", base["activations_per_second"], cur["activations_per_second"], True)
+    worse("memory [KB]", base["memory_kb"], cur["memory_kb"], False)
+    # with a pinned strategy the search should not change at all,
+    # so a deviation either way is reported
+    if abs(cur["generated_clauses"] - base["generated_clauses"]) > tolerance * base["generated_clauses"]:
+        problems.append("%s: generated clauses %d -> %d" %
+                        (name, base["generated_clauses"], cur["generated_clauses"]))
+    for unit, t in sorted(base["time_units"].items()):
+        if t < min_unit_time:
+            continue
+        worse("time of '%s' [s]" % unit, t, cur["time_units"].get(unit, 0.0), False)
+    return problems
+
+
+def main(argv):
+    if len(argv) < 2:
+        print("Usage: run_perf.py <vampire executable> [--baseline FILE] [--tolerance X] [--repeat N] [--update]")
+        return 3
+    vampire = argv[1]
+    if os.sep not in vampire:
+        vampire = "./" + vampire
+    baseline_file = DEFAULT_BASELINE
+    tolerance = None
+    repeat = 1
+    update = False
+    i = 2
+    while i < len(argv):
+        if argv[i] == "--baseline":
+            baseline_file = argv[i + 1]
+            i += 1
+        elif argv[i] == "--tolerance":
+            tolerance = float(argv[i + 1])
+            i += 1
+        elif argv[i] == "--repeat":
+            repeat = int(argv[i + 1])
+            i += 1
+        elif argv[i] == "--update":
+            update = True
+        else:
+            print("Unknown argument: " + argv[i])
+            return 3
+        i += 1
+
+    baseline = {"tolerance": DEFAULT_TOLERANCE, "min_unit_time": DEFAULT_MIN_UNIT_TIME, "problems": {}}
+    if os.path.exists(baseline_file):
+        with open(baseline_file, "r") as f:
+            baseline = json.load(f)
+    if tolerance is None:
+        tolerance = baseline.get("tolerance", DEFAULT_TOLERANCE)
+    min_unit_time = baseline.get("min_unit_time", DEFAULT_MIN_UNIT_TIME)
+
+    print("Measuring " + vampire + "...")
+    results = {}
+    for path in sorted(glob.glob(os.path.join(PERF_DIR, "*.p"))):
+        name = os.path.basename(path)
+        best = None
+        for _ in range(repeat):
+            res = run_problem(vampire, path)
+            if res is None:
+                return 2
+            if best is None or res["time"] < best["time"]:
+                best = res
+        results[name] = best
+        print("%s: %s, %.3f s, %d activations (%.0f/s), %d generated, %d KB" %
+              (name, best["termination"], best["time"], best["activations"],
+               best["activations_per_second"], best["generated_clauses"], best["memory_kb"]))
+
+    if update:
+        baseline["problems"] = results
+        with open(baseline_file, "w") as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("Baseline written to " + baseline_file)
+        return 0
+
+    regressions = []
+    for name, cur in sorted(results.items()):
+        if name not in baseline["problems"]:
+            print(name + ": no baseline")
+            continue
+        regressions += compare(name, baseline["problems"][name], cur, tolerance, min_unit_time)
+
+    if regressions:
+        print("Performance regressions (tolerance %.0f%%):" % (tolerance * 100))
+        for r in regressions:
+            print("  " + r)
+        print("FAIL")
+        return 1
+    print("PASS")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -68,6 +68,7 @@
 #include "CASC/PortfolioMode.hpp"
 #include "CASC/CLTBMode.hpp"
 #include "CASC/CLTBModeLearning.hpp"
+#include "CASC/ServerMode.hpp"
 #include "Shell/CParser.hpp"
 #include "Shell/CommandLine.hpp"
 #include "Shell/EqualityProxy.hpp"
@@ -91,6 +92,7 @@
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
 #include "SAT/TWLSolver.hpp"
+#include "SAT/CDCLSolver.hpp"
 #include "SAT/Preprocess.hpp"
 
 #include "FMB/ModelCheck.hpp"
@@ -552,6 +554,9 @@ void satSolverMode()
     case Options::SatSolver::MINISAT:
       solver = new MinisatInterfacingNewSimp(*env.options);
       break;      
+    case Options::SatSolver::CDCL:
+      solver = new CDCLSolver(*env.options);
+      break;
     default:
       ASSERTION_VIOLATION(env.options->satSolver());
   }
@@ -964,6 +969,11 @@ int main(int argc, char* argv[])
       vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
       break;
     }
+    case Options::Mode::SERVER:
+      CASC::ServerMode::perform();
+      vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
+      break;
+
     case Options::Mode::MODEL_CHECK:
       modelCheckMode();
       break;
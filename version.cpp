@@ -0,0 +1,2 @@
+//Automatically generated file, see Makefile for details
+const char* VERSION_STRING = "Vampire 4.3.0 (commit 5c107e0 on 2026-10-18 22:49:56 +0000)";
@@ -45,6 +45,7 @@
 #include "VUtils/DPTester.hpp"
 #include "VUtils/EPRRestoringScanner.hpp"
 #include "VUtils/FOEquivalenceDiscovery.hpp"
+#include "VUtils/IndexReplayer.hpp"
 #include "VUtils/PreprocessingEvaluator.hpp"
 #include "VUtils/ProblemColoring.hpp"
 #include "VUtils/SATReplayer.hpp"
@@ -166,6 +167,9 @@ int main(int argc, char* argv [])
     else if(module=="sr") {
       resultValue=SATReplayer().perform(args.size(), args.begin());
     }
+    else if(module=="ir") {
+      resultValue=IndexReplayer().perform(args.size(), args.begin());
+    }
     else if(module=="vamp_casc") {
       Shell::CommandLine cl(args.size()-1, args.begin()+1);
       cl.interpret(*env.options);